@@ -0,0 +1,111 @@
+/**
+ * @file AllocationCheck.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Checks that moving actors through a Broadphase does not allocate once it has warmed up.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Usage: `allocation_check [actors]`, the seed is not used
+ *
+ * Replays a movement trace of the stress actors against every Broadphase,
+ * doing per actor what Tile::MapMovement does each frame: gathering obstacles
+ * into a scratch buffer and sweeping against them, updating the actor's hitbox,
+ * and querying for soft collisions. The trace is played forwards and backwards
+ * once to let every buffer grow, then again while global operator new counts
+ * heap allocations.
+ * Any allocation in the second pass fails the check.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "Check.hpp"
+#include "BenchMaps.hpp"
+#include "QuadTree.hpp"
+#include "SpatialGrid.hpp"
+#include "SweptAABB.hpp"
+
+namespace {
+	/**
+	 * @brief Number of heap allocations made since the program started.
+	 *
+	 */
+	std::size_t allocations = 0;
+
+	/**
+	 * @brief Scratch buffers, kept between frames like the ones of Tile::MapMovement.
+	 *
+	 */
+	struct Scratch {
+		std::vector<Hitbox> obstacles;
+		std::vector<ECS::handle> softCollisions;
+	};
+
+	/**
+	 * @brief Play the trace forwards and then backwards.
+	 *
+	 * @return Number of heap allocations made while playing it.
+	 */
+	std::size_t playTrace(Broadphase& broadphase, const Bench::MovementTrace& trace, Scratch& scratch) {
+		std::size_t before = allocations;
+		const std::vector<Hitbox>* previous = &trace.frames.front();
+		for (unsigned frame = 0; frame < 2 * Bench::TRACE_FRAMES; frame++) {
+			const auto& boxes = trace.frames[frame < Bench::TRACE_FRAMES ? frame : 2 * Bench::TRACE_FRAMES - 1 - frame];
+			for (std::size_t i = 0; i < boxes.size(); i++) {
+				ECS::entity e = trace.layer[i];
+				Velocity2 motion{ boxes[i].x - (*previous)[i].x, boxes[i].y - (*previous)[i].y };
+				scratch.obstacles.clear();
+				broadphase.query(sweptBounds((*previous)[i], motion), e, scratch.obstacles);
+				sweepAndSlide((*previous)[i], motion, scratch.obstacles);
+				broadphase.update(boxes[i], e);
+				scratch.softCollisions.clear();
+				broadphase.query(boxes[i], e, scratch.softCollisions);
+			}
+			if (!broadphase.isCompacted()) { broadphase.compact(); }
+			previous = &boxes;
+		}
+		return allocations - before;
+	}
+
+	bool check(const char* name, Broadphase& broadphase, const Bench::MovementTrace& trace) {
+		Scratch scratch;
+		for (std::size_t i = 0; i < trace.layer.size(); i++) {
+			broadphase.insert(trace.frames.front()[i], trace.ecs->getHandle(trace.layer[i]));
+		}
+		broadphase.compact();
+
+		std::size_t warmup = playTrace(broadphase, trace, scratch);
+		std::size_t steady = playTrace(broadphase, trace, scratch);
+		printf("%s: %zu allocations while warming up, %zu in %u steady frames\n",
+			name, warmup, steady, 2 * Bench::TRACE_FRAMES);
+		return steady == 0;
+	}
+}
+
+void* operator new(std::size_t size) {
+	allocations++;
+	if (void* p = std::malloc(size ? size : 1)) { return p; }
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+const char* const Check::NAME = "allocation_check";
+const std::size_t Check::DEFAULT_COUNT = 2000;
+
+bool Check::run(const Args& args) {
+	Bench::MovementTrace trace = Bench::makeMovementTrace(args.count);
+
+	QuadTree tree(Bench::STRESS_MAP_AREA);
+	SpatialGrid grid(Bench::STRESS_MAP_AREA, 2 * Bench::NORMAL_TILE_SIZE);
+	bool passed = check("QuadTree", tree, trace);
+	passed = check("SpatialGrid", grid, trace) && passed;
+
+	return passed || fail("the steady frames allocated");
+}
@@ -0,0 +1,38 @@
+/**
+ * @file BenchMain.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Runs the benchmarks and saves the results as JSON.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Usage: `bench [benchmark flags]`
+ *
+ * Unless `--benchmark_out` is given, the results are also written to
+ * `bench_results.json`, so that the runs of two versions can be compared
+ * with Google Benchmark's `tools/compare.py benchmarks old.json new.json`.
+ */
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+int main(int argc, char** argv) {
+	std::vector<char*> args(argv, argv + argc);
+	bool hasOut = false;
+	for (int i = 1; i < argc; i++) {
+		if (strncmp(argv[i], "--benchmark_out=", strlen("--benchmark_out=")) == 0) { hasOut = true; }
+	}
+
+	char outFlag[] = "--benchmark_out=bench_results.json";
+	char formatFlag[] = "--benchmark_out_format=json";
+	if (!hasOut) {
+		args.push_back(outFlag);
+		args.push_back(formatFlag);
+	}
+
+	int count = (int)args.size();
+	benchmark::Initialize(&count, args.data());
+	if (benchmark::ReportUnrecognizedArguments(count, args.data())) { return 1; }
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
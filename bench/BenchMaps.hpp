@@ -0,0 +1,148 @@
+/**
+ * @file BenchMaps.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Builds stressMapEntity.json style entity maps for the benchmarks.
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include "tile/TileMapECS.hpp"
+#include <memory>
+#include <random>
+
+namespace Bench {
+	/**
+	 * @brief Width and height of `stressMap.json`, in tiles.
+	 *
+	 */
+	static const unsigned STRESS_MAP_TILES = 256;
+
+	/**
+	 * @brief Normal tile size of `stressMap.json`, in pixels.
+	 *
+	 */
+	static const float NORMAL_TILE_SIZE = 16.f;
+
+	/**
+	 * @brief Number of frames in each walk or sprint animation of the stress actors.
+	 *
+	 */
+	static const unsigned ANIMATION_FRAMES = 6;
+
+	/**
+	 * @brief Add `count` actors like the one in `stressMapEntity.json` to `ecs`.
+	 *
+	 * @details
+	 * The actors are spread randomly over the stress map, and every one
+	 * of them is moving in a random direction, so the systems have to do
+	 * their full amount of work for each of them.
+	 *
+	 * @tparam ECSType A Tile::BasicMapECS.
+	 * @param ecs ECS to add the actors to.
+	 * @param count Number of actors to add.
+	 * @param layer Entity layer that the actors will be appended to.
+	 * @param seed Seed for the random positions and directions.
+	 */
+	template<class ECSType>
+	void addStressActors(ECSType& ecs, std::size_t count, std::vector<typename ECSType::entity>& layer, unsigned seed = 1) {
+		using namespace Tile;
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> coord(0.f, (STRESS_MAP_TILES - 1) * NORMAL_TILE_SIZE);
+		std::uniform_int_distribution<int> direction(Direction::Down, Direction::RightUp);
+
+		ActorSpriteAnims anims;
+		anims.duration = 0.117;
+		for (int i = 1; i < Direction::DirectionSize; i++) {
+			for (unsigned j = 0; j < ANIMATION_FRAMES; j++) {
+				anims.walk[i].push_back((TileId)(32 + j));
+				anims.sprint[i].push_back((TileId)(38 + j));
+			}
+		}
+
+		ecs.setCapacity(ecs.getCapacity() < count ? count : ecs.getCapacity());
+		for (std::size_t i = 0; i < count; i++) {
+			typename ECSType::entity e = ecs.createEntity();
+			Position2 pos{ coord(rng), coord(rng) };
+			Direction dir = static_cast<Direction>(direction(rng));
+
+			ecs.template getComponent<Position2>().add(e, pos);
+			ecs.template getComponent<Velocity2>().add(e, Velocity2{ 0, 0 });
+			ecs.template getComponent<Hitbox>().add(e, Hitbox{ pos.x, pos.y, 16.f, 16.f });
+			ecs.template getComponent<Actor>().add(e, Actor{ 60.f, dir, dir, false });
+			ecs.template getComponent<ActorSprite>().add(e, ActorSprite{ -23.f, -28.f, 1, 0 });
+			ecs.template getComponent<ActorSpriteAnims>().add(e, anims);
+			ecs.template getComponent<MapCommand>().add(e, MapCommand{ .data { MAP_CMD_NONE, ECS::NONE_HANDLE } });
+			ecs.template getComponent<MapEntity>().add(e, MapEntity{ 0, 1 });
+			layer.push_back(e);
+		}
+	}
+
+	/**
+	 * @brief Area of `stressMap.json`, in pixels.
+	 *
+	 */
+	static const Hitbox STRESS_MAP_AREA{ 0, 0, STRESS_MAP_TILES * NORMAL_TILE_SIZE, STRESS_MAP_TILES * NORMAL_TILE_SIZE };
+
+	/**
+	 * @brief Number of frames in a movement trace.
+	 *
+	 */
+	static const unsigned TRACE_FRAMES = 120;
+
+	/**
+	 * @brief The hitboxes of the stress actors over a number of frames.
+	 *
+	 */
+	struct MovementTrace {
+		using TraceECS = Tile::BasicMapECS<uint16_t, UINT16_MAX>;
+
+		std::unique_ptr<TraceECS> ecs = std::make_unique<TraceECS>();
+		std::vector<uint16_t> layer;
+		std::vector<std::vector<Hitbox>> frames;
+	};
+
+	/**
+	 * @brief Walk `count` stress actors around the map for TRACE_FRAMES frames at 60 FPS.
+	 *
+	 * @details
+	 * Each actor keeps walking in its direction, turning now and then,
+	 * and turning around at the edges of the map.
+	 *
+	 * @param count Number of actors to walk.
+	 * @return The trace.
+	 */
+	inline MovementTrace makeMovementTrace(std::size_t count) {
+		using namespace Tile;
+		MovementTrace trace;
+		addStressActors(*trace.ecs, count, trace.layer);
+		auto& hitboxes = trace.ecs->getComponent<Hitbox>();
+		auto& actors = trace.ecs->getComponent<Actor>();
+
+		std::mt19937 rng(7);
+		std::uniform_int_distribution<int> turn(0, 99);
+		std::uniform_int_distribution<int> direction(Direction::Down, Direction::RightUp);
+		const Velocity2 dirVecs[Direction::DirectionSize] = {
+			{ 0, 0 }, { 0, 1 }, { 0, -1 }, { -1, 0 }, { -0.7071f, 0.7071f },
+			{ -0.7071f, -0.7071f }, { 1, 0 }, { 0.7071f, 0.7071f }, { 0.7071f, -0.7071f }
+		};
+
+		std::vector<Hitbox> boxes;
+		for (auto e : trace.layer) { boxes.push_back(hitboxes.get(e)); }
+		for (unsigned frame = 0; frame < TRACE_FRAMES; frame++) {
+			for (std::size_t i = 0; i < boxes.size(); i++) {
+				Actor& actor = actors.get(trace.layer[i]);
+				if (!turn(rng)) { actor.direction = static_cast<Direction>(direction(rng)); }
+				Velocity2 velocity = dirVecs[actor.direction] * actor.speed * (1.0 / 60.0);
+				Hitbox& box = boxes[i];
+				box.x += velocity.x;
+				box.y += velocity.y;
+				if (box.x < 0 || box.x + box.w > STRESS_MAP_AREA.w || box.y < 0 || box.y + box.h > STRESS_MAP_AREA.h) {
+					box.x -= 2 * velocity.x;
+					box.y -= 2 * velocity.y;
+					actor.direction = static_cast<Direction>(direction(rng));
+				}
+			}
+			trace.frames.push_back(boxes);
+		}
+		return trace;
+	}
+};
@@ -0,0 +1,107 @@
+/**
+ * @file BroadphaseBench.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Rebuild, and movement trace replay, of QuadTree against SpatialGrid.
+ * @copyright Copyright (c) 2025
+ */
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "BenchMaps.hpp"
+#include "QuadTree.hpp"
+#include "SpatialGrid.hpp"
+
+using namespace Tile;
+using namespace Bench;
+
+/**
+ * @brief Cell size that Tile::MapQuadTrees gives a SpatialGrid on a map with 16 pixel tiles.
+ *
+ */
+static const float TRACE_CELL_SIZE = 2 * NORMAL_TILE_SIZE;
+
+/**
+ * @brief Get the movement trace of `count` actors, making it the first time.
+ *
+ */
+static const MovementTrace& getTrace(std::size_t count) {
+	static std::vector<std::pair<std::size_t, std::unique_ptr<MovementTrace>>> traces;
+	for (auto& [traceCount, trace] : traces) {
+		if (traceCount == count) { return *trace; }
+	}
+	traces.emplace_back(count, std::make_unique<MovementTrace>(makeMovementTrace(count)));
+	return *traces.back().second;
+}
+
+template<class Structure>
+static std::unique_ptr<Structure> makeStructure() {
+	if constexpr (std::is_same_v<Structure, SpatialGrid>) { return std::make_unique<SpatialGrid>(STRESS_MAP_AREA, TRACE_CELL_SIZE); }
+	else { return std::make_unique<Structure>(STRESS_MAP_AREA); }
+}
+
+/**
+ * @brief Clear the structure and insert every stress actor's hitbox.
+ *
+ */
+template<class Structure>
+static void BM_BroadphaseRebuild(benchmark::State& state) {
+	const MovementTrace& trace = getTrace(state.range(0));
+	const std::vector<Hitbox>& boxes = trace.frames.front();
+	auto structure = makeStructure<Structure>();
+
+	for (auto _ : state) {
+		structure->reset();
+		for (std::size_t i = 0; i < boxes.size(); i++) {
+			structure->insert(boxes[i], trace.ecs->getHandle(trace.layer[i]));
+		}
+		structure->compact();
+		benchmark::ClobberMemory();
+	}
+	state.counters["actors"] = (double)boxes.size();
+}
+BENCHMARK_TEMPLATE(BM_BroadphaseRebuild, QuadTree)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BroadphaseRebuild, SpatialGrid)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Replay the movement trace, updating and querying every actor each frame like Tile::MapMovement.
+ *
+ * @details
+ * The trace is played forwards and then backwards, so the structure
+ * never sees a jump from the last frame to the first.
+ * The `frame` counter is the time per frame of the trace.
+ */
+template<class Structure>
+static void BM_BroadphaseTrace(benchmark::State& state) {
+	const MovementTrace& trace = getTrace(state.range(0));
+	auto structure = makeStructure<Structure>();
+	for (std::size_t i = 0; i < trace.layer.size(); i++) {
+		structure->insert(trace.frames.front()[i], trace.ecs->getHandle(trace.layer[i]));
+	}
+	structure->compact();
+
+	std::vector<Hitbox> out;
+	std::size_t hits = 0;
+	std::size_t relocated = 0;
+	bool backwards = false;
+	for (auto _ : state) {
+		hits = 0;
+		relocated = 0;
+		for (unsigned frame = 0; frame < TRACE_FRAMES; frame++) {
+			const auto& boxes = trace.frames[backwards ? TRACE_FRAMES - 1 - frame : frame];
+			for (std::size_t i = 0; i < boxes.size(); i++) {
+				relocated += structure->update(boxes[i], trace.layer[i]);
+				out.clear();
+				structure->query(boxes[i], trace.layer[i], out);
+				hits += out.size();
+			}
+			if (!structure->isCompacted()) { structure->compact(); }
+		}
+		backwards = !backwards;
+		benchmark::DoNotOptimize(hits);
+	}
+	state.counters["actors"] = (double)trace.layer.size();
+	state.counters["hits/frame"] = (double)hits / TRACE_FRAMES;
+	state.counters["relocated/frame"] = (double)relocated / TRACE_FRAMES;
+	state.counters["frame"] = benchmark::Counter((double)TRACE_FRAMES, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+BENCHMARK_TEMPLATE(BM_BroadphaseTrace, QuadTree)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BroadphaseTrace, SpatialGrid)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
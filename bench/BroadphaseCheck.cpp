@@ -0,0 +1,335 @@
+/**
+ * @file BroadphaseCheck.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Checks QuadTree and SpatialGrid queries against brute-force scans of random hitbox sets.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Usage: `broadphase_check [rounds] [seed]`
+ *
+ * Each round builds every Broadphase from a random set of hitboxes,
+ * checks the links of every QuadTree node, and compares the results of
+ * random queries with a scan over all the hitboxes. Then it moves some
+ * of the hitboxes with Broadphase::update, and checks them again.
+ * The first mismatch is printed along with the round's seed, so it can
+ * be replayed with `broadphase_check 1 <seed>`.
+ * Build, query, and update times are printed at the end.
+ *
+ * Building with `-DBROADPHASE_CHECK_LIBFUZZER -fsanitize=fuzzer` makes this
+ * a libFuzzer target instead, that reads the hitboxes from the fuzzer's input.
+ * libFuzzer brings its own `main`, so that build leaves out CheckMain.cpp.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "Check.hpp"
+#include "QuadTree.hpp"
+#include "SpatialGrid.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	const Hitbox AREA{ 0, 0, 4096, 4096 };
+
+	const float GRID_CELL_SIZE = 32.f;
+
+	/**
+	 * @brief Totals over all rounds, for the timing output.
+	 *
+	 */
+	struct Totals {
+		std::size_t rounds = 0;
+		std::size_t boxes = 0;
+		std::size_t queries = 0;
+		std::size_t hits = 0;
+		std::size_t updates = 0;
+		Clock::duration build{};
+		Clock::duration query{};
+		Clock::duration update{};
+	};
+
+	bool collides(const Hitbox& box, const Hitbox& other) {
+		return
+			box.x + box.w > other.x &&
+			box.x < other.x + other.w &&
+			box.y + box.h > other.y &&
+			box.y < other.y + other.h;
+	}
+
+	bool isWithin(const Hitbox& outerBox, const Hitbox& innerBox) {
+		return
+			innerBox.x >= outerBox.x &&
+			innerBox.y >= outerBox.y &&
+			innerBox.x + innerBox.w <= outerBox.x + outerBox.w &&
+			innerBox.y + innerBox.h <= outerBox.y + outerBox.h;
+	}
+
+	/**
+	 * @brief Check the links of every node reachable from the root.
+	 *
+	 * @details
+	 * Every node must be reached exactly once, the child counts and last
+	 * children must match the sibling lists, and every node below the root
+	 * must lie within the branch that holds it, and point back to it.
+	 *
+	 * @return Number of leaves, or -1 if the tree is malformed.
+	 */
+	long checkLinks(const QuadTree& tree) {
+		std::vector<char> seen(tree.nodeCount(), 0);
+		std::vector<uint32_t> stack{ QuadTree::ROOT };
+		seen[QuadTree::ROOT] = 1;
+		long leaves = 0;
+		while (!stack.empty()) {
+			uint32_t index = stack.back();
+			stack.pop_back();
+			const QuadNode& node = tree.getNode(index);
+			uint32_t count = 0;
+			uint32_t last = QuadNode::NONE;
+			for (uint32_t i = node.firstChild; i != QuadNode::NONE; i = tree.getNode(i).nextSibling) {
+				if (i >= tree.nodeCount() || seen[i]) {
+					printf("node %u: child %u is out of range or reached twice\n", index, i);
+					return -1;
+				}
+				seen[i] = 1;
+				const QuadNode& child = tree.getNode(i);
+				if (index != QuadTree::ROOT && !isWithin(node.area, child.area)) {
+					printf("node %u: child %u lies outside of it\n", index, i);
+					return -1;
+				}
+				if (child.parent != index) {
+					printf("node %u: child %u has the parent %u\n", index, i, child.parent);
+					return -1;
+				}
+				if (child.type == QuadNode::Branch) { stack.push_back(i); }
+				else { leaves++; }
+				last = i;
+				count++;
+			}
+			if (count != node.childCount || last != node.lastChild) {
+				printf("node %u: child count %u or last child %u do not match its %u children\n",
+					index, node.childCount, node.lastChild, count);
+				return -1;
+			}
+		}
+		return leaves;
+	}
+
+	/**
+	 * @brief Check the structure and the results of `queries` against `boxes`.
+	 *
+	 * @details
+	 * Entity `i` has the hitbox `boxes[i]`. Each query is made on behalf
+	 * of entity `i % boxes.size()`, so that its own hitbox is skipped.
+	 *
+	 * @return `true` if every check passed, `false` otherwise.
+	 */
+	bool checkStructure(const Broadphase& structure, const std::vector<Hitbox>& boxes, const std::vector<Hitbox>& queries, Totals& totals) {
+		Clock::time_point start;
+		if (const QuadTree* tree = dynamic_cast<const QuadTree*>(&structure)) {
+			long leaves = checkLinks(*tree);
+			if (leaves < 0) { return false; }
+			if ((std::size_t)leaves != boxes.size()) {
+				printf("tree holds %ld leaves for %zu boxes\n", leaves, boxes.size());
+				return false;
+			}
+		}
+		for (std::size_t i = 0; i < boxes.size(); i++) {
+			if (!structure.contains((ECS::entity)i)) {
+				printf("entity %zu is missing\n", i);
+				return false;
+			}
+		}
+
+		std::vector<ECS::handle> out;
+		std::vector<ECS::entity> found;
+		std::vector<ECS::entity> expected;
+		for (std::size_t q = 0; q < queries.size(); q++) {
+			ECS::entity self = boxes.empty() ? ECS::NONE : (ECS::entity)(q % boxes.size());
+
+			out.clear();
+			start = Clock::now();
+			structure.query(queries[q], self, out);
+			totals.query += Clock::now() - start;
+
+			found.clear();
+			for (ECS::handle h : out) { found.push_back(h.index); }
+			expected.clear();
+			for (std::size_t i = 0; i < boxes.size(); i++) {
+				if (i != self && collides(queries[q], boxes[i])) { expected.push_back((ECS::entity)i); }
+			}
+			std::sort(found.begin(), found.end());
+			std::sort(expected.begin(), expected.end());
+			if (found != expected) {
+				printf("query {%g, %g, %g, %g} for entity %u found %zu hitboxes, expected %zu\n",
+					queries[q].x, queries[q].y, queries[q].w, queries[q].h, self, found.size(), expected.size());
+				return false;
+			}
+			totals.hits += found.size();
+		}
+		totals.queries += queries.size();
+		return true;
+	}
+
+	/**
+	 * @brief Build a structure from `boxes` and check it, then move some of the boxes and check it again.
+	 *
+	 * @details
+	 * Most moves are small, like walking, but some jump across the area,
+	 * like a teleport, so that hitboxes have to be relocated.
+	 *
+	 * @return `true` if every check passed, `false` otherwise.
+	 */
+	bool checkRound(Broadphase& structure, std::vector<Hitbox> boxes, const std::vector<Hitbox>& queries, bool compact, std::mt19937 rng, Totals& totals) {
+		Clock::time_point start = Clock::now();
+		structure.reset();
+		for (std::size_t i = 0; i < boxes.size(); i++) {
+			structure.insert(boxes[i], ECS::handle((ECS::entity)i));
+		}
+		if (compact) { structure.compact(); }
+		totals.build += Clock::now() - start;
+		if (!checkStructure(structure, boxes, queries, totals)) { return false; }
+
+		std::uniform_int_distribution<int> moveDist(0, 9);
+		std::uniform_real_distribution<float> step(-3.f, 3.f);
+		std::uniform_real_distribution<float> coord(-64.f, AREA.w + 64.f);
+		for (int pass = 0; pass < 3; pass++) {
+			start = Clock::now();
+			for (std::size_t i = 0; i < boxes.size(); i++) {
+				int move = moveDist(rng);
+				if (move < 4) { continue; }
+				else if (move < 9) { boxes[i].x += step(rng); boxes[i].y += step(rng); }
+				else { boxes[i].x = coord(rng); boxes[i].y = coord(rng); }
+				structure.update(boxes[i], (ECS::entity)i);
+				totals.updates++;
+			}
+			totals.update += Clock::now() - start;
+			if (pass == 1) { structure.compact(); }
+			if (!checkStructure(structure, boxes, queries, totals)) { return false; }
+		}
+
+		totals.rounds++;
+		totals.boxes += boxes.size();
+		return true;
+	}
+
+	/**
+	 * @brief Make a random set of hitboxes.
+	 *
+	 * @details
+	 * Mixes evenly spread boxes with clusters, boxes stacked on the same
+	 * spot, boxes on quadrant boundaries, and boxes that leave the area,
+	 * since those are the cases that stress the subdivision.
+	 */
+	std::vector<Hitbox> randomBoxes(std::mt19937& rng) {
+		std::uniform_int_distribution<int> countDist(0, 3000);
+		std::uniform_int_distribution<int> kindDist(0, 9);
+		std::uniform_real_distribution<float> coord(-64.f, AREA.w + 64.f);
+		std::uniform_real_distribution<float> size(0.f, 48.f);
+		std::uniform_real_distribution<float> jitter(-24.f, 24.f);
+		std::uniform_int_distribution<int> boundary(1, 15);
+
+		std::vector<Hitbox> boxes(countDist(rng));
+		Hitbox cluster{ coord(rng), coord(rng), 16, 16 };
+		for (auto& box : boxes) {
+			int kind = kindDist(rng);
+			if (kind < 5) { box = Hitbox{ coord(rng), coord(rng), size(rng), size(rng) }; }
+			else if (kind < 7) { box = Hitbox{ cluster.x + jitter(rng), cluster.y + jitter(rng), size(rng), size(rng) }; }
+			else if (kind < 8) { box = cluster; }
+			else if (kind < 9) {
+				float line = AREA.w * boundary(rng) / 16.f;
+				box = Hitbox{ line - 8.f, coord(rng), 16, 16 };
+			}
+			else { box = Hitbox{ floorf(coord(rng)), floorf(coord(rng)), 16, 16 }; }
+		}
+		return boxes;
+	}
+
+	std::vector<Hitbox> randomQueries(std::mt19937& rng, const std::vector<Hitbox>& boxes) {
+		std::uniform_real_distribution<float> coord(-64.f, AREA.w + 64.f);
+		std::uniform_real_distribution<float> size(0.f, 256.f);
+		std::vector<Hitbox> queries;
+		for (const auto& box : boxes) {
+			if (queries.size() >= 500) { break; }
+			queries.push_back(box);
+		}
+		for (int i = 0; i < 100; i++) {
+			queries.push_back(Hitbox{ coord(rng), coord(rng), size(rng), size(rng) });
+		}
+		queries.push_back(AREA);
+		return queries;
+	}
+
+	double milliseconds(Clock::duration d) {
+		return std::chrono::duration<double, std::milli>(d).count();
+	}
+
+	void printTotals(const char* name, const Totals& totals) {
+		printf("%s: %zu rounds, %zu hitboxes, %zu queries, %zu hits\n", name, totals.rounds, totals.boxes, totals.queries, totals.hits);
+		printf("  build: %.3f ms total, %.1f ns per hitbox\n",
+			milliseconds(totals.build), totals.boxes ? milliseconds(totals.build) * 1e6 / totals.boxes : 0.0);
+		printf("  query: %.3f ms total, %.1f ns per query\n",
+			milliseconds(totals.query), totals.queries ? milliseconds(totals.query) * 1e6 / totals.queries : 0.0);
+		printf("  update: %.3f ms total, %.1f ns per update\n",
+			milliseconds(totals.update), totals.updates ? milliseconds(totals.update) * 1e6 / totals.updates : 0.0);
+	}
+}
+
+#ifdef BROADPHASE_CHECK_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size) {
+	static QuadTree tree(AREA);
+	static SpatialGrid grid(AREA, GRID_CELL_SIZE);
+	Totals totals;
+	std::vector<Hitbox> boxes(size / sizeof(Hitbox));
+	std::memcpy(boxes.data(), data, boxes.size() * sizeof(Hitbox));
+	/* Keep the boxes finite and the tree shallow enough to scan */
+	for (auto& box : boxes) {
+		float* values = reinterpret_cast<float*>(&box);
+		for (int i = 0; i < 4; i++) {
+			if (!std::isfinite(values[i])) { values[i] = 0; }
+			values[i] = std::clamp(values[i], -AREA.w, 2 * AREA.w);
+		}
+		box.w = fabsf(box.w);
+		box.h = fabsf(box.h);
+	}
+	std::vector<Hitbox> queries(boxes);
+	queries.push_back(AREA);
+	std::mt19937 rng((unsigned)size);
+	if (!checkRound(tree, boxes, queries, size % 2, rng, totals)) { abort(); }
+	if (!checkRound(grid, boxes, queries, size % 2, rng, totals)) { abort(); }
+	return 0;
+}
+
+#else
+
+const char* const Check::NAME = "broadphase_check";
+const std::size_t Check::DEFAULT_COUNT = 200;
+
+bool Check::run(const Args& args) {
+	QuadTree tree(AREA);
+	SpatialGrid grid(AREA, GRID_CELL_SIZE);
+	Totals treeTotals;
+	Totals gridTotals;
+	for (unsigned i = 0; i < args.count; i++) {
+		std::mt19937 rng(args.seed + i);
+		std::vector<Hitbox> boxes = randomBoxes(rng);
+		std::vector<Hitbox> queries = randomQueries(rng, boxes);
+		if (!checkRound(tree, boxes, queries, i % 2, rng, treeTotals)) {
+			return fail("QuadTree in round %u (seed %u)", i, args.seed + i);
+		}
+		if (!checkRound(grid, boxes, queries, i % 2, rng, gridTotals)) {
+			return fail("SpatialGrid in round %u (seed %u)", i, args.seed + i);
+		}
+	}
+
+	printTotals("QuadTree", treeTotals);
+	printTotals("SpatialGrid", gridTotals);
+	return true;
+}
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file Check.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief What each standalone check defines for CheckMain.cpp.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Every check is run as `<check> [count] [seed]`. CheckMain.cpp parses the
+ * arguments, calls Check::run, and turns its result into the exit code, so
+ * a check only defines what it does with them.
+ */
+#pragma once
+#include <cstddef>
+
+namespace Check {
+	/**
+	 * @brief Arguments of a check.
+	 *
+	 */
+	struct Args {
+		/**
+		 * @brief How much to check: rounds, frames or actors, depending on the check.
+		 *
+		 */
+		std::size_t count;
+
+		/**
+		 * @brief Seed of the first round. Round `i` uses `seed + i`, so a failing round can be run alone.
+		 *
+		 */
+		unsigned seed;
+	};
+
+	/**
+	 * @brief Name of the check, printed with its result. Defined by each check.
+	 *
+	 */
+	extern const char* const NAME;
+
+	/**
+	 * @brief `count` used when none is given. Defined by each check.
+	 *
+	 */
+	extern const std::size_t DEFAULT_COUNT;
+
+	/**
+	 * @brief Run the check. Defined by each check.
+	 *
+	 * @param args Parsed arguments.
+	 * @return `true` if every check passed, `false` otherwise.
+	 */
+	bool run(const Args& args);
+
+	/**
+	 * @brief Print `FAILED` and a printf style description of what failed.
+	 *
+	 * @return `false`, so a check can `return Check::fail(...)`.
+	 */
+	bool fail(const char* format, ...);
+}
@@ -0,0 +1,36 @@
+/**
+ * @file CheckMain.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Runs one standalone check, see Check.hpp.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Usage: `<check> [count] [seed]`
+ *
+ * Exits with `EXIT_FAILURE` if the check failed, so ctest reports it.
+ */
+#include "Check.hpp"
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+bool Check::fail(const char* format, ...) {
+	printf("FAILED ");
+	va_list args;
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+	printf("\n");
+	return false;
+}
+
+int main(int argc, char** argv) {
+	Check::Args args{
+		argc > 1 ? (std::size_t)strtoul(argv[1], nullptr, 10) : Check::DEFAULT_COUNT,
+		argc > 2 ? (unsigned)strtoul(argv[2], nullptr, 10) : 1u
+	};
+
+	bool passed = Check::run(args);
+	printf("%s %s (count %zu, seed %u)\n", Check::NAME, passed ? "passed" : "FAILED", args.count, args.seed);
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file CommandBufferCheck.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Checks that ECSCommandBuffer applies recorded changes the way it documents.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Usage: `command_buffer_check [rounds] [seed]`
+ *
+ * First checks each rule on its own: a free recorded while iterating waits
+ * for applyCommands, repeated frees of a handle free it once, changes to
+ * freed handles are skipped, and additions apply before removals, which
+ * apply before frees. Then each round records random additions, removals
+ * and frees, some on stale handles whose entity was freed and reused, and
+ * compares the result with a simple model of those rules.
+ */
+#include <cstdio>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+#include "Check.hpp"
+#include "GRY_ECS.hpp"
+
+namespace {
+	struct A { int value; };
+	struct B { int value; };
+
+	using TestECS = GRY_ECS<uint16_t, 1024, A, B>;
+	using Handle = TestECS::Handle;
+
+	const std::size_t ENTITIES = 64;
+
+	bool checkDeferredFree() {
+		TestECS ecs;
+		std::vector<Handle> handles;
+		for (int i = 0; i < 8; i++) {
+			uint16_t e = ecs.createEntity();
+			ecs.getComponent<A>().add(e, A{ i });
+			handles.push_back(ecs.getHandle(e));
+		}
+
+		std::size_t visited = 0;
+		for (uint16_t e : ecs.getComponent<A>()) {
+			ecs.getCommands().free(ecs.getHandle(e));
+			if (!ecs.isAlive(ecs.getHandle(e)) || ecs.getComponent<A>().size() != handles.size()) {
+				return Check::fail("a free recorded while iterating changed the ECS before applyCommands");
+			}
+			visited++;
+		}
+		if (visited != handles.size()) { return Check::fail("iterated %zu of %zu entities while recording frees", visited, handles.size()); }
+
+		std::size_t freed = ecs.applyCommands();
+		if (freed != handles.size() || ecs.getComponent<A>().size() != 0) {
+			return Check::fail("applyCommands freed %zu entities and left %zu components, expected %zu and 0",
+				freed, ecs.getComponent<A>().size(), handles.size()
+			);
+		}
+		for (Handle h : handles) {
+			if (ecs.isAlive(h)) { return Check::fail("entity %u is still alive after its free was applied", (unsigned)h.index); }
+		}
+		return true;
+	}
+
+	bool checkDuplicateFrees() {
+		TestECS ecs;
+		ecs.setCapacity(2);
+		Handle h = ecs.getHandle(ecs.createEntity());
+		ecs.createEntity();
+		for (int i = 0; i < 3; i++) { ecs.getCommands().free(h); }
+		if (ecs.applyCommands() != 1) { return Check::fail("three frees of one handle did not free exactly one entity"); }
+
+		/* A doubly freed entity would be given out twice */
+		if (ecs.createEntity() != h.index || ecs.createEntity() != TestECS::NONE) {
+			return Check::fail("a handle freed three times was put back more than once");
+		}
+		return true;
+	}
+
+	bool checkStaleHandles() {
+		TestECS ecs;
+		ecs.setCapacity(1);
+		uint16_t e = ecs.createEntity();
+		Handle stale = ecs.getHandle(e);
+		ecs.freeEntity(e);
+		uint16_t reused = ecs.createEntity();
+		if (reused != e) { return Check::fail("the freed entity was not reused"); }
+		ecs.getComponent<B>().add(reused, B{ 1 });
+
+		ecs.getCommands().add(stale, A{ 2 });
+		ecs.getCommands().remove<B>(stale);
+		ecs.getCommands().free(stale);
+		if (ecs.applyCommands() != 0) { return Check::fail("a free of a stale handle freed an entity"); }
+		if (ecs.getComponent<A>().contains(reused) || !ecs.getComponent<B>().contains(reused) || !ecs.isAlive(ecs.getHandle(reused))) {
+			return Check::fail("changes recorded on a stale handle were applied to the entity that reused it");
+		}
+		return true;
+	}
+
+	bool checkOrder() {
+		TestECS ecs;
+		Handle h = ecs.getHandle(ecs.createEntity());
+		ecs.getComponent<B>().add(h.index, B{ 1 });
+
+		/* Recorded in the opposite order to how they apply */
+		ecs.getCommands().remove<A>(h);
+		ecs.getCommands().add(h, A{ 1 });
+		ecs.applyCommands();
+		if (ecs.getComponent<A>().contains(h.index)) { return Check::fail("a removal applied before an addition recorded after it"); }
+
+		ecs.getCommands().free(h);
+		ecs.getCommands().remove<B>(h);
+		ecs.getCommands().add(h, A{ 2 });
+		if (ecs.applyCommands() != 1) { return Check::fail("a free recorded before an addition and a removal was not applied"); }
+		if (ecs.getComponent<A>().size() || ecs.getComponent<B>().size() || ecs.isAlive(h)) {
+			return Check::fail("an entity given, stripped and freed in one apply kept components or stayed alive");
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Record random changes on live and stale handles, and compare the result with a model of the rules.
+	 *
+	 */
+	bool checkRandom(std::mt19937& rng) {
+		TestECS ecs;
+		ecs.setCapacity(ENTITIES);
+		std::vector<Handle> handles;
+		for (std::size_t i = 0; i < ENTITIES; i++) { handles.push_back(ecs.getHandle(ecs.createEntity())); }
+
+		std::uniform_int_distribution<int> op(0, 4);
+		std::uniform_int_distribution<int> value(0, 1000);
+		for (int step = 0; step < 20; step++) {
+			/* Free and reuse some entities right away, so some recorded handles go stale */
+			for (int i = 0; i < 4; i++) {
+				Handle h = handles[rng() % handles.size()];
+				if (!ecs.isAlive(h)) { continue; }
+				ecs.freeEntity(h.index);
+				handles.push_back(ecs.getHandle(ecs.createEntity()));
+			}
+
+			std::map<uint16_t, int> a, b;
+			for (uint16_t e : ecs.getComponent<A>()) { a[e] = ecs.getComponent<A>().get(e).value; }
+			for (uint16_t e : ecs.getComponent<B>()) { b[e] = ecs.getComponent<B>().get(e).value; }
+			std::vector<std::pair<Handle, int>> addA, addB;
+			std::vector<Handle> removeA, removeB;
+			std::set<uint16_t> freed;
+			for (int i = 0; i < 32; i++) {
+				Handle h = handles[rng() % handles.size()];
+				int v = value(rng);
+				switch (op(rng)) {
+					case 0: ecs.getCommands().add(h, A{ v }); addA.push_back({ h, v }); break;
+					case 1: ecs.getCommands().add(h, B{ v }); addB.push_back({ h, v }); break;
+					case 2: ecs.getCommands().remove<A>(h); removeA.push_back(h); break;
+					case 3: ecs.getCommands().remove<B>(h); removeB.push_back(h); break;
+					default: ecs.getCommands().free(h); if (ecs.isAlive(h)) { freed.insert(h.index); } break;
+				}
+			}
+
+			/* The model: additions in order, then removals, then frees, skipping stale handles */
+			for (auto& [h, v] : addA) { if (ecs.isAlive(h)) { a[h.index] = v; } }
+			for (auto& [h, v] : addB) { if (ecs.isAlive(h)) { b[h.index] = v; } }
+			for (Handle h : removeA) { if (ecs.isAlive(h)) { a.erase(h.index); } }
+			for (Handle h : removeB) { if (ecs.isAlive(h)) { b.erase(h.index); } }
+			for (uint16_t e : freed) { a.erase(e); b.erase(e); }
+			std::vector<bool> aliveBefore;
+			for (Handle h : handles) { aliveBefore.push_back(ecs.isAlive(h)); }
+
+			std::size_t count = ecs.applyCommands();
+			if (count != freed.size()) { return Check::fail("applyCommands freed %zu entities instead of %zu", count, freed.size()); }
+			if (ecs.getComponent<A>().size() != a.size() || ecs.getComponent<B>().size() != b.size()) {
+				return Check::fail("ended with %zu A and %zu B components instead of %zu and %zu",
+					ecs.getComponent<A>().size(), ecs.getComponent<B>().size(), a.size(), b.size()
+				);
+			}
+			for (auto& [e, v] : a) {
+				if (!ecs.getComponent<A>().contains(e) || ecs.getComponent<A>().get(e).value != v) { return Check::fail("entity %u has the wrong A", (unsigned)e); }
+			}
+			for (auto& [e, v] : b) {
+				if (!ecs.getComponent<B>().contains(e) || ecs.getComponent<B>().get(e).value != v) { return Check::fail("entity %u has the wrong B", (unsigned)e); }
+			}
+			for (std::size_t i = 0; i < handles.size(); i++) {
+				bool alive = aliveBefore[i] && !freed.count(handles[i].index);
+				if (ecs.isAlive(handles[i]) != alive) { return Check::fail("handle to entity %u is %s", (unsigned)handles[i].index, alive ? "dead" : "alive"); }
+			}
+
+			/* Refill what was freed, so the next step has entities to work with */
+			for (std::size_t i = 0; i < freed.size(); i++) { handles.push_back(ecs.getHandle(ecs.createEntity())); }
+		}
+		return true;
+	}
+}
+
+const char* const Check::NAME = "command_buffer_check";
+const std::size_t Check::DEFAULT_COUNT = 200;
+
+bool Check::run(const Args& args) {
+	if (!checkDeferredFree() || !checkDuplicateFrees() || !checkStaleHandles() || !checkOrder()) { return false; }
+	for (unsigned i = 0; i < args.count; i++) {
+		std::mt19937 rng(args.seed + i);
+		if (!checkRandom(rng)) { return fail("in round %u (seed %u)", i, args.seed + i); }
+	}
+	printf("%zu rounds of random changes matched the model\n", args.count);
+	return true;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file ECSBench.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Per-frame ECS system cost on stress maps with 16 and 32 bit entities.
+ * @copyright Copyright (c) 2025
+ */
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "BenchMaps.hpp"
+
+using namespace Tile;
+
+using StressECS16 = BasicMapECS<uint16_t, UINT16_MAX>;
+using StressECS32 = BasicMapECS<uint32_t, (uint32_t)(1u << 20)>;
+
+static const double FRAME_DELTA = 1.0 / 120.0;
+
+static const Velocity2 dirVecs[Direction::DirectionSize] = {
+	Velocity2{0,0},
+	Velocity2{0,1},
+	Velocity2{0,-1},
+	Velocity2{-1,0},
+	Velocity2{-0.7071f,0.7071f},
+	Velocity2{-0.7071f,-0.7071f},
+	Velocity2{1,0},
+	Velocity2{0.7071f,0.7071f},
+	Velocity2{0.7071f,-0.7071f}
+};
+
+/**
+ * @brief Run one frame of the ECS work done by the map systems.
+ *
+ * @details
+ * Follows the same component access pattern as Tile::MapScripting::processEntities,
+ * Tile::MapMovement::process (without collision queries), Tile::SpriteAnimator::process
+ * and Tile::MapMovement::postProcess, without needing a Tile::MapScene.
+ */
+template<class ECSType>
+static void stepFrame(ECSType& ecs, double delta) {
+	auto& positions = ecs.template getComponent<Position2>();
+	auto& velocities = ecs.template getComponent<Velocity2>();
+	auto& hitboxes = ecs.template getComponent<Hitbox>();
+	auto& actors = ecs.template getComponent<Actor>();
+	auto& sprites = ecs.template getComponent<ActorSprite>();
+	auto& animations = ecs.template getComponent<ActorSpriteAnims>();
+	auto& commands = ecs.template getComponent<MapCommand>();
+
+	for (auto e : commands) {
+		benchmark::DoNotOptimize(commands.get(e).data.type);
+	}
+
+	for (auto e : actors) {
+		velocities.get(e) = dirVecs[actors.get(e).movingDirection ? actors.get(e).direction : 0];
+		if (hitboxes.contains(e)) {
+			Position2& pos = positions.get(e);
+			pos += velocities.get(e) * actors.get(e).speed * (1 + actors.get(e).sprinting) * delta;
+			hitboxes.get(e).x = pos.x;
+			hitboxes.get(e).y = pos.y;
+		}
+	}
+
+	for (auto e : animations) {
+		ActorSpriteAnims& anims = animations.get(e);
+		const Actor& actor = actors.get(e);
+		const std::vector<TileId>& animation = actor.sprinting ?
+			anims.sprint[actor.direction] :
+			anims.walk[actor.direction];
+		anims.timer -= delta;
+		if (anims.timer > 0.0) { continue; }
+		if (++anims.index >= animation.size()) { anims.index = 0; }
+		anims.timer += anims.duration;
+		sprites.get(e).index = animation[anims.index];
+	}
+}
+
+/**
+ * @brief Same work as stepFrame, using an owned group for movement and a view for animation.
+ *
+ * @details
+ * The group is kept between frames like in Tile::MapMovement, so it is only packed once.
+ */
+template<class ECSType, class GroupType>
+static void stepFrameGrouped(ECSType& ecs, GroupType& movingActors, double delta) {
+	auto& commands = ecs.template getComponent<MapCommand>();
+	for (auto e : commands) {
+		benchmark::DoNotOptimize(commands.get(e).data.type);
+	}
+
+	movingActors.each(
+		[delta](typename ECSType::entity, Position2& pos, Velocity2& velocity, Actor& actor, Hitbox& box) {
+			velocity = dirVecs[actor.movingDirection ? actor.direction : 0];
+			pos += velocity * actor.speed * (1 + actor.sprinting) * delta;
+			box.x = pos.x;
+			box.y = pos.y;
+		}
+	);
+
+	ecs.template view<ActorSpriteAnims, Actor, ActorSprite>().each(
+		[delta](typename ECSType::entity, ActorSpriteAnims& anims, Actor& actor, ActorSprite& sprite) {
+			const std::vector<TileId>& animation = actor.sprinting ?
+				anims.sprint[actor.direction] :
+				anims.walk[actor.direction];
+			anims.timer -= delta;
+			if (anims.timer > 0.0) { return; }
+			if (++anims.index >= animation.size()) { anims.index = 0; }
+			anims.timer += anims.duration;
+			sprite.index = animation[anims.index];
+		}
+	);
+}
+
+template<class ECSType>
+static void BM_StressFrame(benchmark::State& state) {
+	auto ecs = std::make_unique<ECSType>();
+	std::vector<typename ECSType::entity> layer;
+	Bench::addStressActors(*ecs, state.range(0), layer);
+
+	for (auto _ : state) {
+		stepFrame(*ecs, FRAME_DELTA);
+		benchmark::ClobberMemory();
+	}
+	state.counters["entities"] = (double)layer.size();
+	state.SetItemsProcessed(state.iterations() * layer.size());
+}
+BENCHMARK_TEMPLATE(BM_StressFrame, StressECS16)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_StressFrame, StressECS32)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+template<class ECSType>
+static void BM_StressFrameGrouped(benchmark::State& state) {
+	auto ecs = std::make_unique<ECSType>();
+	std::vector<typename ECSType::entity> layer;
+	Bench::addStressActors(*ecs, state.range(0), layer);
+	auto movingActors = ecs->template group<Position2, Velocity2, Actor, Hitbox>();
+
+	for (auto _ : state) {
+		stepFrameGrouped(*ecs, movingActors, FRAME_DELTA);
+		benchmark::ClobberMemory();
+	}
+	state.counters["entities"] = (double)layer.size();
+	state.SetItemsProcessed(state.iterations() * layer.size());
+}
+BENCHMARK_TEMPLATE(BM_StressFrameGrouped, StressECS16)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_StressFrameGrouped, StressECS32)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Free and recreate 1% of the stress actors every frame.
+ *
+ */
+template<class ECSType>
+static void BM_StressEntityChurn(benchmark::State& state) {
+	auto ecs = std::make_unique<ECSType>();
+	std::vector<typename ECSType::entity> layer;
+	Bench::addStressActors(*ecs, state.range(0), layer);
+	std::size_t churn = layer.size() / 100;
+
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < churn; i++) { ecs->freeEntity(layer[i]); }
+		layer.erase(layer.begin(), layer.begin() + churn);
+		Bench::addStressActors(*ecs, churn, layer);
+	}
+	state.counters["entities"] = (double)layer.size();
+}
+BENCHMARK_TEMPLATE(BM_StressEntityChurn, StressECS16)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_StressEntityChurn, StressECS32)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Give every stress actor a long ActorWait command and run the scripting loop over them.
+ *
+ * @details
+ * Follows Tile::MapScripting::processEntities, which runs commands without
+ * checking their handles. With `CANCEL_FREED`, each iteration is a tick that
+ * freed an entity, so it also sweeps the commands with GRY_ECS::isAlive like
+ * Tile::MapScripting::cancelFreed does at the ECS sync point.
+ */
+template<class ECSType, bool CANCEL_FREED>
+static void BM_StressScripting(benchmark::State& state) {
+	auto ecs = std::make_unique<ECSType>();
+	std::vector<typename ECSType::entity> layer;
+	Bench::addStressActors(*ecs, state.range(0), layer);
+	auto& commands = ecs->template getComponent<MapCommand>();
+	for (auto e : layer) {
+		TMC_ActorWait wait;
+		wait.e = ECS::handle((ECS::entity)e);
+		wait.time = 1e9;
+		commands.get(e) = MapCommand{ .actorWait = wait };
+	}
+
+	for (auto _ : state) {
+		for (auto e : commands) {
+			MapCommand& command = commands.get(e);
+			if ((command.actorWait.time -= FRAME_DELTA) <= 0.f) {
+				command = MapCommand{ .data { MAP_CMD_NONE } };
+			}
+		}
+		if constexpr (CANCEL_FREED) {
+			for (MapCommand& command : commands.value) {
+				if (command.data.e != ECS::NONE_HANDLE && !ecs->isAlive(command.data.e)) {
+					command = MapCommand{ .data { MAP_CMD_NONE } };
+				}
+			}
+		}
+		benchmark::ClobberMemory();
+	}
+	state.counters["entities"] = (double)layer.size();
+	state.SetItemsProcessed(state.iterations() * layer.size());
+}
+BENCHMARK_TEMPLATE(BM_StressScripting, StressECS16, false)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_StressScripting, StressECS16, true)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Build a stress map and report the memory used by its ComponentSets.
+ *
+ * @details
+ * The `sparse_bytes` counter is the paged layout that is in use, and
+ * `flat_sparse_bytes` is what one flat sparse array per component would use.
+ */
+template<class ECSType>
+static void BM_StressMemory(benchmark::State& state) {
+	SparseSetMemory memory;
+	for (auto _ : state) {
+		auto ecs = std::make_unique<ECSType>();
+		std::vector<typename ECSType::entity> layer;
+		Bench::addStressActors(*ecs, state.range(0), layer);
+		memory = ecs->totalMemoryUsage();
+		benchmark::DoNotOptimize(memory);
+	}
+	state.counters["sparse_bytes"] = (double)memory.sparse;
+	state.counters["flat_sparse_bytes"] = (double)memory.flatSparse;
+	state.counters["total_bytes"] = (double)memory.total();
+	state.counters["pages"] = (double)memory.pages;
+}
+BENCHMARK_TEMPLATE(BM_StressMemory, StressECS16)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_StressMemory, StressECS32)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,116 @@
+/**
+ * @file EntityHandleCheck.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Checks that GRY_ECS handles stop being alive once their entity is freed, however often it is reused.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Usage: `entity_handle_check [rounds] [seed]`
+ *
+ * Checks that a handle dies when its entity is freed and another entity
+ * takes its index, and that a slot freed GRY_ECS::RETIRED_GENERATION times
+ * is retired rather than wrapping its generation back to a stale handle's.
+ * Then each round creates and frees random entities, keeping every handle
+ * ever made, and checks that exactly the handles of entities in use are
+ * alive.
+ */
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Check.hpp"
+#include "GRY_ECS.hpp"
+
+namespace {
+	struct A { int value; };
+
+	using TestECS = GRY_ECS<uint16_t, 1024, A>;
+	using Handle = TestECS::Handle;
+
+	bool checkReuse() {
+		TestECS ecs;
+		ecs.setCapacity(1);
+		Handle old = ecs.getHandle(ecs.createEntity());
+		ecs.freeEntity(old.index);
+		Handle reused = ecs.getHandle(ecs.createEntity());
+		if (reused.index != old.index) { return Check::fail("the freed entity was not reused"); }
+		if (ecs.isAlive(old) || !ecs.isAlive(reused)) {
+			return Check::fail("after reuse, the old handle is %s and the new one is %s",
+				ecs.isAlive(old) ? "alive" : "dead", ecs.isAlive(reused) ? "alive" : "dead"
+			);
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Free one slot until it retires, through both freeEntity and freeEntities.
+	 *
+	 */
+	bool checkRetirement() {
+		TestECS ecs;
+		ecs.setCapacity(1);
+		std::vector<Handle> handles;
+		for (unsigned i = 0; i < TestECS::RETIRED_GENERATION; i++) {
+			uint16_t e = ecs.createEntity();
+			if (e != 0) { return Check::fail("slot 0 was not reused after %u frees", i); }
+			handles.push_back(ecs.getHandle(e));
+			if (i % 2) { ecs.freeEntity(e); }
+			else { ecs.freeEntities(&e, &e + 1); }
+		}
+
+		if (ecs.createEntity() != TestECS::NONE) { return Check::fail("a slot freed %u times was reused", (unsigned)TestECS::RETIRED_GENERATION); }
+		for (Handle h : handles) {
+			if (ecs.isAlive(h)) { return Check::fail("a handle of generation %u is alive after its slot retired", (unsigned)h.generation); }
+		}
+
+		/* Retiring a slot costs one entity of capacity, not the ECS */
+		ecs.setCapacity(2);
+		Handle next = ecs.getHandle(ecs.createEntity());
+		if (next.index != 1 || !ecs.isAlive(next)) { return Check::fail("the ECS could not create another entity after a slot retired"); }
+		return true;
+	}
+
+	bool checkRandom(std::mt19937& rng) {
+		const std::size_t capacity = 32;
+		TestECS ecs;
+		ecs.setCapacity(capacity);
+		std::vector<Handle> handles;
+		std::vector<bool> inUse;
+		std::vector<std::size_t> live;
+		for (int step = 0; step < 2000; step++) {
+			if (live.size() < capacity && (live.empty() || rng() % 2)) {
+				uint16_t e = ecs.createEntity();
+				if (e == TestECS::NONE) { return Check::fail("could not create entity %zu of %zu", live.size() + 1, capacity); }
+				live.push_back(handles.size());
+				handles.push_back(ecs.getHandle(e));
+				inUse.push_back(true);
+			}
+			else {
+				std::size_t pick = rng() % live.size();
+				std::size_t i = live[pick];
+				live[pick] = live.back();
+				live.pop_back();
+				ecs.freeEntity(handles[i].index);
+				inUse[i] = false;
+			}
+		}
+		for (std::size_t i = 0; i < handles.size(); i++) {
+			if (ecs.isAlive(handles[i]) != inUse[i]) {
+				return Check::fail("handle %zu to entity %u is %s", i, (unsigned)handles[i].index, inUse[i] ? "dead" : "alive");
+			}
+		}
+		return true;
+	}
+}
+
+const char* const Check::NAME = "entity_handle_check";
+const std::size_t Check::DEFAULT_COUNT = 100;
+
+bool Check::run(const Args& args) {
+	if (!checkReuse() || !checkRetirement()) { return false; }
+	for (unsigned i = 0; i < args.count; i++) {
+		std::mt19937 rng(args.seed + i);
+		if (!checkRandom(rng)) { return fail("in round %u (seed %u)", i, args.seed + i); }
+	}
+	printf("%zu rounds, only the handles of entities in use were alive\n", args.count);
+	return true;
+}
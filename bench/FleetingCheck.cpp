@@ -0,0 +1,86 @@
+/**
+ * @file FleetingCheck.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Checks that a Fleeting collision interaction is freed safely in the middle of a tick.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Usage: `fleeting_check [ticks]`
+ *
+ * Puts an entity with a Fleeting collision interaction on top of the player
+ * in the stress map scene, then runs whole ticks and per-frame updates.
+ * The player touching it frees it at the ECS sync point of the second tick,
+ * and it must be gone from every entity layer by the time the rest of the
+ * tick looks at them. Needs the assets, so it has to be run from the build
+ * directory.
+ */
+#include <algorithm>
+#include <cstdio>
+#include "Check.hpp"
+#include "GRY_PixelGame.hpp"
+#include "scenes/TileMapScene.hpp"
+
+using namespace Tile;
+
+namespace {
+	const char* STRESS_SCENE_PATH = "assets/tilemapscene/stress/scene.json";
+
+	/**
+	 * @brief Add a Fleeting collision interaction on top of the player.
+	 *
+	 * @return Handle of the new entity.
+	 */
+	ECS::handle addFleeting(MapScene& scene) {
+		MapECS& ecs = scene.getECS();
+		ECS::entity player = ecs.getComponent<Player>().getEntity(0);
+		uint8_t layer = ecs.getComponent<MapEntity>().get(player).layer;
+
+		ECS::entity e = ecs.createEntity();
+		ecs.getComponent<Position2>().add(e, ecs.getComponent<Position2>().get(player));
+		ecs.getComponent<Velocity2>().add(e, Velocity2{ 0, 0 });
+		ecs.getComponent<Hitbox>().add(e, ecs.getComponent<Hitbox>().get(player));
+		ecs.getComponent<MapEntity>().add(e, MapEntity{ 0, layer });
+		ecs.getComponent<MapCollisionInteraction>().add(e, MapCollisionInteraction{
+			MapCommand{ .data { MAP_CMD_NONE, ECS::NONE_HANDLE } }, MapCollisionInteraction::Mode::Fleeting
+		});
+		scene.getTileEntityMap().entityLayers.at(layer).push_back(e);
+		EntityMap::sortLayer(&scene.getTileEntityMap(), layer);
+		return ecs.getHandle(e);
+	}
+
+	bool inAnyLayer(const EntityMap& entityMap, ECS::entity e) {
+		for (const EntityLayer& layer : entityMap.entityLayers) {
+			if (std::find(layer.begin(), layer.end(), e) != layer.end()) { return true; }
+		}
+		for (const EntityLayer& moved : entityMap.movedEntities) {
+			if (std::find(moved.begin(), moved.end(), e) != moved.end()) { return true; }
+		}
+		return false;
+	}
+}
+
+const char* const Check::NAME = "fleeting_check";
+const std::size_t Check::DEFAULT_COUNT = 10;
+
+bool Check::run(const Args& args) {
+	GRY_PixelGame game(960, 540, 120, false, true);
+	MapScene* scene = new MapScene(&game, STRESS_SCENE_PATH);
+	game.stackScene(scene);
+
+	ECS::handle fleeting = addFleeting(*scene);
+
+	for (std::size_t tick = 0; tick < args.count; tick++) {
+		scene->tick();
+		scene->process();
+		/* The first tick puts the new entity into the broadphases after movement, so the player finds it in the second */
+		if (tick == 1 && scene->getECSReadOnly().isAlive(fleeting)) {
+			return fail("the player touched the Fleeting interaction, but it was not freed");
+		}
+		if (!scene->getECSReadOnly().isAlive(fleeting) && inAnyLayer(scene->getTileEntityMap(), fleeting.index)) {
+			return fail("freed entity %u is still in an entity layer after tick %zu", (unsigned)fleeting.index, tick);
+		}
+	}
+	if (scene->getECSReadOnly().isAlive(fleeting)) { return fail("the Fleeting interaction was never freed"); }
+	printf("%zu ticks, the freed Fleeting interaction left every layer\n", args.count);
+	return true;
+}
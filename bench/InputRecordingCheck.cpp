@@ -0,0 +1,121 @@
+/**
+ * @file InputRecordingCheck.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Checks that input recordings replay exactly what was recorded.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Usage: `input_recording_check [frames] [seed]`
+ *
+ * Records random frames, including frame lengths that only differ in their
+ * last bits, and checks that replaying the file gives back identical frames.
+ * Also checks that a recording cut off in the middle of a frame replays the
+ * whole frames before it, and that files which are not recordings are rejected.
+ */
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "Check.hpp"
+#include "InputRecording.hpp"
+
+namespace {
+	const char* RECORDING_PATH = "input_recording_check.gryi";
+
+	bool sameFrame(const InputFrame& a, const InputFrame& b) {
+		return
+			a.pressed == b.pressed && a.latest == b.latest && a.single == b.single &&
+			memcmp(&a.delta, &b.delta, sizeof(double)) == 0;
+	}
+
+	std::vector<InputFrame> randomFrames(std::size_t count, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_int_distribution<int> button(0, VirtualButton::VIRTUAL_BUTTON_SIZE - 1);
+		std::uniform_int_distribution<int> mask(0, (1 << VirtualButton::VIRTUAL_BUTTON_SIZE) - 1);
+		std::uniform_real_distribution<double> delta(0.0, 0.1);
+		std::vector<InputFrame> frames(count);
+		for (InputFrame& frame : frames) {
+			frame.pressed = (uint16_t)(mask(rng) & ~1);
+			frame.latest = static_cast<VirtualButton>(button(rng));
+			frame.single = static_cast<VirtualButton>(button(rng));
+			frame.delta = delta(rng);
+		}
+		return frames;
+	}
+
+	bool record(const std::vector<InputFrame>& frames) {
+		InputRecorder recorder;
+		if (!recorder.open(RECORDING_PATH)) { return false; }
+		for (const InputFrame& frame : frames) { recorder.record(frame); }
+		return true;
+	}
+
+	bool checkReplay(const std::vector<InputFrame>& frames) {
+		InputReplay replay;
+		if (!replay.load(RECORDING_PATH)) {
+			printf("could not load the recording\n");
+			return false;
+		}
+		if (replay.size() != frames.size()) {
+			printf("recorded %zu frames, but replayed %zu\n", frames.size(), replay.size());
+			return false;
+		}
+		for (std::size_t i = 0; i < frames.size(); i++) {
+			const InputFrame* frame = replay.next();
+			if (!frame || !sameFrame(*frame, frames[i])) {
+				printf("frame %zu was not replayed as it was recorded\n", i);
+				return false;
+			}
+		}
+		if (replay.next() || replay.isPlaying()) {
+			printf("the replay did not end after the last frame\n");
+			return false;
+		}
+		return true;
+	}
+
+	bool checkTruncated(const std::vector<InputFrame>& frames) {
+		FILE* file = fopen(RECORDING_PATH, "ab");
+		if (!file) { return false; }
+		fputc(0, file);
+		fputc(0, file);
+		fputc(0, file);
+		fclose(file);
+		return checkReplay(frames);
+	}
+
+	bool checkRejected() {
+		FILE* file = fopen(RECORDING_PATH, "wb");
+		if (!file) { return false; }
+		fputs("{ \"not\" : \"a recording\" }", file);
+		fclose(file);
+		InputReplay replay;
+		if (replay.load(RECORDING_PATH) || replay.size()) {
+			printf("a file that is not a recording was loaded\n");
+			return false;
+		}
+		return true;
+	}
+}
+
+const char* const Check::NAME = "input_recording_check";
+const std::size_t Check::DEFAULT_COUNT = 100000;
+
+bool Check::run(const Args& args) {
+	std::vector<InputFrame> frames = randomFrames(args.count, args.seed);
+	/* Neighbouring doubles must not be rounded to the same frame length */
+	if (frames.size() >= 2) {
+		frames[0].delta = 1.0 / 60.0;
+		frames[1].delta = std::nextafter(1.0 / 60.0, 1.0);
+	}
+
+	bool passed = (record(frames) && checkReplay(frames)) || fail("the round trip");
+	passed = passed && (checkTruncated(frames) || fail("the truncated recording"));
+	passed = passed && (checkRejected() || fail("to reject an invalid file"));
+	remove(RECORDING_PATH);
+
+	if (passed) { printf("%zu frames replayed exactly\n", frames.size()); }
+	return passed;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file LayerSortBench.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Per-frame cost of keeping an entity layer ordered while every actor moves.
+ * @copyright Copyright (c) 2025
+ */
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "BenchMaps.hpp"
+#include "tile/TileEntityLayerSort.hpp"
+
+using namespace Tile;
+
+using LayerECS = BasicMapECS<uint16_t, UINT16_MAX>;
+
+/**
+ * @brief Move every actor in the layer by a small random step, like one frame of walking.
+ *
+ */
+static void jitterPositions(LayerECS& ecs, const std::vector<uint16_t>& layer, std::mt19937& rng) {
+	std::uniform_real_distribution<float> step(-1.f, 1.f);
+	for (auto e : layer) {
+		Position2& pos = ecs.getComponent<Position2>().get(e);
+		pos.x += step(rng);
+		pos.y += step(rng);
+	}
+}
+
+/**
+ * @brief The old approach: one insertion sort of the whole layer after each actor moves.
+ *
+ * @details
+ * Uses the corrected comparison, so it measures the cost of the approach
+ * rather than of the bug. Only run at small sizes, since it is quadratic per actor.
+ */
+static void BM_LayerSortPerActor(benchmark::State& state) {
+	auto ecs = std::make_unique<LayerECS>();
+	std::vector<uint16_t> layer;
+	Bench::addStressActors(*ecs, state.range(0), layer);
+	auto& positions = ecs->getComponent<Position2>();
+	sortEntityLayer(positions, layer);
+	std::mt19937 rng(2);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		jitterPositions(*ecs, layer, rng);
+		state.ResumeTiming();
+		for (std::size_t actor = 0; actor < layer.size(); actor++) {
+			for (std::size_t i = 1; i < layer.size(); i++) {
+				for (std::size_t j = i; j > 0 && positionLessThan(positions.get(layer[j]), positions.get(layer[j-1])); j--) {
+					std::swap(layer[j], layer[j-1]);
+				}
+			}
+		}
+		benchmark::ClobberMemory();
+	}
+	state.counters["actors"] = (double)layer.size();
+}
+BENCHMARK(BM_LayerSortPerActor)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Mark every actor as moved, then re-seat them once, like Tile::EntityMap::sortMoved.
+ *
+ */
+static void BM_LayerSortMoved(benchmark::State& state) {
+	auto ecs = std::make_unique<LayerECS>();
+	std::vector<uint16_t> layer, moved, buffer;
+	Bench::addStressActors(*ecs, state.range(0), layer);
+	auto& positions = ecs->getComponent<Position2>();
+	sortEntityLayer(positions, layer);
+	std::vector<bool> movedFlags(ecs->getCapacity(), false);
+	std::mt19937 rng(2);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		jitterPositions(*ecs, layer, rng);
+		state.ResumeTiming();
+		for (auto e : layer) {
+			movedFlags[e] = true;
+			moved.push_back(e);
+		}
+		mergeMovedEntities(positions, layer, moved, movedFlags, buffer);
+		benchmark::ClobberMemory();
+	}
+	state.counters["actors"] = (double)layer.size();
+}
+BENCHMARK(BM_LayerSortMoved)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Only 10% of the actors move each frame, the common case for a map with many idle NPCs.
+ *
+ */
+static void BM_LayerSortFewMoved(benchmark::State& state) {
+	auto ecs = std::make_unique<LayerECS>();
+	std::vector<uint16_t> layer, moved, buffer;
+	Bench::addStressActors(*ecs, state.range(0), layer);
+	auto& positions = ecs->getComponent<Position2>();
+	sortEntityLayer(positions, layer);
+	std::vector<bool> movedFlags(ecs->getCapacity(), false);
+	std::mt19937 rng(2);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		std::vector<uint16_t> movers;
+		for (auto e : layer) { if (rng() % 10 == 0) { movers.push_back(e); } }
+		jitterPositions(*ecs, movers, rng);
+		state.ResumeTiming();
+		for (auto e : movers) {
+			movedFlags[e] = true;
+			moved.push_back(e);
+		}
+		mergeMovedEntities(positions, layer, moved, movedFlags, buffer);
+		benchmark::ClobberMemory();
+	}
+	state.counters["actors"] = (double)layer.size();
+}
+BENCHMARK(BM_LayerSortFewMoved)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,120 @@
+/**
+ * @file LegacyQuadTree.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief The pointer-based QuadTree that the arena QuadTree replaced, kept as a benchmark baseline.
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include <vector>
+#include <utility>
+#include "Components.hpp"
+#include "ECS.hpp"
+
+namespace Bench {
+	/**
+	 * @brief QuadTree that allocates each node with `new` and frees every node on reset.
+	 *
+	 * @details
+	 * Same algorithm as before the arena rewrite, except that the leaf loop
+	 * in `mergeLeaves` counts down. The original counted up and walked off
+	 * the end of the child array as soon as a node split.
+	 */
+	struct LegacyQuadTree {
+		struct Node {
+			Hitbox area;
+			std::vector<Node*> nodes;
+			enum { Leaf, Branch } type = Leaf;
+			ECS::handle e = ECS::NONE_HANDLE;
+
+			Node(Hitbox area) : area(area), type(Node::Branch) {}
+			Node(Hitbox area, ECS::handle e) : area(area), e(e) {}
+			~Node() { for (auto node : nodes) { delete node; } }
+		};
+
+		static constexpr unsigned THRESHOLD = 6;
+		static constexpr float MIN_BOX_SIZE = 2.0f;
+
+		Node node;
+
+		LegacyQuadTree(Hitbox area) : node(area) {}
+
+		void insert(Hitbox box, ECS::handle e) { insert(&node, box, e); }
+
+		void query(Hitbox box, ECS::entity e, std::vector<ECS::handle>& out) const { query(&node, box, e, out); }
+
+		void reset() {
+			for (auto child : node.nodes) { delete child; }
+			node.nodes.clear();
+		}
+
+	private:
+		static bool collides(const Hitbox box, const Hitbox other) {
+			return
+				box.x + box.w > other.x &&
+				box.x < other.x + other.w &&
+				box.y + box.h > other.y &&
+				box.y < other.y + other.h;
+		}
+
+		static bool isWithin(const Hitbox outerBox, const Hitbox innerBox) {
+			return
+				innerBox.x >= outerBox.x &&
+				innerBox.y >= outerBox.y &&
+				innerBox.x + innerBox.w <= outerBox.x + outerBox.w &&
+				innerBox.y + innerBox.h <= outerBox.y + outerBox.h;
+		}
+
+		static Hitbox quadrantRect(Hitbox box, int quadrant) {
+			return Hitbox{
+				box.x + ((quadrant % 2) * (box.w * 0.5f)),
+				box.y + ((quadrant / 2) * (box.h * 0.5f)),
+				box.w * 0.5f, box.h * 0.5f
+			};
+		}
+
+		static void query(const Node* node, Hitbox box, ECS::entity e, std::vector<ECS::handle>& out) {
+			for (auto child : node->nodes) {
+				if (!collides(box, child->area)) { continue; }
+				if (child->type == Node::Leaf && child->e.index != e) { out.push_back(child->e); }
+				else { query(child, box, e, out); }
+			}
+		}
+
+		static void insert(Node* node, Hitbox box, ECS::handle e) {
+			for (auto child : node->nodes) {
+				if (child->type == Node::Leaf) { continue; }
+				if (isWithin(child->area, box)) {
+					insert(child, box, e);
+					return;
+				}
+			}
+			node->nodes.push_back(new Node(box, e));
+			if (node->nodes.size() > THRESHOLD) { mergeLeaves(node); }
+		}
+
+		static void mergeLeaves(Node* node) {
+			if (node->area.w < MIN_BOX_SIZE || node->area.h < MIN_BOX_SIZE) { return; }
+			for (int i = 0; i < 4; i++) {
+				Hitbox box = quadrantRect(node->area, i);
+				unsigned count = 0;
+				for (auto& child : node->nodes) {
+					if (child->type == Node::Branch || !isWithin(box, child->area)) { continue; }
+					count++;
+				}
+				if (count < 2) { continue; }
+
+				Node* newNode = new Node(box);
+				for (int j = (int)node->nodes.size() - 1; j >= 0; j--) {
+					Node* child = node->nodes.at(j);
+					if (child->type == Node::Branch || !isWithin(box, child->area)) { continue; }
+					insert(newNode, child->area, child->e);
+					std::swap(node->nodes.at(j), node->nodes.back());
+					delete node->nodes.back();
+					node->nodes.pop_back();
+				}
+				node->nodes.push_back(newNode);
+				break;
+			}
+		}
+	};
+};
@@ -0,0 +1,178 @@
+/**
+ * @file MapSceneBench.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Map systems run on the real stress map scene, in a headless game.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Unlike the other benchmarks, these run the engine's own code on a loaded
+ * Tile::MapScene, so they need the assets and have to be run from the build
+ * directory.
+ */
+#include <benchmark/benchmark.h>
+#include "BenchMaps.hpp"
+#include "GRY_PixelGame.hpp"
+#include "GRY_JSON.hpp"
+#include "scenes/TileMapScene.hpp"
+#include "textbox/TextBoxRenderer.hpp"
+
+using namespace Tile;
+
+static const char* STRESS_SCENE_PATH = "assets/tilemapscene/stress/scene.json";
+static const char* STRESS_MAP_PATH = "assets/maps/stressMap.json";
+static const char* STRESS_TILESET_PATH = "assets/textures/data/tileset01.json";
+
+/**
+ * @brief Entity layer of `stressMapEntity.json` that holds the player, and that Bench::addStressActors puts actors on.
+ *
+ */
+static const unsigned ACTOR_LAYER = 1;
+
+static const double TICK_DELTA = 1.0 / 60.0;
+
+/**
+ * @brief A headless game running the stress map scene.
+ *
+ * @details
+ * Loading the scene takes a while, so it is made once and shared.
+ * Benchmarks that add actors to it only ever add more.
+ */
+struct StressScene {
+	GRY_PixelGame game;
+	MapScene* scene;
+
+	StressScene() : game(960, 540, 120, false, true), scene(new MapScene(&game, STRESS_SCENE_PATH)) {
+		game.stackScene(scene);
+	}
+};
+
+static StressScene& getStressScene() {
+	static StressScene stress;
+	return stress;
+}
+
+/**
+ * @brief Add colliding stress actors to the scene until its actor layer holds `count` entities.
+ *
+ */
+static void fillActorLayer(MapScene& scene, std::size_t count) {
+	EntityLayer& layer = scene.getTileEntityMap().entityLayers.at(ACTOR_LAYER);
+	if (layer.size() >= count) { return; }
+
+	std::size_t first = layer.size();
+	Bench::addStressActors(scene.getECS(), count - first, layer, (unsigned)count);
+	for (std::size_t i = first; i < layer.size(); i++) {
+		scene.getECS().getComponent<Collides>().add(layer[i], Collides{});
+	}
+	EntityMap::sortLayer(&scene.getTileEntityMap(), ACTOR_LAYER);
+	/* One tick puts the new actors into the broadphases */
+	scene.tick();
+}
+
+/**
+ * @brief Tile::MapMovement::process with every actor walking, colliding with each other and the map.
+ *
+ */
+static void BM_MapMovement(benchmark::State& state) {
+	MapScene& scene = *getStressScene().scene;
+	fillActorLayer(scene, state.range(0));
+	MapMovement movement(&scene);
+	auto& actors = scene.getECS().getComponent<Actor>();
+
+	for (auto _ : state) {
+		for (Actor& actor : actors.value) { actor.movingDirection = actor.direction; }
+		movement.process(TICK_DELTA);
+		state.PauseTiming();
+		/* Keep the moved entity lists from growing between iterations */
+		EntityMap::sortMoved(&scene.getTileEntityMap());
+		state.ResumeTiming();
+	}
+	state.counters["actors"] = (double)actors.size();
+	state.SetItemsProcessed(state.iterations() * actors.size());
+}
+BENCHMARK(BM_MapMovement)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Tile::MapRenderer::process of a screen in the middle of the map, with the headless software renderer.
+ *
+ * @details
+ * The first frame draws the chunks in view into their textures, so the
+ * iterations after it measure the cached drawing.
+ */
+static void BM_MapRender(benchmark::State& state) {
+	MapScene& scene = *getStressScene().scene;
+	fillActorLayer(scene, state.range(0));
+	MapRenderer renderer(&scene);
+	const TileMap& map = scene.getTileMap();
+	renderer.setOffset(
+		-(map.width * (float)scene.getNormalTileSize() - scene.getPixelGame()->getScreenWidthPixels()) * 0.5f,
+		-(map.height * (float)scene.getNormalTileSize() - scene.getPixelGame()->getScreenHeightPixels()) * 0.5f
+	);
+
+	for (auto _ : state) { renderer.process(); }
+	state.counters["drawCalls"] = (double)renderer.getBatchStats().drawCalls;
+	state.counters["cachedChunks"] = (double)renderer.getCachedChunks();
+}
+BENCHMARK(BM_MapRender)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Tile::Tileset::processAnimations with `count` animated tiles, copied from the tileset's own.
+ *
+ * @details
+ * Only the animations that change frame in a call cost anything, so this
+ * grows with how many change per tick rather than with `count`.
+ *
+ */
+static void BM_TilesetAnimations(benchmark::State& state) {
+	GRY_PixelGame& game = getStressScene().game;
+	Tileset tileset(STRESS_TILESET_PATH);
+	while (!tileset.load(&game)) {}
+
+	std::vector<Animation> animations = tileset.tileAnimations;
+	for (std::size_t i = 0; tileset.tileAnimations.size() < (std::size_t)state.range(0); i++) {
+		const Animation& source = animations.at(i % animations.size());
+		TileId tile = (TileId)(1 + i % (tileset.textureIdx.size() - 1));
+		/* Offset the timers so the animations do not all change frame together */
+		tileset.tileAnimations.push_back(Animation{ source.frames, 0, (i % 7) * TICK_DELTA, tile });
+	}
+
+	for (auto _ : state) {
+		tileset.processAnimations(TICK_DELTA);
+		benchmark::ClobberMemory();
+	}
+	state.counters["animations"] = (double)tileset.tileAnimations.size();
+	state.counters["changedTiles"] = (double)tileset.getChangedTiles().size();
+}
+BENCHMARK(BM_TilesetAnimations)->Arg(1)->Arg(256)->Arg(4096)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief GRY_JSON::loadDoc of `stressMap.json`.
+ *
+ */
+static void BM_LoadStressMap(benchmark::State& state) {
+	for (auto _ : state) {
+		GRY_JSON::Document doc;
+		GRY_JSON::loadDoc(doc, STRESS_MAP_PATH);
+		benchmark::DoNotOptimize(doc.MemberCount());
+	}
+}
+BENCHMARK(BM_LoadStressMap)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Lay out and draw a dialogue line in the map's text box, like TextBoxScene::process does once a line is typed out.
+ *
+ */
+static void BM_TextBoxLayout(benchmark::State& state) {
+	MapScene& scene = *getStressScene().scene;
+	TextBoxRenderer renderer(&scene.getTextBox());
+	const char* line = "This is a message that is being typed out. It is long enough that it has to wrap over several lines of the text box.";
+
+	for (auto _ : state) {
+		renderer.reset();
+		renderer.beginRender();
+		renderer.setSpacingFromLine(line);
+		benchmark::DoNotOptimize(renderer.renderLine(line, 0.f));
+		renderer.endRender();
+	}
+}
+BENCHMARK(BM_TextBoxLayout)->Unit(benchmark::kMicrosecond);
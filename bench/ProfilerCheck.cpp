@@ -0,0 +1,123 @@
+/**
+ * @file ProfilerCheck.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Checks that GRY_Profiler keeps the right frames and zones.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Usage: `profiler_check [frames]`, the seed is not used
+ *
+ * Records more frames than the ring holds, each with nested and repeated
+ * zones, and checks that the newest frames are kept in order with correct
+ * depths and times. Also checks that zones past MAX_ZONES are dropped, that
+ * pausing stops recording, and that the exported trace is written.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Check.hpp"
+#include "GRY_Profiler.hpp"
+
+namespace {
+	const char* TRACE_PATH = "profiler_check.json";
+
+	bool checkFrame(const GRY_Profiler::Frame& frame, std::size_t number) {
+		std::size_t ticks = number % 3 + 1;
+		if (frame.zoneCount != 1 + ticks * 2) {
+			printf("frame %zu has %zu zones, expected %zu\n", number, frame.zoneCount, 1 + ticks * 2);
+			return false;
+		}
+		if (strcmp(frame.zones[0].name, "Outer") != 0 || frame.zones[0].depth != 0) {
+			printf("frame %zu does not start with its outer zone\n", number);
+			return false;
+		}
+		for (std::size_t i = 0; i < ticks; i++) {
+			const GRY_Profiler::Zone& tick = frame.zones[1 + i * 2];
+			const GRY_Profiler::Zone& inner = frame.zones[2 + i * 2];
+			if (strcmp(tick.name, "Tick") != 0 || tick.depth != 1 || strcmp(inner.name, "Inner") != 0 || inner.depth != 2) {
+				printf("frame %zu has the wrong zone names or depths\n", number);
+				return false;
+			}
+		}
+		for (std::size_t i = 0; i < frame.zoneCount; i++) {
+			const GRY_Profiler::Zone& zone = frame.zones[i];
+			if (zone.start < frame.start || zone.end < zone.start || zone.end > frame.end) {
+				printf("frame %zu has a zone outside of it\n", number);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+const char* const Check::NAME = "profiler_check";
+const std::size_t Check::DEFAULT_COUNT = GRY_Profiler::FRAME_HISTORY * 3 + 7;
+
+bool Check::run(const Args& args) {
+	const std::size_t count = args.count;
+	bool passed = true;
+
+	/* Each frame has a different number of ticks, so the kept frames can be told apart */
+	for (std::size_t i = 0; i < count; i++) {
+		GRY_ProfileFrame();
+		GRY_ProfileScope("Outer");
+		for (std::size_t j = 0; j < i % 3 + 1; j++) {
+			GRY_ProfileScope("Tick");
+			{ GRY_ProfileScope("Inner"); }
+		}
+	}
+	GRY_ProfileFrame();
+
+	std::size_t kept = count < GRY_Profiler::FRAME_HISTORY - 1 ? count : GRY_Profiler::FRAME_HISTORY - 1;
+	if (GRY_Profiler::frameCount() != kept) {
+		printf("kept %zu frames, expected %zu\n", GRY_Profiler::frameCount(), kept);
+		passed = false;
+	}
+	for (std::size_t age = 0; passed && age < kept; age++) {
+		const GRY_Profiler::Frame& frame = GRY_Profiler::getFrame(age);
+		passed = checkFrame(frame, count - 1 - age);
+		if (passed && age + 1 < kept && GRY_Profiler::getFrame(age + 1).end > frame.start) {
+			printf("frames %zu and %zu are out of order\n", age, age + 1);
+			passed = false;
+		}
+	}
+	if (!passed) { return fail("the ring buffer"); }
+
+	/* Zones past the limit are dropped without disturbing the rest */
+	{
+		for (std::size_t i = 0; i < GRY_Profiler::MAX_ZONES + 10; i++) { GRY_ProfileScope("Many"); }
+		GRY_ProfileFrame();
+		const GRY_Profiler::Frame& frame = GRY_Profiler::getFrame(0);
+		if (frame.zoneCount != GRY_Profiler::MAX_ZONES || frame.zones[GRY_Profiler::MAX_ZONES - 1].depth != 0) {
+			return fail("to drop zones past MAX_ZONES");
+		}
+	}
+
+	/* Nothing is recorded while paused */
+	{
+		std::size_t before = GRY_Profiler::frameCount();
+		uint64_t latestStart = GRY_Profiler::getFrame(0).start;
+		GRY_Profiler::setPaused(true);
+		for (std::size_t i = 0; i < 10; i++) {
+			GRY_ProfileFrame();
+			GRY_ProfileScope("Paused");
+		}
+		GRY_Profiler::setPaused(false);
+		if (GRY_Profiler::frameCount() != before || GRY_Profiler::getFrame(0).start != latestStart) {
+			return fail("to stop recording while paused");
+		}
+	}
+
+	{
+		passed = GRY_Profiler::exportChromeTrace(TRACE_PATH);
+		FILE* file = fopen(TRACE_PATH, "r");
+		char head[32] = {};
+		if (!file || !fgets(head, sizeof(head), file) || strncmp(head, "{\"displayTimeUnit\"", 18) != 0) { passed = false; }
+		if (file) { fclose(file); }
+		remove(TRACE_PATH);
+		if (!passed) { return fail("to export a Chrome trace"); }
+	}
+
+	printf("%zu frames profiled, the last %zu kept correctly\n", count, kept);
+	return true;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file QuadTreeBench.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Rebuild and query cost of the arena QuadTree against the old pointer-based tree.
+ * @copyright Copyright (c) 2025
+ */
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "BenchMaps.hpp"
+#include "LegacyQuadTree.hpp"
+#include "QuadTree.hpp"
+
+using namespace Tile;
+
+using TreeECS = BasicMapECS<uint16_t, UINT16_MAX>;
+
+static const Hitbox STRESS_MAP_AREA{ 0, 0,
+	Bench::STRESS_MAP_TILES * Bench::NORMAL_TILE_SIZE,
+	Bench::STRESS_MAP_TILES * Bench::NORMAL_TILE_SIZE
+};
+
+/**
+ * @brief Clear the tree and insert every stress actor's hitbox, like Tile::MapQuadTrees::process.
+ *
+ */
+template<class Tree>
+static void BM_QuadTreeRebuild(benchmark::State& state) {
+	auto ecs = std::make_unique<TreeECS>();
+	std::vector<uint16_t> layer;
+	Bench::addStressActors(*ecs, state.range(0), layer);
+	auto& hitboxes = ecs->getComponent<Hitbox>();
+	Tree tree(STRESS_MAP_AREA);
+
+	for (auto _ : state) {
+		tree.reset();
+		for (auto e : layer) { tree.insert(hitboxes.get(e), ecs->getHandle(e)); }
+		if constexpr (requires { tree.compact(); }) { tree.compact(); }
+		benchmark::ClobberMemory();
+	}
+	state.counters["actors"] = (double)layer.size();
+}
+BENCHMARK_TEMPLATE(BM_QuadTreeRebuild, Bench::LegacyQuadTree)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_QuadTreeRebuild, QuadTree)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Query every stress actor's hitbox against the tree once, like one frame of movement.
+ *
+ */
+template<class Tree>
+static void BM_QuadTreeQuery(benchmark::State& state) {
+	auto ecs = std::make_unique<TreeECS>();
+	std::vector<uint16_t> layer;
+	Bench::addStressActors(*ecs, state.range(0), layer);
+	auto& hitboxes = ecs->getComponent<Hitbox>();
+	Tree tree(STRESS_MAP_AREA);
+	for (auto e : layer) { tree.insert(hitboxes.get(e), ecs->getHandle(e)); }
+	if constexpr (requires { tree.compact(); }) { tree.compact(); }
+
+	std::vector<ECS::handle> out;
+	std::size_t hits = 0;
+	for (auto _ : state) {
+		hits = 0;
+		for (auto e : layer) {
+			out.clear();
+			tree.query(hitboxes.get(e), e, out);
+			hits += out.size();
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.counters["actors"] = (double)layer.size();
+	state.counters["hits"] = (double)hits;
+}
+BENCHMARK_TEMPLATE(BM_QuadTreeQuery, Bench::LegacyQuadTree)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_QuadTreeQuery, QuadTree)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Move a percentage of the stress actors a little and update their boxes, like Tile::MapQuadTrees does between rebuilds.
+ *
+ * @details
+ * Compare with BM_QuadTreeRebuild, which is what every frame cost before the trees were kept incrementally.
+ */
+static void BM_QuadTreeIncremental(benchmark::State& state) {
+	auto ecs = std::make_unique<TreeECS>();
+	std::vector<uint16_t> layer;
+	Bench::addStressActors(*ecs, state.range(0), layer);
+	auto& hitboxes = ecs->getComponent<Hitbox>();
+	QuadTree tree(STRESS_MAP_AREA);
+	for (auto e : layer) { tree.insert(hitboxes.get(e), ecs->getHandle(e)); }
+	tree.compact();
+
+	const std::size_t moving = layer.size() * state.range(1) / 100;
+	float step = 1.f;
+	std::size_t relocated = 0;
+	for (auto _ : state) {
+		relocated = 0;
+		for (std::size_t i = 0; i < moving; i++) {
+			Hitbox& box = hitboxes.get(layer[i]);
+			box.x += step;
+			relocated += tree.update(box, layer[i]);
+		}
+		if (!tree.isCompacted()) { tree.compact(); }
+		step = -step;
+	}
+	state.counters["moving"] = (double)moving;
+	state.counters["relocated"] = (double)relocated;
+}
+BENCHMARK(BM_QuadTreeIncremental)->Args({ 10000, 10 })->Args({ 10000, 100 })->Unit(benchmark::kMicrosecond);
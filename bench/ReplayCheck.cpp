@@ -0,0 +1,147 @@
+/**
+ * @file ReplayCheck.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Checks that runGame and runHeadless replay a recording to the same state.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Usage: `replay_check [frames] [seed]`
+ *
+ * Writes a recording of random walking with random frame lengths, then
+ * replays it on the stress map scene once with runHeadless and once with
+ * runGame, on a headless game. The position of every entity has to match
+ * exactly at the end. Needs the assets, so it has to be run from the build
+ * directory.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Check.hpp"
+#include "GRY_PixelGame.hpp"
+#include "InputRecording.hpp"
+#include "scenes/TileMapScene.hpp"
+
+using namespace Tile;
+
+namespace {
+	const char* RECORDING_PATH = "replay_check.gryi";
+	const char* STRESS_SCENE_PATH = "assets/tilemapscene/stress/scene.json";
+
+	const VirtualButton DIRECTIONS[] = { GAME_UP, GAME_DOWN, GAME_LEFT, GAME_RIGHT };
+
+	struct EntityPosition {
+		ECS::entity e;
+		Position2 position;
+	};
+
+	/**
+	 * @brief A headless game on the stress map scene.
+	 *
+	 * @details
+	 * Both runHeadless and a headless runGame stop when the replay ends.
+	 */
+	class ReplayGame : public GRY_PixelGame {
+	public:
+		MapScene* scene;
+
+		ReplayGame() : GRY_PixelGame(960, 540, 120, false, true), scene(new MapScene(this, STRESS_SCENE_PATH)) {
+			stackScene(scene);
+		}
+	};
+
+	/**
+	 * @brief Record random walking, holding each direction for a while.
+	 *
+	 * @details
+	 * Only directions are pressed, so no menus or dialogue open. The last
+	 * frame lasts no time, so no ticks are owed once the replay ends.
+	 */
+	bool record(std::size_t count, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_int_distribution<int> direction(-1, 3);
+		std::uniform_int_distribution<int> hold(1, 30);
+		std::uniform_real_distribution<double> delta(1.0 / 240.0, 1.0 / 20.0);
+
+		InputRecorder recorder;
+		if (!recorder.open(RECORDING_PATH)) { return false; }
+		VirtualButton held = GAME_NONE;
+		int frames = 0;
+		for (std::size_t i = 0; i < count; i++) {
+			InputFrame frame;
+			if (frames-- <= 0) {
+				int d = direction(rng);
+				VirtualButton next = d < 0 ? GAME_NONE : DIRECTIONS[d];
+				frame.single = next != held ? next : GAME_NONE;
+				held = next;
+				frames = hold(rng);
+			}
+			frame.pressed = held ? (uint16_t)(1 << held) : 0;
+			frame.latest = held;
+			frame.delta = i + 1 < count ? delta(rng) : 0.0;
+			recorder.record(frame);
+		}
+		return true;
+	}
+
+	std::vector<EntityPosition> positions(const MapScene& scene) {
+		const auto& set = scene.getECSReadOnly().getComponentReadOnly<Position2>();
+		std::vector<EntityPosition> result;
+		result.reserve(set.size());
+		for (std::size_t i = 0; i < set.size(); i++) {
+			ECS::entity e = set.getEntity(i);
+			result.push_back(EntityPosition{ e, set.get(e) });
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Replay the recording with `runHeadless` or `runGame`.
+	 *
+	 * @param start Set to the positions before the replay.
+	 * @return The positions after the replay.
+	 */
+	std::vector<EntityPosition> replay(bool headless, std::vector<EntityPosition>& start) {
+		ReplayGame game;
+		start = positions(*game.scene);
+		if (!game.replayInput(RECORDING_PATH)) { return {}; }
+		if (headless) { game.runHeadless(UINT64_MAX); }
+		else { game.runGame(); }
+		return positions(*game.scene);
+	}
+
+	bool samePosition(const EntityPosition& a, const EntityPosition& b) {
+		return a.e == b.e && a.position[0] == b.position[0] && a.position[1] == b.position[1];
+	}
+}
+
+const char* const Check::NAME = "replay_check";
+const std::size_t Check::DEFAULT_COUNT = 600;
+
+bool Check::run(const Args& args) {
+	if (!record(args.count, args.seed)) { return fail("could not write %s", RECORDING_PATH); }
+
+	std::vector<EntityPosition> start, unused;
+	std::vector<EntityPosition> headless = replay(true, start);
+	std::vector<EntityPosition> windowed = replay(false, unused);
+	remove(RECORDING_PATH);
+
+	if (headless.empty()) { return fail("could not replay %s", RECORDING_PATH); }
+	if (headless.size() != windowed.size()) {
+		return fail("runHeadless ended with %zu positions, runGame with %zu", headless.size(), windowed.size());
+	}
+
+	bool moved = false;
+	for (std::size_t i = 0; i < headless.size(); i++) {
+		const EntityPosition& a = headless[i];
+		const EntityPosition& b = windowed[i];
+		if (!samePosition(a, b)) {
+			return fail("entity %u ended at (%f, %f) with runHeadless, but entity %u at (%f, %f) with runGame",
+				(unsigned)a.e, a.position[0], a.position[1], (unsigned)b.e, b.position[0], b.position[1]
+			);
+		}
+		if (i >= start.size() || !samePosition(a, start[i])) { moved = true; }
+	}
+	if (!moved) { return fail("nothing moved during the replay, so it checked nothing"); }
+	return true;
+}
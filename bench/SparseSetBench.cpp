@@ -0,0 +1,110 @@
+/**
+ * @file SparseSetBench.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Cost of the basic SparseSet operations, and of freeing stress actors from a GRY_ECS.
+ * @copyright Copyright (c) 2025
+ */
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include "BenchMaps.hpp"
+
+using namespace Tile;
+
+using PositionSet = SparseSet<Position2, uint16_t, UINT16_MAX>;
+using FreeECS = BasicMapECS<uint16_t, UINT16_MAX>;
+
+/**
+ * @brief `count` distinct entities spread over the whole entity range, in a random order.
+ *
+ */
+static std::vector<uint16_t> randomEntities(std::size_t count) {
+	std::vector<uint16_t> entities(UINT16_MAX);
+	for (std::size_t i = 0; i < entities.size(); i++) { entities[i] = (uint16_t)i; }
+	std::shuffle(entities.begin(), entities.end(), std::mt19937(5));
+	entities.resize(count);
+	return entities;
+}
+
+/**
+ * @brief Add `count` entities to an empty set, including the sparse pages they need.
+ *
+ */
+static void BM_SparseSetAdd(benchmark::State& state) {
+	std::vector<uint16_t> entities = randomEntities(state.range(0));
+	PositionSet set;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		set.clear();
+		state.ResumeTiming();
+		for (auto e : entities) { set.add(e, Position2{ 1.f, 2.f }); }
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * entities.size());
+}
+BENCHMARK(BM_SparseSetAdd)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Remove `count` entities from a full set, in a different order than they were added.
+ *
+ */
+static void BM_SparseSetRemove(benchmark::State& state) {
+	std::vector<uint16_t> entities = randomEntities(state.range(0));
+	std::vector<uint16_t> removeOrder = entities;
+	std::shuffle(removeOrder.begin(), removeOrder.end(), std::mt19937(6));
+	PositionSet set;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		set.clear();
+		for (auto e : entities) { set.add(e, Position2{ 1.f, 2.f }); }
+		state.ResumeTiming();
+		for (auto e : removeOrder) { set.remove(e); }
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * entities.size());
+}
+BENCHMARK(BM_SparseSetRemove)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Get the data of every entity in the set, in a random order.
+ *
+ */
+static void BM_SparseSetGet(benchmark::State& state) {
+	std::vector<uint16_t> entities = randomEntities(state.range(0));
+	PositionSet set;
+	for (auto e : entities) { set.add(e, Position2{ (float)e, 2.f }); }
+	std::shuffle(entities.begin(), entities.end(), std::mt19937(6));
+
+	for (auto _ : state) {
+		float sum = 0;
+		for (auto e : entities) { sum += set.get(e).x; }
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * entities.size());
+}
+BENCHMARK(BM_SparseSetGet)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Free every stress actor one at a time with GRY_ECS::freeEntity.
+ *
+ */
+static void BM_FreeEntity(benchmark::State& state) {
+	std::vector<uint16_t> layer;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto ecs = std::make_unique<FreeECS>();
+		layer.clear();
+		Bench::addStressActors(*ecs, state.range(0), layer);
+		state.ResumeTiming();
+		for (auto e : layer) { ecs->freeEntity(e); }
+		benchmark::ClobberMemory();
+		state.PauseTiming();
+		ecs.reset();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FreeEntity)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
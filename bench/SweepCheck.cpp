@@ -0,0 +1,243 @@
+/**
+ * @file SweepCheck.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Checks that sweepAndSlide never moves a hitbox through an obstacle.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Usage: `sweep_check [rounds] [seed]`
+ *
+ * Each round scatters thin walls and tile sized blocks, then moves random
+ * hitboxes through them at speeds of up to a few thousand pixels per frame.
+ * The path that sweepAndSlide took is rebuilt from the hit it reports, and
+ * sampled every quarter pixel, so any sample overlapping an obstacle means
+ * the hitbox tunneled through it. Boxes that start inside a block have to
+ * be pushed out of it the shortest way first. The first failure is printed
+ * along with the round's seed, so it can be replayed with
+ * `sweep_check 1 <seed>`.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "Check.hpp"
+#include "SweptAABB.hpp"
+
+namespace {
+	const float AREA_SIZE = 1024.f;
+
+	/**
+	 * @brief Distance between samples of a path, smaller than the thinnest wall.
+	 *
+	 */
+	const float SAMPLE_STEP = 0.25f;
+
+	bool overlaps(const Hitbox& box, const Hitbox& other) {
+		return
+			box.x + box.w - other.x > SWEEP_CONTACT_EPSILON &&
+			other.x + other.w - box.x > SWEEP_CONTACT_EPSILON &&
+			box.y + box.h - other.y > SWEEP_CONTACT_EPSILON &&
+			other.y + other.h - box.y > SWEEP_CONTACT_EPSILON;
+	}
+
+	const Hitbox* findOverlap(const Hitbox& box, const std::vector<Hitbox>& obstacles) {
+		for (const Hitbox& obstacle : obstacles) {
+			if (overlaps(box, obstacle)) { return &obstacle; }
+		}
+		return nullptr;
+	}
+
+	void printBox(const char* name, const Hitbox& box) {
+		printf("  %s {%g, %g, %g, %g}\n", name, box.x, box.y, box.w, box.h);
+	}
+
+	/**
+	 * @brief Check every sample of the straight path from `from` to `to`.
+	 *
+	 */
+	bool checkLeg(const Hitbox& from, const Hitbox& to, const std::vector<Hitbox>& obstacles) {
+		float distance = std::max(fabsf(to.x - from.x), fabsf(to.y - from.y));
+		int steps = (int)ceilf(distance / SAMPLE_STEP);
+		for (int i = 0; i <= steps; i++) {
+			float t = steps ? (float)i / steps : 1.f;
+			Hitbox sample{ from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t, from.w, from.h };
+			if (const Hitbox* obstacle = findOverlap(sample, obstacles)) {
+				printf("path passes through an obstacle\n");
+				printBox("sample", sample);
+				printBox("obstacle", *obstacle);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::vector<Hitbox> randomObstacles(std::mt19937& rng) {
+		std::uniform_real_distribution<float> coord(0.f, AREA_SIZE);
+		std::uniform_real_distribution<float> length(16.f, 256.f);
+		std::uniform_int_distribution<int> tiles(1, 4);
+		std::uniform_int_distribution<int> kind(0, 2);
+		std::vector<Hitbox> obstacles;
+		for (int i = 0; i < 48; i++) {
+			switch (kind(rng)) {
+				case 0: obstacles.push_back(Hitbox{ coord(rng), coord(rng), 1.f, length(rng) }); break;
+				case 1: obstacles.push_back(Hitbox{ coord(rng), coord(rng), length(rng), 1.f }); break;
+				default: obstacles.push_back(Hitbox{
+					floorf(coord(rng) / 16) * 16, floorf(coord(rng) / 16) * 16, 16.f * tiles(rng), 16.f * tiles(rng)
+				});
+			}
+		}
+		return obstacles;
+	}
+
+	Velocity2 randomMotion(std::mt19937& rng) {
+		std::uniform_real_distribution<float> speed(-3000.f, 3000.f);
+		std::uniform_int_distribution<int> straight(0, 3);
+		Velocity2 motion{ speed(rng), speed(rng) };
+		switch (straight(rng)) {
+			case 0: motion.x = 0; break;
+			case 1: motion.y = 0; break;
+			default: break;
+		}
+		return motion;
+	}
+
+	/**
+	 * @brief Move a hitbox that overlaps none of the obstacles, and check its path.
+	 *
+	 */
+	bool checkPath(const Hitbox& box, Velocity2 motion, const std::vector<Hitbox>& obstacles) {
+		SweepHit hit;
+		Hitbox result = sweepAndSlide(box, motion, obstacles, &hit);
+		if (const Hitbox* obstacle = findOverlap(result, obstacles)) {
+			printf("moved into an obstacle\n");
+			printBox("result", result);
+			printBox("obstacle", *obstacle);
+			return false;
+		}
+		if (hit.axis < 0) {
+			if (result.x != box.x + motion.x || result.y != box.y + motion.y) {
+				printf("nothing was hit, but the box did not move all the way\n");
+				return false;
+			}
+			return checkLeg(box, result, obstacles);
+		}
+		if (hit.time < 0 || hit.time > 1) {
+			printf("hit at time %g\n", hit.time);
+			return false;
+		}
+
+		/* The box moves up to the first hit, then slides along the other axis */
+		Hitbox corner = result;
+		if (hit.axis == 0) { corner.y = box.y + motion.y * hit.time; }
+		else { corner.x = box.x + motion.x * hit.time; }
+		if (!checkLeg(box, corner, obstacles) || !checkLeg(corner, result, obstacles)) {
+			printBox("box", box);
+			printf("  motion {%g, %g}, hit axis %d at time %g\n", motion.x, motion.y, hit.axis, hit.time);
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Move a random hitbox through the obstacles and check its path.
+	 *
+	 */
+	bool checkMove(const std::vector<Hitbox>& obstacles, std::mt19937& rng) {
+		std::uniform_real_distribution<float> coord(0.f, AREA_SIZE);
+		std::uniform_real_distribution<float> size(4.f, 24.f);
+
+		Hitbox box;
+		do { box = Hitbox{ coord(rng), coord(rng), size(rng), size(rng) }; } while (findOverlap(box, obstacles));
+		return checkPath(box, randomMotion(rng), obstacles);
+	}
+
+	/**
+	 * @brief A hitbox that starts inside a tile sized block must be pushed out the shortest way, then move from there.
+	 *
+	 */
+	bool checkStartInside(std::mt19937& rng) {
+		std::uniform_real_distribution<float> size(4.f, 24.f);
+		std::uniform_int_distribution<int> tiles(1, 4);
+		std::uniform_int_distribution<int> still(0, 3);
+
+		Hitbox obstacle{ 512.f, 512.f, 16.f * tiles(rng), 16.f * tiles(rng) };
+		std::vector<Hitbox> obstacles{ obstacle };
+		Hitbox box{ 0, 0, size(rng), size(rng) };
+		std::uniform_real_distribution<float> x(obstacle.x - box.w + 1.f, obstacle.x + obstacle.w - 1.f);
+		std::uniform_real_distribution<float> y(obstacle.y - box.h + 1.f, obstacle.y + obstacle.h - 1.f);
+		box.x = x(rng);
+		box.y = y(rng);
+		Velocity2 motion = still(rng) ? randomMotion(rng) : Velocity2{ 0, 0 };
+
+		Hitbox pushed = depenetrate(box, obstacles);
+		float shortest = std::min({
+			box.x + box.w - obstacle.x, obstacle.x + obstacle.w - box.x,
+			box.y + box.h - obstacle.y, obstacle.y + obstacle.h - box.y
+		});
+		float distance = fabsf(pushed.x - box.x) + fabsf(pushed.y - box.y);
+		if (overlaps(pushed, obstacle) || (pushed.x != box.x && pushed.y != box.y) || fabsf(distance - shortest) > SWEEP_CONTACT_EPSILON) {
+			printf("a box inside an obstacle was not pushed out the shortest way\n");
+			printBox("box", box);
+			printBox("pushed", pushed);
+			printBox("obstacle", obstacle);
+			return false;
+		}
+
+		Hitbox result = sweepAndSlide(box, motion, obstacles);
+		Hitbox expected = sweepAndSlide(pushed, motion, obstacles);
+		if (result.x != expected.x || result.y != expected.y) {
+			printf("a box inside an obstacle did not move as if it started pushed out\n");
+			printBox("box", box);
+			printBox("result", result);
+			printBox("expected", expected);
+			return false;
+		}
+		return checkPath(pushed, motion, obstacles);
+	}
+
+	/**
+	 * @brief A box moving thousands of pixels in one frame must stop against a one pixel wall.
+	 *
+	 */
+	bool checkThinWall() {
+		std::vector<Hitbox> obstacles{ Hitbox{ 100.f, -50.f, 1.f, 100.f } };
+		for (float speed : { 1.f, 60.f, 600.f, 6000.f, 60000.f }) {
+			Hitbox box{ 50.f, 0.f, 16.f, 16.f };
+			SweepHit hit;
+			Hitbox result = sweepAndSlide(box, Velocity2{ speed, 0.f }, obstacles, &hit);
+			bool reaches = box.x + box.w + speed >= 100.f;
+			if (reaches && (hit.axis != 0 || result.x + result.w != 100.f)) {
+				printf("a box moving %g pixels ended at x %g instead of against the wall\n", speed, result.x);
+				return false;
+			}
+			if (!reaches && (hit.axis >= 0 || result.x != box.x + speed)) {
+				printf("a box moving %g pixels was stopped before the wall\n", speed);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+const char* const Check::NAME = "sweep_check";
+const std::size_t Check::DEFAULT_COUNT = 50;
+
+bool Check::run(const Args& args) {
+	if (!checkThinWall()) { return fail("the thin wall check"); }
+
+	std::size_t moves = 0;
+	for (unsigned i = 0; i < args.count; i++) {
+		std::mt19937 rng(args.seed + i);
+		std::vector<Hitbox> obstacles = randomObstacles(rng);
+		for (int j = 0; j < 200; j++, moves++) {
+			if (!checkMove(obstacles, rng)) { return fail("in round %u (seed %u)", i, args.seed + i); }
+		}
+		for (int j = 0; j < 50; j++, moves++) {
+			if (!checkStartInside(rng)) { return fail("in round %u (seed %u)", i, args.seed + i); }
+		}
+	}
+	printf("%zu rounds, %zu moves without tunneling\n", args.count, moves);
+	return true;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file TileCollisionBench.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Tile collision queries of the stress actors, by walking tiles against Tile::CollisionMask.
+ * @copyright Copyright (c) 2025
+ */
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include "BenchMaps.hpp"
+#include "tile/TileCollisionMask.hpp"
+
+using namespace Tile;
+using namespace Bench;
+
+/**
+ * @brief A stress map sized tile layer with collision rectangles, set up like Tile::MapScene::init does.
+ *
+ */
+struct CollisionMap {
+	std::vector<Tile::Tile> tiles;
+	std::vector<Hitbox> rects;
+	CollisionMask mask;
+};
+
+/**
+ * @brief Scatter `count` walls and blocks of one to four tiles over the stress map.
+ *
+ * @details
+ * A quarter of the rectangles are not aligned to the tiles, like the
+ * hand-placed ones of the real maps. 2500 rectangles cover about a fifth
+ * of the map, like the collision layers of `map01.json` and `map02.json`.
+ */
+static const CollisionMap& getCollisionMap(unsigned count) {
+	static std::vector<std::pair<unsigned, std::unique_ptr<CollisionMap>>> maps;
+	for (auto& [mapCount, map] : maps) {
+		if (mapCount == count) { return *map; }
+	}
+	CollisionMap& map = *maps.emplace_back(count, std::make_unique<CollisionMap>()).second;
+
+	std::mt19937 rng(3);
+	std::uniform_int_distribution<int> tile(0, STRESS_MAP_TILES - 5);
+	std::uniform_int_distribution<int> size(1, 4);
+	std::uniform_int_distribution<int> offset(0, 3);
+	map.tiles.assign(STRESS_MAP_TILES * STRESS_MAP_TILES, Tile::Tile{ 1 });
+	map.rects.push_back(Hitbox{ 0, 0, 0, 0 });
+	map.mask.reset(STRESS_MAP_TILES, STRESS_MAP_TILES, NORMAL_TILE_SIZE, 1);
+	for (unsigned i = 0; i < count; i++) {
+		Hitbox rect{
+			tile(rng) * NORMAL_TILE_SIZE, tile(rng) * NORMAL_TILE_SIZE,
+			size(rng) * NORMAL_TILE_SIZE, size(rng) * NORMAL_TILE_SIZE
+		};
+		if (i % 4 == 0) {
+			rect.x += 4 * offset(rng);
+			rect.w -= 4 * offset(rng);
+		}
+		CollisionId collision = (CollisionId)map.rects.size();
+		map.rects.push_back(rect);
+		map.mask.addRect(0, collision, rect);
+
+		unsigned tilex = rect.x / NORMAL_TILE_SIZE;
+		unsigned tiley = rect.y / NORMAL_TILE_SIZE;
+		unsigned tilew = ceilf(rect.w / NORMAL_TILE_SIZE);
+		unsigned tileh = ceilf(rect.h / NORMAL_TILE_SIZE);
+		for (unsigned y = 0; y < tileh; y++) {
+			for (unsigned x = 0; x < tilew; x++) {
+				map.tiles.at((tiley + y) * STRESS_MAP_TILES + tilex + x).collision = collision;
+			}
+		}
+	}
+	return map;
+}
+
+/**
+ * @brief The old Tile::MapScene::queryTileCollisions, writing into `out`.
+ *
+ * @details
+ * Kept out of line, like the member function was, so that it is not
+ * inlined into the benchmark loop when Tile::CollisionMask::query cannot be.
+ */
+[[gnu::noinline]] static void queryTiles(const CollisionMap& map, Hitbox rect, std::vector<Hitbox>& out) {
+	auto collides = [rect](const Hitbox other) {
+		return
+			rect.x + rect.w > other.x &&
+			rect.x < other.x + other.w &&
+			rect.y + rect.h > other.y &&
+			rect.y < other.y + other.h;
+	};
+	int tileIndex = (int)(rect.y / NORMAL_TILE_SIZE) * STRESS_MAP_TILES + (int)(rect.x / NORMAL_TILE_SIZE);
+	int width = (int)ceilf(rect.w / NORMAL_TILE_SIZE);
+	int height = (int)ceilf(rect.h / NORMAL_TILE_SIZE);
+
+	for (int i = 0; i <= height; i++) {
+		for (int j = 0; j <= width; j++) {
+			int index = tileIndex + (i * STRESS_MAP_TILES) + j;
+			if (index < 0 || index >= map.tiles.size()) { continue; }
+			CollisionId collision = map.tiles.at(index).collision;
+			if (!collision) { continue; }
+			Hitbox collisionRect = map.rects.at(collision);
+			if (collides(collisionRect)) {
+				out.push_back(collisionRect);
+			}
+		}
+	}
+}
+
+static void queryMask(const CollisionMap& map, Hitbox rect, std::vector<Hitbox>& out) {
+	map.mask.query(rect, 0, out);
+}
+
+/**
+ * @brief Query the tiles under every actor of a 1000 actor movement trace, on a map with `state.range(0)` rectangles.
+ *
+ * The hitboxes of the actors are scaled by `state.range(1)`, so that bigger boxes,
+ * like the search box of Tile::MapInput or a large NPC, are measured too.
+ * @details
+ * Fails if the last rectangle found for a box, which is the one
+ * Tile::MapMovement resolves against, differs from the old query's.
+ */
+template<void (*Query)(const CollisionMap&, Hitbox, std::vector<Hitbox>&)>
+static void BM_TileCollisionQuery(benchmark::State& state) {
+	const CollisionMap& map = getCollisionMap(state.range(0));
+	MovementTrace trace = makeMovementTrace(1000);
+	for (auto& frame : trace.frames) {
+		for (Hitbox& box : frame) {
+			box.w *= state.range(1);
+			box.h *= state.range(1);
+		}
+	}
+	std::vector<Hitbox> out;
+	std::vector<Hitbox> expected;
+	for (const auto& frame : trace.frames) {
+		for (const Hitbox& box : frame) {
+			out.clear();
+			expected.clear();
+			Query(map, box, out);
+			queryTiles(map, box, expected);
+			if (out.empty() != expected.empty() || (!out.empty() && memcmp(&out.back(), &expected.back(), sizeof(Hitbox)))) {
+				state.SkipWithError("Query results differ from the old query");
+				return;
+			}
+		}
+	}
+
+	std::size_t hits = 0;
+	for (auto _ : state) {
+		hits = 0;
+		for (const auto& frame : trace.frames) {
+			for (const Hitbox& box : frame) {
+				out.clear();
+				Query(map, box, out);
+				hits += out.size();
+			}
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.counters["hits/frame"] = (double)hits / TRACE_FRAMES;
+	state.counters["query"] = benchmark::Counter((double)TRACE_FRAMES * trace.layer.size(), benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+BENCHMARK_TEMPLATE(BM_TileCollisionQuery, queryTiles)->ArgsProduct({ { 500, 2500 }, { 1, 4 } })->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_TileCollisionQuery, queryMask)->ArgsProduct({ { 500, 2500 }, { 1, 4 } })->Unit(benchmark::kMicrosecond);
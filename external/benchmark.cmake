@@ -0,0 +1,14 @@
+# Download Google Benchmark
+set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+FetchContent_Declare(
+    benchmark
+    PREFIX "external/benchmark"
+    GIT_REPOSITORY "https://github.com/google/benchmark.git"
+    GIT_TAG v1.9.1
+    TIMEOUT 10
+)
+
+FetchContent_MakeAvailable(benchmark)
\ No newline at end of file
@@ -0,0 +1,106 @@
+/**
+ * @file Broadphase.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief @copybrief Broadphase
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "Components.hpp"
+#include "ECS.hpp"
+
+/**
+ * @brief Interface of a structure that finds which hitboxes could collide with a box.
+ *
+ * @details
+ * Each entity can have at most one hitbox in the structure.
+ *
+ * @sa QuadTree, SpatialGrid
+ */
+class Broadphase {
+public:
+	/**
+	 * @brief The kinds of Broadphase.
+	 *
+	 */
+	enum Type {
+		QuadTreeType,
+		SpatialGridType
+	};
+
+	virtual ~Broadphase() = default;
+
+	/**
+	 * @brief Insert the hitbox of an entity.
+	 *
+	 * @param box Hitbox of the entity
+	 * @param e Handle of the entity
+	 */
+	virtual void insert(Hitbox box, ECS::handle e) = 0;
+
+	/**
+	 * @brief Query for collisions.
+	 *
+	 * @param box Hitbox of the entity
+	 * @param e The id of the entity (collisions with itself will be ignored)
+	 * @param out A vector of Hitboxes that collide with the entity
+	 */
+	virtual void query(Hitbox box, ECS::entity e, std::vector<Hitbox>& out) const = 0;
+
+	/**
+	 * @brief Query for collisions.
+	 *
+	 * @param box Hitbox of the entity
+	 * @param e The id of the entity (collisions with itself will be ignored)
+	 * @param out A vector of handles of entities with a hitbox that collides with the entity.
+	 * The entities may have been freed since they were inserted, see GRY_ECS::isAlive.
+	 */
+	virtual void query(Hitbox box, ECS::entity e, std::vector<ECS::handle>& out) const = 0;
+
+	/**
+	 * @brief Move the hitbox of an entity.
+	 *
+	 * @details
+	 * Nothing happens if the entity is not in the structure.
+	 *
+	 * @param box The new box's data
+	 * @param e Entity associated with the box
+	 * @return `true` if the box had to be relocated within the structure, `false` otherwise.
+	 */
+	virtual bool update(Hitbox box, ECS::entity e) = 0;
+
+	/**
+	 * @brief Check if an entity has a hitbox in the structure.
+	 *
+	 * @param e The entity.
+	 * @return `true` if it does, `false` otherwise.
+	 */
+	virtual bool contains(ECS::entity e) const = 0;
+
+	/**
+	 * @brief Remove every hitbox, keeping the memory for later inserts.
+	 *
+	 */
+	virtual void reset() = 0;
+
+	/**
+	 * @brief Reorganize the memory of the structure after a batch of inserts or updates.
+	 *
+	 */
+	virtual void compact() {}
+
+	/**
+	 * @brief Check if the structure has not been changed since it was last compacted.
+	 *
+	 * @return `true` if it has not, `false` otherwise.
+	 */
+	virtual const bool isCompacted() const { return true; }
+
+	/**
+	 * @brief Get the number of nodes or cells in use.
+	 *
+	 * @return The node count.
+	 */
+	virtual const std::size_t nodeCount() const = 0;
+};
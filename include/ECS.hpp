@@ -6,31 +6,87 @@
  */
 #pragma once
 #include <stdint.h>
+#include <limits>
 #include "SparseSet.hpp"
 
+/**
+ * @brief Refers to an entity, along with the generation of its identifier.
+ *
+ * @details
+ * Every time an entity is freed, the generation of its identifier goes up,
+ * so a handle kept from before can be told apart from the entity that reuses it.
+ * See GRY_ECS::getHandle and GRY_ECS::isAlive.
+ *
+ * Map data only refers to entities by identifier. Handles made from those are the
+ * first generation, which is the generation of every entity when a map is loaded.
+ *
+ * @tparam entity Identifier type of the ECS.
+ */
+template<typename entity>
+struct EntityHandle {
+    /**
+     * @brief Identifier used to lookup component data.
+     *
+     */
+    entity index;
+
+    /**
+     * @brief Number of times `index` had been freed when the handle was made.
+     *
+     * @details
+     * An entity is retired before its generation can wrap around, see GRY_ECS::RETIRED_GENERATION.
+     */
+    uint16_t generation;
+
+    EntityHandle() = default;
+    constexpr explicit EntityHandle(entity index, uint16_t generation = 0) : index(index), generation(generation) {}
+
+    constexpr bool operator==(const EntityHandle&) const = default;
+};
+
 namespace ECS {
     /**
-     * @brief Identifier to retrieve component data.
-     * 
+     * @brief Default identifier to retrieve component data.
+     *
      * @details
      * Must be an unsigned integral type.
+     * A GRY_ECS can use a different type, see GRY_ECS.
      */
-    using entity = uint8_t;
+    using entity = uint16_t;
 
     /**
-     * @brief Maximum number of entities the ECS will manage.
-     * 
+     * @brief Default maximum number of entities the ECS will manage.
+     *
      * @details
      * This number does not include `ECS::NONE`.
      */
-    const uint8_t MAX_ENTITIES = 255;
-    
+    const entity MAX_ENTITIES = std::numeric_limits<entity>::max();
+
     /**
      * @brief Represents the absence of an entity.
-     * 
+     *
      */
     const entity NONE = MAX_ENTITIES;
+
+    /**
+     * @brief Handle type of the default entity type.
+     *
+     */
+    using handle = EntityHandle<entity>;
+
+    /**
+     * @brief Handle that refers to `ECS::NONE`.
+     *
+     */
+    constexpr handle NONE_HANDLE{ NONE };
 }
 
-template<typename T>
-using ComponentSet = SparseSet<T, ECS::entity, ECS::MAX_ENTITIES>;
\ No newline at end of file
+/**
+ * @brief SparseSet used by a GRY_ECS to store one type of component.
+ *
+ * @tparam T Type of the component data.
+ * @tparam entity Type of the identifier to use. Defaults to `ECS::entity`.
+ * @tparam SIZE Maximum number of entities. Defaults to `ECS::MAX_ENTITIES`.
+ */
+template<typename T, typename entity = ECS::entity, entity SIZE = ECS::MAX_ENTITIES>
+using ComponentSet = SparseSet<T, entity, SIZE>;
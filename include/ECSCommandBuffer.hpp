@@ -0,0 +1,175 @@
+/**
+ * @file ECSCommandBuffer.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief @copybrief ECSCommandBuffer
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include "ECS.hpp"
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+/**
+ * @brief Records structural changes to a GRY_ECS so they can be applied later, all at once.
+ *
+ * @details
+ * Adding or removing components, or freeing an entity, rearranges the dense
+ * arrays of the ComponentSets. Systems that do this while iterating a set
+ * should record the change here instead, and let the owner of the ECS
+ * apply it at a point where nothing is iterating, see GRY_ECS::applyCommands.
+ *
+ * Changes are applied grouped by kind: additions, then removals, then frees.
+ * Removals and frees are applied in bulk, one compaction per ComponentSet.
+ *
+ * @tparam entity Identifier type of the ECS.
+ * @tparam Ts Component types of the ECS.
+ */
+template<typename entity, class... Ts>
+class ECSCommandBuffer {
+public:
+	using Handle = EntityHandle<entity>;
+
+	/**
+	 * @brief Record that `e` should get the component `data`.
+	 *
+	 * @details
+	 * If `e` already has a component of type `T` when the buffer is
+	 * applied, it is overwritten.
+	 *
+	 * @tparam T Type of the component.
+	 * @param e Handle of the entity.
+	 * @param data Component data.
+	 */
+	template<class T>
+	void add(Handle e, const T& data) { std::get<Additions<T>>(additions).entries.push_back({ e, data }); }
+
+	/**
+	 * @brief Record that `e` should lose its component of type `T`.
+	 *
+	 * @details
+	 * Nothing happens if `e` does not have the component when the buffer is applied.
+	 *
+	 * @tparam T Type of the component.
+	 * @param e Handle of the entity.
+	 */
+	template<class T>
+	void remove(Handle e) { std::get<Removals<T>>(removals).entries.push_back(e); }
+
+	/**
+	 * @brief Record that `e` should be freed.
+	 *
+	 * @details
+	 * Freeing the same entity more than once in a frame only frees it once.
+	 *
+	 * @param e Handle of the entity.
+	 */
+	void free(Handle e) { frees.push_back(e); }
+
+	/**
+	 * @brief Check if there are no recorded changes.
+	 *
+	 * @return `true` if the buffer is empty, `false` otherwise.
+	 */
+	const bool empty() const {
+		return frees.empty() &&
+			std::apply([](const auto&... lists) { return (lists.entries.empty() && ...); }, additions) &&
+			std::apply([](const auto&... lists) { return (lists.entries.empty() && ...); }, removals);
+	}
+
+	/**
+	 * @brief Apply the recorded changes to `ecs`, then clear them.
+	 *
+	 * @details
+	 * Changes to entities that were freed after they were recorded are skipped.
+	 *
+	 * @tparam ECSType GRY_ECS that has the component types `Ts`.
+	 * @param ecs ECS to change.
+	 * @return Number of entities that were freed.
+	 */
+	template<class ECSType>
+	std::size_t apply(ECSType& ecs) {
+		std::apply([&ecs](auto&... lists) { (applyAdditions(ecs, lists), ...); }, additions);
+		std::apply([this, &ecs](auto&... lists) { (applyRemovals(ecs, lists), ...); }, removals);
+		if (frees.empty()) { return 0; }
+		collectAlive(ecs, frees);
+		std::sort(alive.begin(), alive.end());
+		alive.erase(std::unique(alive.begin(), alive.end()), alive.end());
+		ecs.freeEntities(alive.begin(), alive.end());
+		frees.clear();
+		return alive.size();
+	}
+
+private:
+	/**
+	 * @brief Recorded additions of one component type.
+	 *
+	 */
+	template<class T>
+	struct Additions { std::vector<std::pair<Handle, T>> entries; };
+
+	/**
+	 * @brief Recorded removals of one component type.
+	 *
+	 */
+	template<class T>
+	struct Removals { std::vector<Handle> entries; };
+
+	template<class ECSType, class T>
+	static void applyAdditions(ECSType& ecs, Additions<T>& list) {
+		auto& set = ecs.template getComponent<T>();
+		for (auto& [e, data] : list.entries) {
+			if (!ecs.isAlive(e)) { continue; }
+			if (set.contains(e.index)) { set.get(e.index) = std::move(data); }
+			else { set.add(e.index, std::move(data)); }
+		}
+		list.entries.clear();
+	}
+
+	template<class ECSType, class T>
+	void applyRemovals(ECSType& ecs, Removals<T>& list) {
+		if (list.entries.empty()) { return; }
+		collectAlive(ecs, list.entries);
+		ecs.template getComponent<T>().removeRange(alive.begin(), alive.end());
+		list.entries.clear();
+	}
+
+	/**
+	 * @brief Fill `alive` with the entities of the handles that are still alive.
+	 *
+	 */
+	template<class ECSType>
+	void collectAlive(const ECSType& ecs, const std::vector<Handle>& handles) {
+		alive.clear();
+		for (Handle e : handles) {
+			if (ecs.isAlive(e)) { alive.push_back(e.index); }
+		}
+	}
+
+	/**
+	 * @brief Recorded additions, one list per component type.
+	 *
+	 */
+	std::tuple<Additions<Ts>...> additions;
+
+	/**
+	 * @brief Recorded removals, one list per component type.
+	 *
+	 */
+	std::tuple<Removals<Ts>...> removals;
+
+	/**
+	 * @brief Recorded frees.
+	 *
+	 */
+	std::vector<Handle> frees;
+
+	/**
+	 * @brief Scratch space for the entities of removals and frees that are still alive.
+	 *
+	 * @details
+	 * Kept between applies, so applying does not allocate once it is big enough.
+	 */
+	std::vector<entity> alive;
+};
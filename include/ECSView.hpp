@@ -0,0 +1,216 @@
+/**
+ * @file ECSView.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Multi-component iteration over the ComponentSets of a GRY_ECS.
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include "SparseSet.hpp"
+#include <tuple>
+#include <array>
+
+/**
+ * @brief Iterates the entities that have every component in `Ts`.
+ *
+ * @details
+ * Iteration is driven by whichever of the ComponentSets is the smallest
+ * when the view is created, and the other sets are only checked with `contains()`.
+ *
+ * A view is cheap to create, and only holds pointers to the ComponentSets.
+ * Adding or removing components of the viewed types while iterating is not allowed.
+ *
+ * @tparam entity Identifier type of the ECS.
+ * @tparam SIZE Maximum number of entities of the ECS.
+ * @tparam Ts Component types to iterate.
+ *
+ * @sa GRY_ECS::view
+ */
+template<typename entity, entity SIZE, class... Ts>
+class ECSView {
+public:
+	/**
+	 * @brief Constructor.
+	 *
+	 * @param sets The ComponentSets of each type in `Ts`.
+	 */
+	ECSView(SparseSet<Ts, entity, SIZE>&... sets) : sets(&sets...) {
+		std::array<const entity*, sizeof...(Ts)> begins{ sets.begin()... };
+		std::array<std::size_t, sizeof...(Ts)> sizes{ sets.size()... };
+		std::size_t smallest = 0;
+		for (std::size_t i = 1; i < sizeof...(Ts); i++) {
+			if (sizes[i] < sizes[smallest]) { smallest = i; }
+		}
+		first = begins[smallest];
+		last = first + sizes[smallest];
+	}
+
+	/**
+	 * @brief Check if `e` has every component in the view.
+	 *
+	 * @param e Entity to check.
+	 * @return `true` if `e` would be visited by the view, `false` otherwise.
+	 */
+	const bool contains(entity e) const {
+		return std::apply([e](const auto*... sets) { return (sets->contains(e) && ...); }, sets);
+	}
+
+	/**
+	 * @brief Get the component `T` of `e`.
+	 *
+	 * @tparam T One of the types in `Ts`.
+	 * @param e Entity in the view.
+	 * @return Reference to the component data.
+	 */
+	template<class T>
+	T& get(entity e) { return std::get<SparseSet<T, entity, SIZE>*>(sets)->get(e); }
+
+	/**
+	 * @brief Call `func(e, Ts&...)` for every entity in the view.
+	 *
+	 * @tparam Func Callable type.
+	 * @param func Function to call.
+	 */
+	template<class Func>
+	void each(Func func) {
+		for (const entity* it = first; it != last; it++) {
+			const entity e = *it;
+			if (!contains(e)) { continue; }
+			std::apply([&](auto*... sets) { func(e, sets->get(e)...); }, sets);
+		}
+	}
+
+private:
+	/**
+	 * @brief Pointers to the ComponentSets.
+	 *
+	 */
+	std::tuple<SparseSet<Ts, entity, SIZE>*...> sets;
+
+	/**
+	 * @brief First entity of the smallest ComponentSet.
+	 *
+	 */
+	const entity* first;
+
+	/**
+	 * @brief One past the last entity of the smallest ComponentSet.
+	 *
+	 */
+	const entity* last;
+};
+
+/**
+ * @brief Keeps the entities that have every component in `Ts` packed at the
+ * front of each of those ComponentSets, in the same order.
+ *
+ * @details
+ * The group "owns" its ComponentSets: after `refresh()`, index `i` of the
+ * dense array of every owned set belongs to the same entity for each
+ * `i < size()`, so the group can be iterated over contiguous memory
+ * without any sparse lookups.
+ *
+ * The group only packs the sets again when components have been added
+ * to or removed from them since the last refresh. A ComponentSet should
+ * only be owned by one set of types, or the groups will undo each other.
+ *
+ * @tparam entity Identifier type of the ECS.
+ * @tparam SIZE Maximum number of entities of the ECS.
+ * @tparam Ts Component types owned by the group.
+ *
+ * @sa GRY_ECS::group
+ */
+template<typename entity, entity SIZE, class... Ts>
+class ECSGroup {
+public:
+	/**
+	 * @brief Constructor.
+	 *
+	 * @param sets The ComponentSets of each type in `Ts`.
+	 */
+	ECSGroup(SparseSet<Ts, entity, SIZE>&... sets) : sets(&sets...) { refresh(); }
+
+	/**
+	 * @brief Pack the owned ComponentSets, if they have changed.
+	 *
+	 */
+	void refresh() {
+		std::array<std::size_t, sizeof...(Ts)> current = std::apply(
+			[](const auto*... sets) { return std::array<std::size_t, sizeof...(Ts)>{ sets->getVersion()... }; },
+			sets
+		);
+		if (current == versions) { return; }
+		versions = current;
+
+		ECSView<entity, SIZE, Ts...> view = std::apply(
+			[](auto*... sets) { return ECSView<entity, SIZE, Ts...>(*sets...); },
+			sets
+		);
+		count = 0;
+		view.each([this](entity e, Ts&...) {
+			std::apply([this, e](auto*... sets) { (sets->swapDense(sets->indexOf(e), count), ...); }, sets);
+			count++;
+		});
+	}
+
+	/**
+	 * @brief Number of entities in the group, as of the last refresh.
+	 *
+	 * @return The size.
+	 */
+	const std::size_t size() const { return count; }
+
+	/**
+	 * @brief Get the entity at `i` in the group.
+	 *
+	 * @param i Index less than `size()`.
+	 * @return The entity.
+	 */
+	const entity getEntity(std::size_t i) const { return std::get<0>(sets)->getEntity(i); }
+
+	/**
+	 * @brief Get the component `T` at `i` in the group.
+	 *
+	 * @tparam T One of the types in `Ts`.
+	 * @param i Index less than `size()`.
+	 * @return Reference to the component data.
+	 */
+	template<class T>
+	T& get(std::size_t i) { return std::get<SparseSet<T, entity, SIZE>*>(sets)->value[i]; }
+
+	/**
+	 * @brief Refresh, then call `func(e, Ts&...)` for every entity in the group.
+	 *
+	 * @details
+	 * Components of the owned types must not be added or removed during iteration.
+	 *
+	 * @tparam Func Callable type.
+	 * @param func Function to call.
+	 */
+	template<class Func>
+	void each(Func func) {
+		refresh();
+		for (std::size_t i = 0; i < count; i++) {
+			std::apply([&](auto*... sets) { func(getEntity(i), sets->value[i]...); }, sets);
+		}
+	}
+
+private:
+	/**
+	 * @brief Pointers to the owned ComponentSets.
+	 *
+	 */
+	std::tuple<SparseSet<Ts, entity, SIZE>*...> sets;
+
+	/**
+	 * @brief Versions of the owned ComponentSets at the last refresh.
+	 *
+	 * @sa SparseSet::getVersion
+	 */
+	std::array<std::size_t, sizeof...(Ts)> versions{};
+
+	/**
+	 * @brief Number of entities in the group.
+	 *
+	 */
+	std::size_t count = 0;
+};
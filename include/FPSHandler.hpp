@@ -67,7 +67,43 @@ private:
 	 * Retrieved using `SDL_GetTicks()`.
 	 */
 	Uint64 msStart = 0;
+
+	/**
+	 * @brief Length of a simulation tick, in seconds.
+	 * 
+	 * @details
+	 * Initialized to `1.0 / DEFAULT_TICK_RATE`.
+	 */
+	double tickLength;
+
+	/**
+	 * @brief Time that has passed but has not been simulated yet, in seconds.
+	 * 
+	 */
+	double accumulator = 0.0;
+
+	/**
+	 * @brief Length of the last frame in seconds, without the clamping of `deltaTime`.
+	 * 
+	 */
+	double frameTime = 0.0;
+
+	/**
+	 * @brief Maximum time a single frame can add to the accumulator, in seconds.
+	 * 
+	 * @details
+	 * After a long stall, such as loading or moving the window, the game
+	 * catches up on at most this much time instead of running a burst of ticks
+	 * that would make the next frame even slower.
+	 */
+	const double maxFrameTime = 0.25;
 public:
+	/**
+	 * @brief Simulation ticks per second used until `setTickRate` is called.
+	 * 
+	 */
+	static const unsigned int DEFAULT_TICK_RATE = 60;
+
 	/**
 	 * @brief Constructor.
 	 * 
@@ -84,6 +120,9 @@ public:
 	/**
 	 * @brief Determine the time it took to process since the last call to `frameStart()`.
 	 *
+	 * @details
+	 * Also adds that time to the time waiting to be simulated by `tick()`.
+	 *
 	 * @returns The delta time in seconds.
 	 * 
 	 * @sa getDelta
@@ -91,6 +130,23 @@ public:
 	 */
 	void computeDelta();
 
+	/**
+	 * @brief End the frame as if `elapsed` seconds had passed since it started.
+	 * 
+	 * @details
+	 * Used by `computeDelta`, and to replay recorded frame lengths exactly.
+	 * 
+	 * @param elapsed Length of the frame in seconds.
+	 */
+	void advance(double elapsed);
+
+	/**
+	 * @brief Get the length of the last frame before it was clamped.
+	 * 
+	 * @return Frame length in seconds.
+	 */
+	double getFrameTime() const { return frameTime; }
+
 	/**
 	 * @brief Stall the program relative to the current frame's process time and `frameLength`.
 	 * 
@@ -100,6 +156,10 @@ public:
 	/**
 	 * @brief Get the delta time.
 	 * 
+	 * @details
+	 * This is the length of the last frame, for things that update once per frame.
+	 * The simulation should use `getTickLength()` instead.
+	 * 
 	 * @return Delta time in seconds.
 	 * 
 	 * @sa computeDelta
@@ -115,4 +175,44 @@ public:
 	 * @sa getDelta
 	 */
 	double getFPS() { return 1.0 / deltaTime; }
+
+	/**
+	 * @brief Set how many simulation ticks run per second.
+	 * 
+	 * @param ticksPerSecond Number of ticks per second, greater than 0.
+	 */
+	void setTickRate(unsigned int ticksPerSecond);
+
+	/**
+	 * @brief Take one tick off of the accumulated time, if a whole tick has accumulated.
+	 * 
+	 * @details
+	 * Meant to be called in a loop each frame, running one simulation
+	 * tick every time it returns `true`.
+	 * 
+	 * @return `true` if a tick should be run.
+	 * @return `false` otherwise.
+	 * 
+	 * @sa getInterpolation
+	 */
+	bool tick();
+
+	/**
+	 * @brief Get the length of a simulation tick.
+	 * 
+	 * @return Tick length in seconds.
+	 */
+	double getTickLength() const { return tickLength; }
+
+	/**
+	 * @brief Get how far the current frame is between the last two simulation ticks.
+	 * 
+	 * @details
+	 * Once `tick()` has returned `false`, this is the fraction of a tick that is
+	 * left in the accumulator, so rendering can blend the previous simulation
+	 * state towards the latest one by this amount.
+	 * 
+	 * @return A value from 0 to 1.
+	 */
+	float getInterpolation() const { return (float)(accumulator / tickLength); }
 };
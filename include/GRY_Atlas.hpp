@@ -0,0 +1,168 @@
+/**
+ * @file GRY_Atlas.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief @copybrief GRY_Atlas
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include "SDL3/SDL_rect.h"
+#include <vector>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+struct GRY_Texture;
+
+/**
+ * @brief Packs the textures of loaded resources into a few large pages, so that drawing from different resources does not switch textures.
+ *
+ * @details
+ * Resources are added with `add`, then `build` copies their textures into
+ * the pages. Each resource is then changed to use its page: its texture
+ * pointer is replaced, its source rects are moved to where its image
+ * landed, and it stops owning a texture. The original textures are
+ * destroyed, and the atlas owns the pages, so it has to outlive the
+ * resources' use.
+ *
+ * The pages are drawn with a render target and then read back into
+ * ordinary textures, so they keep their contents if the renderer loses
+ * its render targets.
+ *
+ * Textures larger than a page are left as they are.
+ */
+class GRY_Atlas {
+public:
+	/**
+	 * @brief Largest width and height of a page, in pixels. Smaller if the renderer does not support it.
+	 *
+	 */
+	static const int MAX_PAGE_SIZE = 2048;
+
+	/**
+	 * @brief Empty pixels between two images on a page.
+	 *
+	 */
+	static const int PADDING = 1;
+
+private:
+	/**
+	 * @brief A resource waiting to be packed.
+	 *
+	 */
+	struct Entry {
+		/**
+		 * @brief The resource's texture pointer.
+		 *
+		 */
+		SDL_Texture** texture;
+
+		/**
+		 * @brief Whether the resource destroys its texture.
+		 *
+		 */
+		bool* ownsTexture;
+
+		/**
+		 * @brief Source rects of the resource.
+		 *
+		 */
+		SDL_FRect* rects;
+
+		/**
+		 * @brief Number of source rects.
+		 *
+		 */
+		std::size_t rectCount;
+
+		/**
+		 * @brief Size of the texture, in pixels.
+		 *
+		 */
+		int w = 0, h = 0;
+
+		/**
+		 * @brief Where the texture goes, in pixels, and on which page. `page` is -1 if it is not packed.
+		 *
+		 */
+		int x = 0, y = 0, page = -1;
+	};
+
+	/**
+	 * @brief Resources added since the last `build`.
+	 *
+	 */
+	std::vector<Entry> entries;
+
+	/**
+	 * @brief Pages owned by the atlas.
+	 *
+	 */
+	std::vector<SDL_Texture*> pages;
+
+	/**
+	 * @brief Choose the page and position of each entry.
+	 *
+	 * @param pageSize Width and height of a page.
+	 * @return Used width and height of each page.
+	 */
+	std::vector<SDL_Point> pack(int pageSize);
+
+	/**
+	 * @brief Copy the textures of the entries on a page into one texture.
+	 *
+	 * @param renderer Renderer to draw with.
+	 * @param page Index of the page.
+	 * @param size Width and height of the page.
+	 * @return The page texture, or `nullptr` if it could not be made.
+	 */
+	SDL_Texture* drawPage(SDL_Renderer* renderer, int page, SDL_Point size);
+
+public:
+	/**
+	 * @brief Constructor.
+	 *
+	 */
+	GRY_Atlas() = default;
+
+	/**
+	 * @brief Destructor. Destroys the pages.
+	 *
+	 */
+	~GRY_Atlas();
+
+	GRY_Atlas(const GRY_Atlas&) = delete;
+	GRY_Atlas& operator=(const GRY_Atlas&) = delete;
+
+	/**
+	 * @brief Add a resource with source rects to pack.
+	 *
+	 * @details
+	 * The rects must stay where they are until `build`. Resources that do
+	 * not own their texture, such as ones already in an atlas, are skipped.
+	 *
+	 * @param texture The resource's texture pointer.
+	 * @param ownsTexture Whether the resource destroys its texture.
+	 * @param sourceRects Source rects of the resource.
+	 */
+	void add(SDL_Texture*& texture, bool& ownsTexture, std::vector<SDL_FRect>& sourceRects);
+
+	/**
+	 * @brief Add a GRY_Texture to pack.
+	 *
+	 * @param texture The GRY_Texture, drawn using its `area`.
+	 */
+	void add(GRY_Texture& texture);
+
+	/**
+	 * @brief Pack the added resources into pages and change them to use the pages.
+	 *
+	 * @param renderer Renderer the textures were made with.
+	 */
+	void build(SDL_Renderer* renderer);
+
+	/**
+	 * @brief Get the number of pages.
+	 *
+	 * @return The number of pages.
+	 */
+	std::size_t getPageCount() const { return pages.size(); }
+};
@@ -7,7 +7,12 @@ class GRY_Audio {
 private:
 	FMOD_SYSTEM* system = nullptr;
 public:
-	GRY_Audio();
+	/**
+	 * @brief Constructor.
+	 * 
+	 * @param silent If `true`, sounds are loaded and played without any audio output.
+	 */
+	GRY_Audio(bool silent = false);
 
 	~GRY_Audio();
 
@@ -6,21 +6,61 @@
  */
 #pragma once
 #include "ECS.hpp"
+#include "ECSView.hpp"
+#include "ECSCommandBuffer.hpp"
 #include <tuple>
+#include <array>
+#include <algorithm>
 
 /**
  * @brief Database-like structure that manages entities and components.
  * 
  * @details
  * Stores all component data, and keeps track of which entities are being used.
- * The number of active entities cannot exceed `ECS::MAX_ENTITIES`.
+ * The number of active entities cannot exceed `capacity`, which itself
+ * cannot exceed `MAX_ENTITIES`.
  * 
+ * @tparam Entity Identifier type, e.g. `uint16_t` or `uint32_t`. Must be unsigned integral type.
+ * @tparam MAX_ENTITIES Maximum number of entities. Also the value of the "NONE" entity.
  * @tparam Ts List of component data types.
  */
-template<class... Ts>
+template<typename Entity, Entity MAX_ENTITIES, class... Ts>
 struct GRY_ECS {
-	using TupleType = std::tuple<ComponentSet<Ts>...>;
-	using entity = ECS::entity;
+	using entity = Entity;
+
+	/**
+	 * @brief Handle type that can detect if its entity was freed, see isAlive.
+	 * 
+	 */
+	using Handle = EntityHandle<entity>;
+
+	/**
+	 * @brief ComponentSet type that stores components of type `T` for this ECS.
+	 * 
+	 * @tparam T Type of the component data.
+	 */
+	template<typename T>
+	using Set = ComponentSet<T, entity, MAX_ENTITIES>;
+
+	using TupleType = std::tuple<Set<Ts>...>;
+
+	using CommandBuffer = ECSCommandBuffer<entity, Ts...>;
+
+	/**
+	 * @brief Represents the absence of an entity.
+	 * 
+	 */
+	static constexpr entity NONE = MAX_ENTITIES;
+
+	/**
+	 * @brief Generation at which an entity is retired instead of reused.
+	 * 
+	 * @details
+	 * Generations would wrap around after this many frees, and a handle made
+	 * before the wrap would come alive again. So an entity freed this many
+	 * times is never created again, and the ECS can hold one fewer entity.
+	 */
+	static constexpr uint16_t RETIRED_GENERATION = std::numeric_limits<uint16_t>::max();
 
 	/**
 	 * @brief Collection of all ComponentSets, one for each component type.
@@ -46,7 +86,7 @@ struct GRY_ECS {
 	 * @sa getComponentReadOnly
 	 */
 	template<typename T>
-	ComponentSet<T>& getComponent() { return std::get<ComponentSet<T>>(components); }
+	Set<T>& getComponent() { return std::get<Set<T>>(components); }
 
 	/**
 	 * @copybrief getComponent
@@ -57,44 +97,171 @@ struct GRY_ECS {
 	 * @sa getComponent
 	 */
 	template<typename T>
-	const ComponentSet<T>& getComponentReadOnly() const { return std::get<ComponentSet<T>>(components); }
+	const Set<T>& getComponentReadOnly() const { return std::get<Set<T>>(components); }
+
+	/**
+	 * @brief Create a view of the entities that have every component in `Cs`.
+	 * 
+	 * @tparam Cs Component types to iterate.
+	 * @return The view.
+	 * 
+	 * @sa ECSView
+	 */
+	template<class... Cs>
+	ECSView<entity, MAX_ENTITIES, Cs...> view() { return ECSView<entity, MAX_ENTITIES, Cs...>(getComponent<Cs>()...); }
+
+	/**
+	 * @brief Create a group that keeps the components in `Cs` packed together.
+	 * 
+	 * @tparam Cs Component types owned by the group.
+	 * @return The group.
+	 * 
+	 * @sa ECSGroup
+	 */
+	template<class... Cs>
+	ECSGroup<entity, MAX_ENTITIES, Cs...> group() { return ECSGroup<entity, MAX_ENTITIES, Cs...>(getComponent<Cs>()...); }
+
+	/**
+	 * @brief Get the number of entities that can be in use at once.
+	 * 
+	 * @return The capacity.
+	 */
+	const entity getCapacity() const { return capacity; }
+
+	/**
+	 * @brief Set the number of entities that can be in use at once.
+	 * 
+	 * @details
+	 * The sparse page tables of every ComponentSet are grown to fit `count`
+	 * entities, so they do not reallocate while systems are running.
+	 * 
+	 * Logs an error if `count` is greater than `MAX_ENTITIES`, or less than
+	 * the number of entities that have already been created.
+	 * 
+	 * @param count Number of entities to allow.
+	 */
+	void setCapacity(std::size_t count) {
+		GRY_Assert(count <= MAX_ENTITIES,
+			"[GRY_ECS] Requested capacity (%zu) is over the maximum number of entities (%zu).\n",
+			count, (std::size_t)MAX_ENTITIES
+		);
+		GRY_Assert(count >= back,
+			"[GRY_ECS] Requested capacity (%zu) is less than the number of created entities (%zu).\n",
+			count, (std::size_t)back
+		);
+		capacity = (entity)std::clamp<std::size_t>(count, back, MAX_ENTITIES);
+		std::apply([this](auto&... sets) { (sets.reserve(capacity), ...); }, components);
+	}
+
+	/**
+	 * @brief Get the memory used by each ComponentSet.
+	 * 
+	 * @return The memory used, in the same order as `Ts`.
+	 * 
+	 * @sa SparseSet::memoryUsage
+	 */
+	const std::array<SparseSetMemory, sizeof...(Ts)> memoryUsage() const {
+		return std::apply([](const auto&... sets) {
+			return std::array<SparseSetMemory, sizeof...(Ts)>{ sets.memoryUsage()... };
+		}, components);
+	}
+
+	/**
+	 * @brief Get the memory used by all ComponentSets combined.
+	 * 
+	 * @return The total memory used.
+	 */
+	const SparseSetMemory totalMemoryUsage() const {
+		SparseSetMemory total;
+		for (const SparseSetMemory& memory : memoryUsage()) { total += memory; }
+		return total;
+	}
 
 	/**
 	 * @brief Create an entity that is not in use.
 	 * 
 	 * @details
-	 * Logs an error and returns `ECS::NONE` if the number of existing
+	 * Logs an error and returns `NONE` if the number of existing
 	 * entities has reached its limit.
 	 * 
 	 * @return An entity that can be used to lookup component data.
 	 */
     const entity createEntity() {
 		entity e;
-		if (back < ECS::MAX_ENTITIES) { e = back++; }
+		if (back < capacity) {
+			e = back++;
+			generations.push_back(0);
+		}
 		else if (deadEntities.size() > 0) {
 			e = deadEntities.back();
 			deadEntities.pop_back();
 		}
 		else {
-			e = ECS::NONE;
+			e = NONE;
 			GRY_Log("[EntityManager] Tried to get a new entity, but there are none left to give.\n");
 		}
 		return e;
 	}
 
+	/**
+	 * @brief Get the buffer that records changes to apply later, see applyCommands.
+	 * 
+	 * @details
+	 * Systems should record additions, removals and frees here while they
+	 * iterate ComponentSets. createEntity does not touch the ComponentSets,
+	 * so it is safe to call directly.
+	 * 
+	 * @return Reference to the CommandBuffer.
+	 */
+	CommandBuffer& getCommands() { return commands; }
+
+	/**
+	 * @brief Apply and clear the changes recorded with getCommands.
+	 * 
+	 * @details
+	 * Must not be called while any ComponentSet is being iterated.
+	 * 
+	 * @return Number of entities that were freed.
+	 */
+	std::size_t applyCommands() {
+		if (commands.empty()) { return 0; }
+		return commands.apply(*this);
+	}
+
+	/**
+	 * @brief Get a handle to an entity that is in use.
+	 * 
+	 * @param e Entity that has been created and not freed.
+	 * @return Handle with the current generation of `e`.
+	 */
+	const Handle getHandle(entity e) const { return Handle(e, generations[e]); }
+
+	/**
+	 * @brief Check if the entity of a handle has not been freed since the handle was made.
+	 * 
+	 * @param h Handle to check.
+	 * @return `true` if `h` still refers to the same entity, `false` otherwise.
+	 */
+	const bool isAlive(Handle h) const {
+		return h.index < generations.size() && generations[h.index] == h.generation;
+	}
+
     /**
      * @brief Remove the entity's associated component data and free it of use.
 	 * 
 	 * @details
 	 * This is the base case for freeEntity().
 	 * The recursive case deletes the entity's component data.
+	 * Handles to the entity that were made before this call are no longer alive.
 	 * "now for the tricky bit"
      * 
      * @param e Entity to free.
      */
 	template<std::size_t I = 0>
 	typename std::enable_if<(I == std::tuple_size<decltype(components)>::value)>::type
-	freeEntity(entity e) { deadEntities.push_back(e); }
+	freeEntity(entity e) {
+		release(e);
+	}
 
     /**
      * @brief @copybrief freeEntity
@@ -114,19 +281,68 @@ struct GRY_ECS {
 		freeEntity<I + 1>(e);
 	}
 
+	/**
+	 * @brief Free every entity in a range, removing their component data in bulk.
+	 * 
+	 * @details
+	 * Each ComponentSet is compacted once, see SparseSet::removeRange.
+	 * The entities must be in use, and must not repeat.
+	 * 
+	 * @tparam It Iterator type of the range, with `entity` values.
+	 * @param first Start of the range.
+	 * @param last End of the range.
+	 */
+	template<class It>
+	void freeEntities(It first, It last) {
+		std::apply([first, last](auto&... sets) { (sets.removeRange(first, last), ...); }, components);
+		for (; first != last; ++first) { release(*first); }
+	}
+
 private:
+	/**
+	 * @brief Advance the generation of a freed entity, and make it available again unless it is retired.
+	 * 
+	 * @param e Entity whose component data has been removed.
+	 */
+	void release(entity e) {
+		if (++generations[e] == RETIRED_GENERATION) {
+			GRY_Log("[GRY_ECS] Entity %zu was freed %u times, so it is retired.\n", (std::size_t)e, (unsigned)RETIRED_GENERATION);
+			return;
+		}
+		deadEntities.push_back(e);
+	}
+
 	/**
 	 * @brief Container to keep track of entities that are no longer in use.
 	 * 
 	 */
     std::vector<entity> deadEntities;
+
+	/**
+	 * @brief Changes to apply at the next applyCommands.
+	 * 
+	 */
+	CommandBuffer commands;
+
+	/**
+	 * @brief Generation of each created entity, see EntityHandle.
+	 * 
+	 */
+	std::vector<uint16_t> generations;
 	
 	/**
 	 * @brief Next entity to be created.
 	 * 
 	 * @details
-	 * If the number of created entities has reached `ECS::MAX_ENTITIES`,
+	 * If the number of created entities has reached `capacity`,
 	 * then the next entity will come from `deadEntities` instead.
 	 */
 	entity back = 0;
+
+	/**
+	 * @brief Number of entities that can be in use at once.
+	 * 
+	 * @sa setCapacity
+	 */
+	entity capacity = MAX_ENTITIES;
 };
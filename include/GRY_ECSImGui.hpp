@@ -9,19 +9,19 @@
 #include "Components.hpp"
 #include "imgui.h"
 
-template<typename T>
-void imguiComponentSet(ComponentSet<T>& set, std::size_t I, const char** componentStrings);
+template<typename T, typename entity, entity SIZE>
+void imguiComponentSet(SparseSet<T, entity, SIZE>& set, std::size_t I, const char** componentStrings);
 
-template<std::size_t I = 0, class... Ts>
-typename std::enable_if<(I == std::tuple_size<std::tuple<ComponentSet<Ts>...>>::value)>::type
-imguiRecurseComponents(std::tuple<ComponentSet<Ts>...>& components, const char** componentStrings = nullptr) {
+template<std::size_t I = 0, class Tuple>
+typename std::enable_if<(I == std::tuple_size<Tuple>::value)>::type
+imguiRecurseComponents(Tuple& components, const char** componentStrings = nullptr) {
 }
 
-template<std::size_t I = 0, class... Ts>
-typename std::enable_if<(I < std::tuple_size<std::tuple<ComponentSet<Ts>...>>::value)>::type
-imguiRecurseComponents(std::tuple<ComponentSet<Ts>...>& components, const char** componentStrings = nullptr) {
+template<std::size_t I = 0, class Tuple>
+typename std::enable_if<(I < std::tuple_size<Tuple>::value)>::type
+imguiRecurseComponents(Tuple& components, const char** componentStrings = nullptr) {
 	imguiComponentSet(std::get<I>(components), I, componentStrings);
-	imguiRecurseComponents<I+1,Ts...>(components, componentStrings);
+	imguiRecurseComponents<I+1>(components, componentStrings);
 }
 
 template<class T>
@@ -29,20 +29,32 @@ void componentImGui(T& t) {
 	ImGui::Text("No ImGui implementation for this component.");
 }
 
-template<class... Ts>
-void imguiECS(GRY_ECS<Ts...>& ecs) {
+/**
+ * @brief Display the memory used by an ECS, next to what flat sparse arrays would use.
+ * 
+ * @param memory Memory used by the ECS.
+ */
+inline void imguiECSMemory(const SparseSetMemory& memory) {
+	ImGui::Text("Memory: %zu bytes (%zu sparse pages)", memory.total(), memory.pages);
+	ImGui::Text("Sparse: %zu bytes paged, %zu bytes flat", memory.sparse, memory.flatSparse);
+}
+
+template<class ECSType>
+void imguiECS(ECSType& ecs) {
 	ImGui::Begin("ECS");
+	imguiECSMemory(ecs.totalMemoryUsage());
 	imguiRecurseComponents(ecs.components);
 	ImGui::End();
 }
 
-template<typename T>
-void imguiComponentSet(ComponentSet<T>& set, std::size_t I, const char** componentStrings) {
+template<typename T, typename entity, entity SIZE>
+void imguiComponentSet(SparseSet<T, entity, SIZE>& set, std::size_t I, const char** componentStrings) {
 	ImGui::PushID(I);
 	const char* name = componentStrings ? componentStrings[I] : "ComponentSet %d";
 	if (ImGui::TreeNode("", name, I)) {
+		imguiECSMemory(set.memoryUsage());
 		for (int i = 0; i < set.dense.size(); i++) {
-			ECS::entity e = set.dense.at(i);
+			entity e = set.dense.at(i);
 			ImGui::PushID(e);
 			if (ImGui::TreeNode("", "Entity %d", e)) {
 				componentImGui(set.value.at(i));
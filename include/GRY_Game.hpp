@@ -61,6 +61,20 @@ protected:
 	 * 
 	 */
 	bool gameRunning = true;
+
+	/**
+	 * @brief Run the ticks owed for the time that has passed, then the per frame update of the scenes and audio.
+	 * 
+	 * @param maxTicks Most ticks to run.
+	 * @return Number of ticks run.
+	 */
+	uint64_t updateScenes(uint64_t maxTicks);
+
+	/**
+	 * @brief Find how long the frame lasted, so the next frames run its ticks, and record it.
+	 * 
+	 */
+	void endFrame();
 public:
 	/**
 	 * @brief Constructor.
@@ -69,8 +83,16 @@ public:
 	 * @param WINDOW_HEIGHT Screen height in pixels.
 	 * @param MAX_FPS Maximum frames per second the game should run at.
 	 * @param USE_VSYNC Whether the game will use VSync, `true` by default.
+	 * @param HEADLESS Run without a window, debugger or audio output, `false` by default.
+	 * A headless game is usually run with `runHeadless`.
+	 */
+	GRY_Game(int WINDOW_WIDTH, int WINDOW_HEIGHT, int MAX_FPS, bool USE_VSYNC = true, bool HEADLESS = false);
+
+	/**
+	 * @brief Destructor. Writes out any running gperftools profiles.
+	 * 
 	 */
-	GRY_Game(int WINDOW_WIDTH, int WINDOW_HEIGHT, int MAX_FPS, bool USE_VSYNC = true);
+	~GRY_Game();
 
 	GRY_Game(const GRY_Game&) = delete;
 	GRY_Game& operator=(const GRY_Game&) = delete;
@@ -78,9 +100,35 @@ public:
 	/**
 	 * @brief Start the game.
 	 * 
+	 * @details
+	 * A headless game runs the same frames without drawing or the debugger,
+	 * each lasting one tick unless input is being replayed. Like `runHeadless`,
+	 * it stops when the replay ends.
 	 */
 	void runGame();
 
+	/**
+	 * @brief Run the active scene's simulation as fast as possible, without a window.
+	 * 
+	 * @details
+	 * Frames run in the same order as in `runGame`: input is read, then
+	 * `Scene::tick` runs for the ticks owed by the earlier frames, each
+	 * advancing the simulation by `getTickLength()`, then `Scene::process`, so
+	 * interactions, dialogue, menus and scene transitions work the same as in
+	 * `runGame`. Scenes skip whatever they only draw, see
+	 * `GRY_Video::isHeadless`. The game must have been constructed headless.
+	 * 
+	 * Without a replay, every frame lasts one tick. While input is being
+	 * replayed, each recorded frame runs the same ticks it did when it was
+	 * recorded, and the run stops when the replay ends.
+	 * 
+	 * Stops early if the game quits.
+	 * 
+	 * @param ticks Number of ticks to run.
+	 * @return Ticks run per second.
+	 */
+	double runHeadless(uint64_t ticks);
+
 	/**
 	 * @brief Quit the game.
 	 * 
@@ -96,6 +144,20 @@ public:
 	 */
 	virtual void process();
 
+	/**
+	 * @brief Called every frame before the scenes draw, to choose where they draw to.
+	 * 
+	 * @details
+	 * By default the scenes draw straight to the window.
+	 */
+	virtual void beginRender() {}
+
+	/**
+	 * @brief Called every frame after the scenes draw, before the debugger draws on top.
+	 * 
+	 */
+	virtual void endRender() {}
+
 	/**
 	 * @brief Get the internal GRY_Video.
 	 * 
@@ -123,6 +185,26 @@ public:
 	 */
 	double getFPS() { return fps.getFPS(); }
 
+	/**
+	 * @copydoc FPSHandler::getTickLength
+	 */
+	double getTickLength() { return fps.getTickLength(); }
+
+	/**
+	 * @copydoc FPSHandler::getInterpolation
+	 */
+	float getInterpolation() { return fps.getInterpolation(); }
+
+	/**
+	 * @copydoc InputHandler::startRecording
+	 */
+	bool recordInput(const char* path) { return input.startRecording(path); }
+
+	/**
+	 * @copydoc InputHandler::startReplay
+	 */
+	bool replayInput(const char* path) { return input.startReplay(path); }
+
 	/**
 	 * @copydoc InputHandler::setControlScheme
 	 */
@@ -149,6 +231,11 @@ public:
 	 */
 	const bool isPressing(GCmd cmd) { return input.isPressing(cmd); }
 
+	/**
+	 * @copydoc InputHandler::getRenderTargetResets
+	 */
+	unsigned getRenderTargetResets() { return input.getRenderTargetResets(); }
+
 	/**
 	 * @brief Get the internal GRY_Audio.
 	 * 
@@ -159,8 +246,11 @@ public:
 	/**
 	 * @brief Determine whether the debug menu is active or not.
 	 * 
+	 * @details
+	 * Always `false` when headless, since there is no ImGui context to draw with.
+	 * 
 	 * @return `true` if the debug menu is on.
 	 * @return `false` otherwise.
 	 */
-	const bool debugMenuIsOn() { return imguiDebug.active; }
+	const bool debugMenuIsOn() { return imguiDebug.active && imguiDebug.isInitialized(); }
 };
@@ -0,0 +1,106 @@
+/**
+ * @file GRY_Gperftools.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Starts and stops gperftools CPU and heap profiles.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * gperftools is only linked when the ENABLE_GPERFTOOLS CMake option is on,
+ * which defines `GRY_GPERFTOOLS`. Otherwise every function here does nothing
+ * and reports that no profile is running.
+ *
+ * Profiles can be started from the debug overlay, or for the whole run by
+ * setting an environment variable before starting the game:
+ * - `GRY_CPU_PROFILE=game.prof` writes a CPU profile to `game.prof`.
+ * - `GRY_HEAP_PROFILE=game` writes heap profiles to `game.0001.heap`, and so on.
+ *
+ * Read them with `pprof ./game game.prof`.
+ */
+#pragma once
+
+namespace GRY_Gperftools {
+	/**
+	 * @brief Environment variable holding the path of a CPU profile to record for the whole run.
+	 *
+	 */
+	static const char* CPU_PROFILE_ENV = "GRY_CPU_PROFILE";
+
+	/**
+	 * @brief Environment variable holding the prefix of heap profiles to record for the whole run.
+	 *
+	 */
+	static const char* HEAP_PROFILE_ENV = "GRY_HEAP_PROFILE";
+
+	/**
+	 * @brief Determine if the game was built with gperftools.
+	 *
+	 * @return `true` if profiles can be recorded.
+	 * @return `false` otherwise.
+	 */
+	bool isAvailable();
+
+	/**
+	 * @brief Start sampling the CPU.
+	 *
+	 * @param path File to write the profile to when it stops.
+	 * @return `true` if the profile started.
+	 * @return `false` otherwise.
+	 */
+	bool startCpuProfile(const char* path);
+
+	/**
+	 * @brief Stop sampling the CPU and write the profile. Does nothing if it was not started.
+	 *
+	 */
+	void stopCpuProfile();
+
+	/**
+	 * @brief Determine if the CPU is being sampled.
+	 *
+	 * @return `true` if a CPU profile is running.
+	 * @return `false` otherwise.
+	 */
+	bool isCpuProfiling();
+
+	/**
+	 * @brief Start recording heap allocations.
+	 *
+	 * @param prefix Start of the names of the written heap profiles.
+	 * @return `true` if the profile started.
+	 * @return `false` otherwise.
+	 */
+	bool startHeapProfile(const char* prefix);
+
+	/**
+	 * @brief Write the current heap profile now, rather than waiting for the next automatic dump.
+	 *
+	 * @param reason Note written into the profile.
+	 */
+	void dumpHeapProfile(const char* reason);
+
+	/**
+	 * @brief Stop recording heap allocations. Does nothing if it was not started.
+	 *
+	 */
+	void stopHeapProfile();
+
+	/**
+	 * @brief Determine if heap allocations are being recorded.
+	 *
+	 * @return `true` if a heap profile is running.
+	 * @return `false` otherwise.
+	 */
+	bool isHeapProfiling();
+
+	/**
+	 * @brief Start the profiles asked for by CPU_PROFILE_ENV and HEAP_PROFILE_ENV, if any.
+	 *
+	 */
+	void startFromEnvironment();
+
+	/**
+	 * @brief Stop any running profiles, writing them out.
+	 *
+	 */
+	void stopAll();
+}
@@ -10,6 +10,12 @@
 /**
  * @brief Variation of GRY_Game for games that use pixel art.
  * 
+ * @details
+ * Scenes draw at the game's own resolution, in game pixels, to a
+ * `SCREEN_WIDTH_PIXELS` by `SCREEN_HEIGHT_PIXELS` texture. At the end of
+ * the frame, that texture is scaled up to the window in one copy with
+ * nearest neighbour scaling, and the debugger draws on top of it at the
+ * window's resolution.
  */
 class GRY_PixelGame : public GRY_Game {
 private:
@@ -26,15 +32,33 @@ private:
 	unsigned int SCREEN_HEIGHT_PIXELS;
 
 	/**
-	 * @brief Scaling factor for textures. Ideally a whole number.
+	 * @brief Scaling from game pixels to window pixels. A whole number.
 	 * 
 	 */
 	float pixelScaling;
+
+	/**
+	 * @brief Texture the scenes draw to, one texel per game pixel.
+	 * 
+	 */
+	SDL_Texture* screenTarget = nullptr;
+
+	/**
+	 * @brief Set `pixelScaling` from the size of the window.
+	 * 
+	 */
+	void updatePixelScaling();
 public:
 	/**
 	 * @copydoc GRY_Game::GRY_Game
 	 */
-	GRY_PixelGame(int WINDOW_WIDTH, int WINDOW_HEIGHT, int MAX_FPS, bool USE_VSYNC = true);
+	GRY_PixelGame(int WINDOW_WIDTH, int WINDOW_HEIGHT, int MAX_FPS, bool USE_VSYNC = true, bool HEADLESS = false);
+
+	/**
+	 * @brief Destructor.
+	 * 
+	 */
+	~GRY_PixelGame();
 
 	/**
 	 * @copydoc GRY_Game::process
@@ -42,6 +66,18 @@ public:
 	 */
 	void process() final override;
 
+	/**
+	 * @brief Draw the scenes to the screen texture.
+	 * 
+	 */
+	void beginRender() final override;
+
+	/**
+	 * @brief Scale the screen texture up to the window.
+	 * 
+	 */
+	void endRender() final override;
+
 	/**
 	 * @brief Get the screen width in pixels.
 	 * 
@@ -57,9 +93,9 @@ public:
 	unsigned int getScreenHeightPixels() { return SCREEN_HEIGHT_PIXELS; }
 
 	/**
-	 * @brief Get a reference to the pixel scaling factor.
+	 * @brief Get the scaling from game pixels to window pixels.
 	 * 
-	 * @return Reference to the pixel scaling factor.
+	 * @return The pixel scaling factor.
 	 */
-	const float& getPixelScalingRef() { return pixelScaling; }
-};
\ No newline at end of file
+	float getPixelScaling() const { return pixelScaling; }
+};
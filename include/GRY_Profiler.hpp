@@ -0,0 +1,206 @@
+/**
+ * @file GRY_Profiler.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Scoped timers that record where the time of each frame goes.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * Mark a block of code with `GRY_ProfileScope("Name");` and the start of
+ * each frame with `GRY_ProfileFrame();`. The zones of the last
+ * GRY_Profiler::FRAME_HISTORY frames are kept in a ring buffer, which the
+ * debug overlay draws as a timeline and which can be exported as a Chrome
+ * trace (chrome://tracing, or https://ui.perfetto.dev).
+ *
+ * The macros only record anything when `GRY_PROFILE` is defined, which the
+ * ENABLE_FRAME_PROFILER CMake option does. Otherwise they compile to nothing.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace GRY_Profiler {
+	/**
+	 * @brief Number of recent frames that are kept.
+	 *
+	 */
+	static const std::size_t FRAME_HISTORY = 240;
+
+	/**
+	 * @brief Zones recorded per frame. Any zones past this in a frame are dropped.
+	 *
+	 */
+	static const std::size_t MAX_ZONES = 128;
+
+	/**
+	 * @brief A timed block of code.
+	 *
+	 */
+	struct Zone {
+		/**
+		 * @brief Name of the zone. Must be a string that outlives the profiler, such as a literal.
+		 *
+		 */
+		const char* name;
+
+		/**
+		 * @brief Start time, in nanoseconds since the profiler started.
+		 *
+		 */
+		uint64_t start;
+
+		/**
+		 * @brief End time, in nanoseconds since the profiler started.
+		 *
+		 */
+		uint64_t end;
+
+		/**
+		 * @brief Number of zones this one is nested in.
+		 *
+		 */
+		uint32_t depth;
+	};
+
+	/**
+	 * @brief The zones of one frame, in the order they started.
+	 *
+	 */
+	struct Frame {
+		/**
+		 * @brief Start time, in nanoseconds since the profiler started.
+		 *
+		 */
+		uint64_t start = 0;
+
+		/**
+		 * @brief End time, in nanoseconds since the profiler started. 0 while the frame is running.
+		 *
+		 */
+		uint64_t end = 0;
+
+		/**
+		 * @brief Number of zones used in `zones`.
+		 *
+		 */
+		std::size_t zoneCount = 0;
+
+		/**
+		 * @brief Recorded zones.
+		 *
+		 */
+		Zone zones[MAX_ZONES];
+	};
+
+	/**
+	 * @brief End the current frame and start recording the next one.
+	 *
+	 * @details
+	 * Does nothing while paused.
+	 */
+	void beginFrame();
+
+	/**
+	 * @brief Start timing a zone.
+	 *
+	 * @param name Name of the zone.
+	 * @return Index of the zone to pass to `endZone`, or MAX_ZONES if it is not recorded.
+	 */
+	std::size_t beginZone(const char* name);
+
+	/**
+	 * @brief Stop timing a zone.
+	 *
+	 * @param zone Index returned by `beginZone`.
+	 */
+	void endZone(std::size_t zone);
+
+	/**
+	 * @brief Stop or resume recording, so the recorded frames can be looked at.
+	 *
+	 * @param paused `true` to stop recording.
+	 */
+	void setPaused(bool paused);
+
+	/**
+	 * @brief Determine if recording is stopped.
+	 *
+	 * @return `true` if paused.
+	 * @return `false` otherwise.
+	 */
+	bool isPaused();
+
+	/**
+	 * @brief Get the number of finished frames that are kept, up to FRAME_HISTORY.
+	 *
+	 * @return Number of frames.
+	 */
+	std::size_t frameCount();
+
+	/**
+	 * @brief Get a finished frame.
+	 *
+	 * @param age 0 for the latest finished frame, 1 for the one before it, and so on.
+	 * Must be less than `frameCount()`.
+	 * @return The frame.
+	 */
+	const Frame& getFrame(std::size_t age);
+
+	/**
+	 * @brief Write the kept frames as a Chrome trace event file.
+	 *
+	 * @param path Path of the file.
+	 * @return `true` if the file was written.
+	 * @return `false` otherwise.
+	 */
+	bool exportChromeTrace(const char* path);
+
+	/**
+	 * @brief Times a zone for as long as it exists.
+	 *
+	 */
+	class ScopedZone {
+	private:
+		/**
+		 * @brief Index of the zone being timed.
+		 *
+		 */
+		std::size_t zone;
+	public:
+		/**
+		 * @brief Start timing.
+		 *
+		 * @param name @copydoc Zone::name
+		 */
+		ScopedZone(const char* name) : zone(beginZone(name)) {}
+
+		/**
+		 * @brief Stop timing.
+		 *
+		 */
+		~ScopedZone() { endZone(zone); }
+
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+	};
+}
+
+#define GRY_PROFILE_CONCAT_IMPL(a, b) a##b
+#define GRY_PROFILE_CONCAT(a, b) GRY_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef GRY_PROFILE
+	/**
+	 * @brief Time the rest of the enclosing block as a zone called `name`.
+	 *
+	 * @param name Name of the zone, a string literal.
+	 */
+	#define GRY_ProfileScope(name) GRY_Profiler::ScopedZone GRY_PROFILE_CONCAT(gryProfileZone, __LINE__)(name)
+
+	/**
+	 * @brief Mark the start of a frame.
+	 *
+	 */
+	#define GRY_ProfileFrame() GRY_Profiler::beginFrame()
+#else
+	#define GRY_ProfileScope(name) ((void)0)
+	#define GRY_ProfileFrame() ((void)0)
+#endif
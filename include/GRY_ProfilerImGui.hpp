@@ -0,0 +1,154 @@
+/**
+ * @file GRY_ProfilerImGui.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Displays the frames recorded by GRY_Profiler with Dear ImGui.
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include "GRY_Profiler.hpp"
+#include "imgui.h"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief File that the profiler window exports Chrome traces to.
+ *
+ */
+static const char* PROFILER_TRACE_PATH = "profile.json";
+
+/**
+ * @brief Get a color for a zone, the same every frame for the same name.
+ *
+ * @param name Name of the zone.
+ * @return Color for ImDrawList.
+ */
+inline ImU32 imguiProfilerZoneColor(const char* name) {
+	uint32_t hash = 2166136261u;
+	for (const char* c = name; *c; c++) { hash = (hash ^ (uint8_t)*c) * 16777619u; }
+	return IM_COL32(80 + hash % 150, 80 + (hash >> 8) % 150, 80 + (hash >> 16) % 150, 255);
+}
+
+/**
+ * @brief Draw the zones of a frame as a timeline, one row per nesting depth.
+ *
+ * @param frame The frame to draw.
+ */
+inline void imguiProfilerTimeline(const GRY_Profiler::Frame& frame) {
+	const float ROW_HEIGHT = ImGui::GetTextLineHeight() + 4.f;
+	uint32_t rows = 1;
+	for (std::size_t i = 0; i < frame.zoneCount; i++) { rows = std::max(rows, frame.zones[i].depth + 1); }
+
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	float width = std::max(ImGui::GetContentRegionAvail().x, 100.f);
+	float scale = width / std::max<uint64_t>(frame.end - frame.start, 1);
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+	const GRY_Profiler::Zone* hovered = nullptr;
+	ImVec2 mouse = ImGui::GetIO().MousePos;
+	for (std::size_t i = 0; i < frame.zoneCount; i++) {
+		const GRY_Profiler::Zone& zone = frame.zones[i];
+		uint64_t end = zone.end ? zone.end : frame.end;
+		ImVec2 min(origin.x + (zone.start - frame.start) * scale, origin.y + zone.depth * ROW_HEIGHT);
+		ImVec2 max(std::max(origin.x + (end - frame.start) * scale, min.x + 1.f), min.y + ROW_HEIGHT - 1.f);
+		drawList->AddRectFilled(min, max, imguiProfilerZoneColor(zone.name));
+		/* Only label zones wide enough to read */
+		if (max.x - min.x > ImGui::CalcTextSize(zone.name).x + 4.f) {
+			drawList->AddText(ImVec2(min.x + 2.f, min.y + 2.f), IM_COL32(0, 0, 0, 255), zone.name);
+		}
+		if (mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) { hovered = &zone; }
+	}
+	ImGui::Dummy(ImVec2(width, rows * ROW_HEIGHT));
+
+	if (hovered && ImGui::IsItemHovered()) {
+		uint64_t end = hovered->end ? hovered->end : frame.end;
+		ImGui::SetTooltip("%s: %.3f ms", hovered->name, (end - hovered->start) / 1e6);
+	}
+}
+
+/**
+ * @brief List the total time of each zone name in a frame.
+ *
+ * @details
+ * Zones that run several times in a frame, like those inside of each
+ * simulation tick, are added together.
+ *
+ * @param frame The frame to list.
+ */
+inline void imguiProfilerTotals(const GRY_Profiler::Frame& frame) {
+	const char* names[GRY_Profiler::MAX_ZONES];
+	uint64_t totals[GRY_Profiler::MAX_ZONES];
+	uint32_t calls[GRY_Profiler::MAX_ZONES];
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < frame.zoneCount; i++) {
+		const GRY_Profiler::Zone& zone = frame.zones[i];
+		std::size_t j = 0;
+		while (j < count && strcmp(names[j], zone.name) != 0) { j++; }
+		if (j == count) {
+			names[count] = zone.name;
+			totals[count] = 0;
+			calls[count] = 0;
+			count++;
+		}
+		totals[j] += (zone.end ? zone.end : frame.end) - zone.start;
+		calls[j]++;
+	}
+
+	if (!ImGui::BeginTable("Zone totals", 3)) { return; }
+	ImGui::TableSetupColumn("Zone");
+	ImGui::TableSetupColumn("Calls");
+	ImGui::TableSetupColumn("ms");
+	ImGui::TableHeadersRow();
+	for (std::size_t i = 0; i < count; i++) {
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(names[i]);
+		ImGui::TableNextColumn();
+		ImGui::Text("%u", calls[i]);
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", totals[i] / 1e6);
+	}
+	ImGui::EndTable();
+}
+
+/**
+ * @brief Show the profiler window, with a graph of recent frame times and the timeline of one frame.
+ *
+ */
+inline void imguiProfiler() {
+	ImGui::Begin("Profiler");
+
+	#ifndef GRY_PROFILE
+	ImGui::TextUnformatted("Built without ENABLE_FRAME_PROFILER, so no zones are recorded.");
+	#endif
+
+	bool paused = GRY_Profiler::isPaused();
+	if (ImGui::Checkbox("Paused", &paused)) { GRY_Profiler::setPaused(paused); }
+	ImGui::SameLine();
+	if (ImGui::Button("Export Chrome trace")) { GRY_Profiler::exportChromeTrace(PROFILER_TRACE_PATH); }
+
+	std::size_t count = GRY_Profiler::frameCount();
+	if (!count) {
+		ImGui::TextUnformatted("No frames recorded yet.");
+		ImGui::End();
+		return;
+	}
+
+	/* Oldest frame first, so the graph scrolls to the left */
+	static float frameTimes[GRY_Profiler::FRAME_HISTORY];
+	for (std::size_t i = 0; i < count; i++) {
+		const GRY_Profiler::Frame& frame = GRY_Profiler::getFrame(count - 1 - i);
+		frameTimes[i] = (frame.end - frame.start) / 1e6f;
+	}
+	ImGui::PlotHistogram("##Frame times", frameTimes, (int)count, 0, "Frame ms", 0.f, 50.f, ImVec2(-1.f, 60.f));
+
+	static int selected = 0;
+	selected = std::min(selected, (int)count - 1);
+	ImGui::SliderInt("Frames ago", &selected, 0, (int)count - 1);
+
+	const GRY_Profiler::Frame& frame = GRY_Profiler::getFrame(selected);
+	ImGui::Text("Frame: %.3f ms, %zu zones", (frame.end - frame.start) / 1e6, frame.zoneCount);
+	imguiProfilerTimeline(frame);
+	imguiProfilerTotals(frame);
+
+	ImGui::End();
+}
@@ -0,0 +1,121 @@
+/**
+ * @file GRY_RenderBatch.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief @copybrief GRY_RenderBatch
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include "SDL3/SDL_render.h"
+#include <vector>
+
+/**
+ * @brief Collects textured quads and draws each run of quads that share a texture with one `SDL_RenderGeometry` call.
+ *
+ * @details
+ * Quads are drawn in the order they were added. Adding a quad with a
+ * different texture than the last one draws the quads collected so far,
+ * so anything drawn in between, like the sprites between rows of tiles,
+ * still lands on top of what came before it.
+ *
+ * Call `flush` before drawing anything without the batch.
+ */
+class GRY_RenderBatch {
+public:
+	/**
+	 * @brief Work sent to the renderer.
+	 *
+	 */
+	struct Stats {
+		/**
+		 * @brief Number of `SDL_RenderGeometry` calls.
+		 *
+		 */
+		std::size_t drawCalls = 0;
+
+		/**
+		 * @brief Number of vertices drawn.
+		 *
+		 */
+		std::size_t vertices = 0;
+	};
+
+private:
+	/**
+	 * @brief Pointer to the renderer.
+	 *
+	 */
+	SDL_Renderer* renderer;
+
+	/**
+	 * @brief Texture of the quads collected so far.
+	 *
+	 */
+	SDL_Texture* texture = nullptr;
+
+	/**
+	 * @brief Size of `texture`, to turn source rectangles into texture coordinates.
+	 *
+	 */
+	float textureWidth = 1.f;
+	float textureHeight = 1.f;
+
+	/**
+	 * @brief Four vertices for each collected quad. Kept between frames so they do not allocate.
+	 *
+	 */
+	std::vector<SDL_Vertex> vertices;
+
+	/**
+	 * @brief Two triangles for each collected quad.
+	 *
+	 */
+	std::vector<int> indices;
+
+	/**
+	 * @brief Stats of the frame in progress.
+	 *
+	 */
+	Stats current;
+
+	/**
+	 * @brief Stats of the last finished frame.
+	 *
+	 */
+	Stats last;
+
+public:
+	/**
+	 * @brief Constructor.
+	 *
+	 * @param renderer Renderer to draw with.
+	 */
+	GRY_RenderBatch(SDL_Renderer* renderer) : renderer(renderer) {}
+
+	/**
+	 * @brief Add a quad to draw.
+	 *
+	 * @param quadTexture Texture to draw from. Quads without a texture are skipped.
+	 * @param srcRect Area of the texture to draw, in pixels.
+	 * @param dstRect Area of the screen to draw to.
+	 */
+	void add(SDL_Texture* quadTexture, const SDL_FRect& srcRect, const SDL_FRect& dstRect);
+
+	/**
+	 * @brief Draw the collected quads.
+	 *
+	 */
+	void flush();
+
+	/**
+	 * @brief Draw the collected quads and finish the frame's stats.
+	 *
+	 */
+	void endFrame();
+
+	/**
+	 * @brief Get the work sent to the renderer over the last frame.
+	 *
+	 * @return `const` reference to the stats.
+	 */
+	const Stats& getStats() const { return last; }
+};
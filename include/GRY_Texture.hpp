@@ -6,6 +6,7 @@
  */
 #pragma once
 #include "FileResource.hpp"
+#include "SDL3/SDL_rect.h"
 
 struct SDL_Texture;
 
@@ -20,6 +21,18 @@ struct GRY_Texture : public FileResource {
 	 */
 	SDL_Texture* texture = nullptr;
 
+	/**
+	 * @brief Whether `texture` is destroyed with this resource. `false` once it is packed into a GRY_Atlas.
+	 * 
+	 */
+	bool ownsTexture = true;
+
+	/**
+	 * @brief Area of `texture` holding the image. The whole texture, unless it is packed into a GRY_Atlas.
+	 * 
+	 */
+	SDL_FRect area{ 0.f, 0.f, 0.f, 0.f };
+
 	/**
 	 * @brief Constructor.
 	 * 
@@ -53,6 +66,8 @@ struct GRY_Texture : public FileResource {
 		using std::swap;
 		swap(static_cast<FileResource&>(lhs), static_cast<FileResource&>(rhs));
 		swap(lhs.texture, rhs.texture);
+		swap(lhs.ownsTexture, rhs.ownsTexture);
+		swap(lhs.area, rhs.area);
 	}
 
 	/**
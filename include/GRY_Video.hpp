@@ -9,6 +9,7 @@
 struct SDL_Window;
 struct SDL_Renderer;
 struct SDL_Texture;
+struct SDL_Surface;
 
 /**
  * @brief Initializes and provides an interface for SDL functionality.
@@ -40,6 +41,12 @@ private:
 	 */
 	const bool USE_VSYNC;
 
+	/**
+	 * @brief Whether there is no window, in which case the renderer draws to `headlessTarget`.
+	 * 
+	 */
+	const bool HEADLESS;
+
 	/**
 	 * @brief The game's fullscreen status.
 	 * 
@@ -58,6 +65,12 @@ private:
 	 */
 	SDL_Renderer* gameRenderer = nullptr;
 
+	/**
+	 * @brief Surface that the software renderer draws to when headless.
+	 * 
+	 */
+	SDL_Surface* headlessTarget = nullptr;
+
 	/**
 	 * @brief Closes SDL.
 	 * 
@@ -71,6 +84,13 @@ private:
 	 * @return `false` if there was at least one error.
 	 */
 	bool init();
+	/**
+	 * @brief Creates a software renderer without a window, for headless mode.
+	 * 
+	 * @return `true` if there were no errors during initialization.
+	 * @return `false` if there was at least one error.
+	 */
+	bool initHeadless();
 public:
 	/**
 	 * @brief Constructor.
@@ -78,8 +98,10 @@ public:
 	 * @param WINDOW_WIDTH Window width in pixels.
 	 * @param WINDOW_HEIGHT Window height in pixels.
 	 * @param USE_VSYNC Whether the game will use VSync.
+	 * @param HEADLESS If `true`, no window is opened, and a software renderer is created
+	 * so that textures can still be loaded.
 	 */
-	GRY_Video(int WINDOW_WIDTH, int WINDOW_HEIGHT, bool USE_VSYNC = true);
+	GRY_Video(int WINDOW_WIDTH, int WINDOW_HEIGHT, bool USE_VSYNC = true, bool HEADLESS = false);
 
 	/**
 	 * @brief Destructor.
@@ -143,4 +165,12 @@ public:
 	 * @return Reference to the SDL_Renderer*.
 	 */
 	SDL_Renderer* getRenderer() { return gameRenderer; }
+
+	/**
+	 * @brief Determine whether the video is running without a window.
+	 * 
+	 * @return `true` if headless.
+	 * @return `false` otherwise.
+	 */
+	bool isHeadless() const { return HEADLESS; }
 };
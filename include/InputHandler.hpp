@@ -8,6 +8,7 @@
 #include "SDL3/SDL_scancode.h"
 #include "GRY_Mousecode.hpp"
 #include "CommandMap.hpp"
+#include "InputRecording.hpp"
 #include <vector>
 
 /**
@@ -70,12 +71,39 @@ private:
      * 
      */
 	VirtualButton singleInput = GAME_NONE;
+    /**
+     * @brief Whether `frame` was taken from `replay`.
+     * 
+     */
+    bool replaying = false;
 
+	/**
+	 * @brief State of the VirtualButtons for the current frame, which every getter reads.
+	 * 
+	 * @details
+	 * Built from the live inputs, or taken from `replay` while one is playing.
+	 */
+	InputFrame frame;
+	/**
+	 * @brief Records each frame's input, if a recording was started.
+	 * 
+	 */
+	InputRecorder recorder;
+	/**
+	 * @brief Replaces the live input with recorded input, if a replay was started.
+	 * 
+	 */
+	InputReplay replay;
 	/**
 	 * @brief The command map control scheme of the game.
 	 * 
 	 */
 	CommandMap controlScheme;
+	/**
+	 * @brief Number of times the renderer lost the contents of its render targets.
+	 * 
+	 */
+	unsigned renderTargetResets = 0;
 
     /**
      * @brief Map a virtual button to a physical input, and vice-versa.
@@ -96,6 +124,18 @@ private:
      * 
      */
     void loadControls();
+    /**
+     * @brief Determine if the physical input bound to `b` is held down right now.
+     * 
+     * @param b VirtualButton to check.
+     * @return `true` if `b` is held.
+     * @return `false` otherwise.
+     */
+    bool isHoldingVButton(VirtualButton b) const {
+	    return b &&
+		    ((buttonState[b][0] && *buttonState[b][0]) ||
+		    (buttonState[b][1] && *buttonState[b][1]));
+    }
 public:
     /**
      * @brief Constructor.
@@ -109,6 +149,57 @@ public:
      * @param gameRunning Reference to the game's running status, which may be switched.
      */
     void process(bool& gameRunning);
+    /**
+     * @brief Set the current frame's input, without polling SDL for events.
+     * 
+     * @details
+     * Called by `process`. On its own, it is used by headless games, which have no events to poll.
+     * Takes the next frame of the replay while one is playing.
+     */
+    void updateFrame();
+    /**
+     * @brief Start recording every frame's input to a file.
+     * 
+     * @param path Path of the recording.
+     * @return `true` if the recording was started.
+     * @return `false` otherwise.
+     * 
+     * @sa recordFrame
+     */
+    bool startRecording(const char* path) { return recorder.open(path); }
+    /**
+     * @brief Add the current frame to the recording, if one was started.
+     * 
+     * @param delta Time the frame took, in seconds, before any clamping.
+     */
+    void recordFrame(double delta) {
+        frame.delta = delta;
+        recorder.record(frame);
+    }
+    /**
+     * @brief Start replaying recorded input instead of live input.
+     * 
+     * @details
+     * Once every frame has been played, live input is used again.
+     * 
+     * @param path Path of the recording.
+     * @return `true` if the recording was loaded.
+     * @return `false` otherwise.
+     */
+    bool startReplay(const char* path) { return replay.load(path); }
+    /**
+     * @brief Determine if the current frame's input came from a replay.
+     * 
+     * @return `true` if replaying.
+     * @return `false` otherwise.
+     */
+    bool isReplaying() const { return replaying; }
+    /**
+     * @brief Get the length of the current frame in the replay.
+     * 
+     * @return Recorded frame length in seconds.
+     */
+    double getReplayDelta() const { return frame.delta; }
 
 	/**
 	 * @brief Set the control scheme.
@@ -128,9 +219,7 @@ public:
      * @sa getSingleInputVButton
      * @sa isPressingVButton
      */
-    const VirtualButton getInputVButton() const { 
-        return inputs.size() ? inputs.back() : VirtualButton::GAME_NONE;
-    }
+    const VirtualButton getInputVButton() const { return frame.latest; }
 
     /**
      * @brief Get the latest active VirtualButton input from the current frame only.
@@ -143,7 +232,7 @@ public:
      * @sa getInputVButton
      * @sa isPressingVButton
      */
-    const VirtualButton getSingleInputVButton() const { return singleInput; }
+    const VirtualButton getSingleInputVButton() const { return frame.single; }
 
     /**
 	 * @brief Determine if `b` is being pressed.
@@ -155,11 +244,7 @@ public:
      * @sa getInputVButton
      * @sa getSingleInputVButton
 	 */
-    const bool isPressingVButton(VirtualButton b) const {
-	    return b &&
-		    ((buttonState[b][0] && *buttonState[b][0]) ||
-		    (buttonState[b][1] && *buttonState[b][1]));
-    }
+    const bool isPressingVButton(VirtualButton b) const { return frame.isPressing(b); }
 
     /**
      * @brief Get the latest active GCmd input.
@@ -185,7 +270,7 @@ public:
      * @sa getInput
      * @sa isPressing
      */
-	const GCmd getSingleInput() const { return controlScheme.commands[singleInput]; }
+	const GCmd getSingleInput() const { return controlScheme.commands[frame.single]; }
 
     /**
 	 * @brief Determine if the VirtualButton mapped to `cmd` is being pressed.
@@ -200,4 +285,14 @@ public:
 	const bool isPressing(GCmd cmd) const {
 		return isPressingVButton(controlScheme.buttons[cmd]);
 	}
+
+	/**
+	 * @brief Get the number of times the renderer lost the contents of its render targets.
+	 * 
+	 * @details
+	 * Anything cached in a render target has to be drawn again when this changes.
+	 * 
+	 * @return The number of resets so far.
+	 */
+	unsigned getRenderTargetResets() const { return renderTargetResets; }
 };
@@ -0,0 +1,175 @@
+/**
+ * @file InputRecording.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Recording and replaying of per-frame input to and from files.
+ * @copyright Copyright (c) 2025
+ *
+ * @details
+ * A recording is a small header followed by one fixed-size record per frame:
+ * | Bytes | Contents |
+ * | ----- | -------- |
+ * | 4     | `GRYI` |
+ * | 1     | Format version |
+ * | 1     | VirtualButton::VIRTUAL_BUTTON_SIZE when it was recorded |
+ *
+ * and for each frame, in little-endian order:
+ * | Bytes | Contents |
+ * | ----- | -------- |
+ * | 2     | Bitmask of pressed VirtualButtons |
+ * | 1     | Latest active VirtualButton |
+ * | 1     | Latest VirtualButton pressed during the frame |
+ * | 8     | Length of the frame in seconds, as the bits of a double |
+ */
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "VirtualButton.hpp"
+
+/**
+ * @brief The state of every VirtualButton during one frame, and how long the frame was.
+ *
+ * @sa InputHandler
+ */
+struct InputFrame {
+	/**
+	 * @brief Bit `b` is set if VirtualButton `b` is being pressed.
+	 *
+	 */
+	uint16_t pressed = 0;
+
+	/**
+	 * @brief The latest active VirtualButton, or GAME_NONE.
+	 *
+	 */
+	VirtualButton latest = GAME_NONE;
+
+	/**
+	 * @brief The latest VirtualButton pressed during this frame only, or GAME_NONE.
+	 *
+	 */
+	VirtualButton single = GAME_NONE;
+
+	/**
+	 * @brief Time the frame took, in seconds, before any clamping.
+	 *
+	 */
+	double delta = 0.0;
+
+	/**
+	 * @brief Determine if `b` is being pressed.
+	 *
+	 * @param b VirtualButton to check.
+	 * @return `true` if `b` is being pressed.
+	 * @return `false` otherwise.
+	 */
+	bool isPressing(VirtualButton b) const { return b && (pressed >> b & 1); }
+};
+
+static_assert(VirtualButton::VIRTUAL_BUTTON_SIZE <= 16, "InputFrame::pressed has one bit per VirtualButton.");
+
+/**
+ * @brief Writes InputFrames to a recording file as they happen.
+ *
+ */
+class InputRecorder {
+private:
+	/**
+	 * @brief File being recorded to, or `nullptr`.
+	 *
+	 */
+	FILE* file = nullptr;
+
+public:
+	InputRecorder() = default;
+
+	/**
+	 * @brief Destructor. Closes the file.
+	 *
+	 */
+	~InputRecorder() { close(); }
+
+	InputRecorder(const InputRecorder&) = delete;
+	InputRecorder& operator=(const InputRecorder&) = delete;
+
+	/**
+	 * @brief Start a new recording, replacing any file at `path`.
+	 *
+	 * @param path Path of the recording.
+	 * @return `true` if the file was opened.
+	 * @return `false` otherwise.
+	 */
+	bool open(const char* path);
+
+	/**
+	 * @brief Append a frame to the recording.
+	 *
+	 * @param frame The frame to record.
+	 */
+	void record(const InputFrame& frame);
+
+	/**
+	 * @brief Finish the recording.
+	 *
+	 */
+	void close();
+
+	/**
+	 * @brief Determine if a recording is in progress.
+	 *
+	 * @return `true` if recording.
+	 * @return `false` otherwise.
+	 */
+	bool isOpen() const { return file; }
+};
+
+/**
+ * @brief Plays back the InputFrames of a recording file, in order.
+ *
+ */
+class InputReplay {
+private:
+	/**
+	 * @brief Every frame of the recording.
+	 *
+	 */
+	std::vector<InputFrame> frames;
+
+	/**
+	 * @brief Index of the next frame to play.
+	 *
+	 */
+	std::size_t position = 0;
+
+public:
+	/**
+	 * @brief Read a whole recording, and start playing it from the beginning.
+	 *
+	 * @param path Path of the recording.
+	 * @return `true` if the recording was read.
+	 * @return `false` if it could not be opened, or is not a recording this version can play.
+	 */
+	bool load(const char* path);
+
+	/**
+	 * @brief Get the next frame of the recording.
+	 *
+	 * @return Pointer to the frame, or `nullptr` if every frame has been played.
+	 */
+	const InputFrame* next() { return position < frames.size() ? &frames[position++] : nullptr; }
+
+	/**
+	 * @brief Determine if there are frames left to play.
+	 *
+	 * @return `true` if there are.
+	 * @return `false` otherwise.
+	 */
+	bool isPlaying() const { return position < frames.size(); }
+
+	/**
+	 * @brief Get the number of frames in the recording.
+	 *
+	 * @return Number of frames.
+	 */
+	std::size_t size() const { return frames.size(); }
+};
@@ -6,110 +6,231 @@
  */
 #pragma once
 #include <vector>
+#include <stdint.h>
 #include "Components.hpp"
 #include "ECS.hpp"
+#include "Broadphase.hpp"
 
 /**
  * @brief A node of a QuadTree.
- * 
+ *
+ * @details
+ * Nodes live in the QuadTree's node array, and refer to each other by index.
+ * The children of a branch form a singly linked list through `nextSibling`.
  */
 struct QuadNode {
+	/**
+	 * @brief Index that refers to no node.
+	 *
+	 */
+	static constexpr uint32_t NONE = UINT32_MAX;
+
 	/**
 	 * @brief The area that the node encompasses.
-	 * 
+	 *
 	 * @details
 	 * If the node is a leaf, this is the area of the entity's hitbox.
 	 * If the node is a branch, this is the area that surrounds the contained leaf nodes.
 	 */
 	Hitbox area;
 
-	/**
-	 * @brief Child nodes of the node.
-	 * 
-	 */
-	std::vector<QuadNode*> nodes;
-
 	/**
 	 * @brief The type of the node.
-	 * 
+	 *
 	 */
-	enum {
+	enum : uint8_t {
 		Leaf, Branch
 	} type = Leaf;
 
 	/**
-	 * @brief The entity id associated with the node's hitbox.
-	 * 
+	 * @brief Handle of the entity associated with the node's hitbox.
+	 *
 	 * @details
-	 * If the node is a leaf, this should never be ECS::NONE.
-	 * If the node is a branch, this should always be ECS::NONE.
+	 * If the node is a leaf, this should never be ECS::NONE_HANDLE.
+	 * If the node is a branch, this should always be ECS::NONE_HANDLE.
+	 */
+	ECS::handle e = ECS::NONE_HANDLE;
+
+	/**
+	 * @brief Number of children of the node.
+	 *
+	 */
+	uint32_t childCount = 0;
+
+	/**
+	 * @brief Index of the first child of the node.
+	 *
+	 */
+	uint32_t firstChild = NONE;
+
+	/**
+	 * @brief Index of the last child of the node. New children are linked after it.
+	 *
 	 */
-	ECS::entity e = ECS::NONE;
+	uint32_t lastChild = NONE;
 
-	QuadNode(Hitbox area) : area(area), type(QuadNode::Branch) {}
-	QuadNode(Hitbox area, ECS::entity e) : area(area), e(e) {}
+	/**
+	 * @brief Index of the next child of the node's parent.
+	 *
+	 */
+	uint32_t nextSibling = NONE;
 
-	~QuadNode() {
-		for (auto node : nodes) { delete node; }
-	}
+	/**
+	 * @brief Index of the branch that the node is a child of.
+	 *
+	 */
+	uint32_t parent = NONE;
 };
 
 /**
  * @brief Data structure that efficiently detects collisions.
- * 
+ *
+ * @details
+ * Every node is stored in one contiguous array. Resetting the tree
+ * keeps the array's memory, so rebuilding it does not allocate once
+ * the array has grown to fit the map.
+ *
+ * Each entity can have at most one hitbox in the tree. Moving it with
+ * update keeps the tree correct, so the tree only needs to be rebuilt
+ * when entities are added or removed.
  */
-struct QuadTree {
+struct QuadTree : public Broadphase {
 	/**
-	 * @brief Starting node of the QuadTree.
-	 * 
+	 * @brief Index of the starting node of the QuadTree.
+	 *
 	 */
-	QuadNode node;
+	static constexpr uint32_t ROOT = 0;
 
 	/**
 	 * @brief Constructor.
-	 * 
+	 *
 	 * @param area Area that the QuadTree encompasses.
 	 */
 	QuadTree(Hitbox area);
 
 	/**
 	 * @brief Insert a value into the QuadTree.
-	 * 
+	 *
 	 * @param box Hitbox of the entity
-	 * @param e The id of the entity
+	 * @param e Handle of the entity
 	 */
-	void insert(Hitbox box, ECS::entity e);
+	void insert(Hitbox box, ECS::handle e) final override;
 
 	/**
 	 * @brief Query for collisions within the QuadTree.
-	 * 
+	 *
 	 * @param box Hitbox of the entity
 	 * @param e The id of the entity (collisions with itself will be ignored)
 	 * @param out A vector of Hitboxes that collide with the entity
 	 */
-	void query(Hitbox box, ECS::entity e, std::vector<Hitbox>& out) const;
+	void query(Hitbox box, ECS::entity e, std::vector<Hitbox>& out) const final override;
 
 	/**
 	 * @brief Query for collisions within the QuadTree.
-	 * 
+	 *
 	 * @param box Hitbox of the entity
 	 * @param e The id of the entity (collisions with itself will be ignored)
-	 * @param out A vector of entities with a hitbox that collides with the entity
+	 * @param out A vector of handles of entities with a hitbox that collides with the entity.
+	 * The entities may have been freed since they were inserted, see GRY_ECS::isAlive.
 	 */
-	void query(Hitbox box, ECS::entity e, std::vector<ECS::entity>& out) const;
+	void query(Hitbox box, ECS::entity e, std::vector<ECS::handle>& out) const final override;
 
 	/**
-	 * @brief Update the parameters of a box in the quadtree.
-	 * 
-	 * @param oldBox The old box's data
-	 * @param newBox The new box's data
+	 * @brief Move the box of an entity in the QuadTree, relocating it to the node it now belongs in.
+	 *
+	 * @details
+	 * Nothing happens if the entity is not in the QuadTree.
+	 *
+	 * @param box The new box's data
 	 * @param e Entity associated with the box
+	 * @return `true` if the box was relocated, `false` if it was updated in place or not found.
 	 */
-	void update(Hitbox oldBox, Hitbox newBox, ECS::entity e);
+	bool update(Hitbox box, ECS::entity e) final override;
+
+	/**
+	 * @brief Check if an entity has a box in the QuadTree.
+	 *
+	 * @param e The entity.
+	 * @return `true` if it does, `false` otherwise.
+	 */
+	bool contains(ECS::entity e) const final override { return e < leaves.size() && leaves[e] != QuadNode::NONE; }
 
 	/**
 	 * @brief Safely resets the QuadTree to an empty state.
-	 * 
+	 *
+	 * @details
+	 * Keeps the memory of the node array, to be reused by later inserts.
+	 */
+	void reset() final override;
+
+	/**
+	 * @brief Reorder the nodes so that the children of each branch are stored next to each other.
+	 *
+	 * @details
+	 * Queries on a compacted tree read the children of a branch in one
+	 * sweep instead of following their links. Call it after a batch of
+	 * inserts or updates, see isCompacted.
+	 */
+	void compact() final override;
+
+	/**
+	 * @brief Check if the tree has not been changed since it was last compacted.
+	 *
+	 * @details
+	 * Updates that leave a box in its node do not count as changes.
+	 *
+	 * @return `true` if it has not, `false` otherwise.
+	 */
+	const bool isCompacted() const final override { return compacted; }
+
+	/**
+	 * @brief Get the number of nodes in use, including the starting node.
+	 *
+	 * @return The node count.
+	 */
+	const std::size_t nodeCount() const final override { return nodes.size(); }
+
+	/**
+	 * @brief Get a node of the QuadTree.
+	 *
+	 * @param index Index of the node, e.g. ROOT.
+	 * @return `const` reference to the node.
+	 */
+	const QuadNode& getNode(uint32_t index) const { return nodes[index]; }
+
+private:
+	/**
+	 * @brief All nodes of the QuadTree. The starting node is at `ROOT`.
+	 *
 	 */
-	void reset();
-};
\ No newline at end of file
+	std::vector<QuadNode> nodes;
+
+	/**
+	 * @brief Array that compact builds the reordered nodes in. Swapped with `nodes` afterwards.
+	 *
+	 */
+	std::vector<QuadNode> scratch;
+
+	/**
+	 * @brief Index of the leaf of each entity, or QuadNode::NONE if it has none.
+	 *
+	 */
+	std::vector<uint32_t> leaves;
+
+	/**
+	 * @brief Whether the children of every branch are stored next to each other, see compact.
+	 *
+	 */
+	bool compacted = true;
+
+	uint32_t createNode(Hitbox area, ECS::handle e);
+	void linkChild(uint32_t parent, uint32_t child);
+	void unlinkChild(uint32_t parent, uint32_t child);
+	void insertNode(uint32_t node, uint32_t leaf);
+	void mergeLeaves(uint32_t node);
+	bool mergeQuadrant(uint32_t node, int quadrant);
+	template<class T>
+	void query(uint32_t node, Hitbox box, ECS::entity e, std::vector<T>& out) const;
+	template<class T>
+	void queryChild(uint32_t child, Hitbox box, ECS::entity e, std::vector<T>& out) const;
+};
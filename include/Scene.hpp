@@ -97,8 +97,22 @@ public:
 	virtual void init() = 0;
 
 	/**
-	 * @brief Update scene.
+	 * @brief Advance the scene's simulation by one fixed tick.
 	 * 
+	 * @details
+	 * Called zero or more times per frame, before `process`, so that the
+	 * simulation moves at the same speed at any frame rate. Each call should
+	 * advance the simulation by `GRY_Game::getTickLength()` seconds.
+	 * 
+	 * Does nothing by default, for scenes that only need `process`.
+	 */
+	virtual void tick() {}
+	/**
+	 * @brief Update scene, once per frame.
+	 * 
+	 * @details
+	 * Rendering of anything simulated in `tick` should blend between
+	 * the last two ticks using `GRY_Game::getInterpolation()`.
 	 */
 	virtual void process() = 0;
 
@@ -53,6 +53,11 @@ public:
 	SceneManager(const SceneManager&) = delete;
 	SceneManager& operator=(const SceneManager&) = delete;
 
+	/**
+	 * @brief Advance the active scene by one simulation tick.
+	 * 
+	 */
+	void tick();
 	/**
 	 * @brief Update active scene and process any transitions.
 	 * 
@@ -6,8 +6,65 @@
  */
 #pragma once
 #include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstddef>
 #include "GRY_Log.hpp"
 
+/**
+ * @brief Memory used by a SparseSet, in bytes.
+ * 
+ */
+struct SparseSetMemory {
+    /**
+     * @brief Bytes used by the sparse pages and the page table.
+     * 
+     */
+    std::size_t sparse = 0;
+
+    /**
+     * @brief Bytes a flat sparse array covering every entity would use.
+     * 
+     */
+    std::size_t flatSparse = 0;
+
+    /**
+     * @brief Bytes reserved by the dense entity array.
+     * 
+     */
+    std::size_t dense = 0;
+
+    /**
+     * @brief Bytes reserved by the component data array.
+     * 
+     * @details
+     * Does not include memory owned by the components themselves.
+     */
+    std::size_t value = 0;
+
+    /**
+     * @brief Number of sparse pages that are allocated.
+     * 
+     */
+    std::size_t pages = 0;
+
+    /**
+     * @brief Total bytes used.
+     * 
+     * @return `sparse + dense + value`.
+     */
+    const std::size_t total() const { return sparse + dense + value; }
+
+    SparseSetMemory& operator+=(const SparseSetMemory& other) {
+        sparse += other.sparse;
+        flatSparse += other.flatSparse;
+        dense += other.dense;
+        value += other.value;
+        pages += other.pages;
+        return *this;
+    }
+};
+
 /**
  * @brief Class template data structure used for storing component data.
  * 
@@ -17,6 +74,12 @@
  * Conceptually, there is a "NONE" entity, which is represented
  * by an entity with the value `SIZE`.
  * 
+ * The sparse array is split into pages of `PAGE_SIZE` entities.
+ * A page is only allocated once an entity in its range is added,
+ * so memory scales with the entities that have been used rather than
+ * with `SIZE`. A page that empties is kept, so entities that are freed
+ * and reused do not reallocate it, until `clear()` releases every page.
+ * 
  * @tparam T Type of the component data.
  * @tparam entity Type of the identifier to use. Must be unsigned integral type.
  * @tparam SIZE Maximum number of elements to contain.
@@ -24,12 +87,33 @@
 template <typename T, typename entity, entity SIZE>
 struct SparseSet {
     /**
-     * @brief Sparse array in the sparse set.
+     * @brief Number of entities covered by one sparse page. Must be a power of two.
+     * 
+     */
+    static constexpr std::size_t PAGE_SIZE = 4096 / sizeof(entity);
+
+    /**
+     * @brief One page of the sparse array.
+     * 
+     */
+    struct Page {
+        /**
+         * @brief Index into the dense arrays for each entity in the page.
+         * 
+         * @details
+         * Unused elements have the value `SIZE`.
+         */
+        std::unique_ptr<entity[]> index;
+    };
+
+    /**
+     * @brief Paged sparse array in the sparse set.
      * 
      * @details
-     * The size is `SIZE + 1` to accomodate the "NONE" entity.
+     * Entities whose page is past the end of the table, or whose page
+     * is not allocated, do not have data in the SparseSet.
      */
-    entity sparse[SIZE+1]{};
+    std::vector<Page> sparse;
 
     /**
      * @brief Dense array in the sparse set.
@@ -46,23 +130,18 @@ struct SparseSet {
     /**
      * @brief Constructor.
      * 
-     * @details
-     * All elements in the sparse array are initialized to `SIZE`.
      */
-    SparseSet() {
-        for (int i = 0; i <= SIZE; i++) {
-            this->sparse[i] = SIZE;
-        }
-    };
+    SparseSet() = default;
 
     SparseSet(const SparseSet&) = delete;
     SparseSet& operator=(const SparseSet&) = delete;
 
     friend void swap(SparseSet& lhs, SparseSet& rhs) {
         using std::swap;
-        swap<entity, SIZE+1>(lhs.sparse, rhs.sparse);
+        swap(lhs.sparse, rhs.sparse);
         swap(lhs.dense, rhs.dense);
         swap(lhs.value, rhs.value);
+        swap(lhs.version, rhs.version);
     }
 
     SparseSet(SparseSet&& other) noexcept { swap(*this, other); }
@@ -74,7 +153,10 @@ struct SparseSet {
      * @return `true` if there is component data for the entity.
      * @return `false` otherwise.
      */
-    const bool contains(entity e) const { return sparse[e] != SIZE; }
+    const bool contains(entity e) const {
+        const std::size_t page = e / PAGE_SIZE;
+        return page < sparse.size() && sparse[page].index && sparse[page].index[e % PAGE_SIZE] != SIZE;
+    }
 
     /**
      * @brief Number of entities with data in this SparseSet.
@@ -83,6 +165,39 @@ struct SparseSet {
      */
     const size_t size() const { return dense.size(); }
 
+    /**
+     * @brief Grow the page table so entities less than `count` can be added without reallocating it.
+     * 
+     * @details
+     * Pages themselves are still only allocated when they are first used.
+     * 
+     * @param count Number of entities to make room for.
+     */
+    void reserve(std::size_t count) {
+        const std::size_t pages = (count + PAGE_SIZE - 1) / PAGE_SIZE;
+        if (pages > sparse.size()) { sparse.resize(pages); }
+    }
+
+    /**
+     * @brief Get the memory used by this SparseSet.
+     * 
+     * @return The memory used, in bytes.
+     */
+    const SparseSetMemory memoryUsage() const {
+        SparseSetMemory memory;
+        memory.sparse = sparse.capacity() * sizeof(Page);
+        for (const Page& page : sparse) {
+            if (page.index) {
+                memory.sparse += PAGE_SIZE * sizeof(entity);
+                memory.pages++;
+            }
+        }
+        memory.flatSparse = ((std::size_t)SIZE + 1) * sizeof(entity);
+        memory.dense = dense.capacity() * sizeof(entity);
+        memory.value = value.capacity() * sizeof(T);
+        return memory;
+    }
+
     /**
      * @brief Add `data` and associate it with `e`.
      * 
@@ -100,9 +215,11 @@ struct SparseSet {
 		GRY_Assert(!contains(e),
 			"[SparseSet] Tried to add an entity that already existed. (%d)\n", e
 		);
-		sparse[e] = (uint8_t)dense.size();
+		Page& page = assurePage(e);
+		page.index[e % PAGE_SIZE] = (entity)dense.size();
 		dense.push_back(e);
 		value.push_back(data);
+		version++;
     }
 
     /**
@@ -121,27 +238,112 @@ struct SparseSet {
 			"[SparseSet] Tried to remove an entity that didn't exist. (%d)\n", e
 		);
 		const auto last = dense.back();
-		std::swap(dense.back(), dense[sparse[e]]);
-		std::swap(value.back(), value[sparse[e]]);
-		std::swap(sparse[last], sparse[e]);
+		std::swap(dense.back(), dense[index(e)]);
+		std::swap(value.back(), value[index(e)]);
+		std::swap(index(last), index(e));
 		dense.pop_back();
 		value.pop_back();
-		sparse[e] = SIZE;
+		index(e) = SIZE;
+		version++;
+    }
+
+    /**
+     * @brief Add `data` to every entity in a range, associating a copy with each.
+     * 
+     * @details
+     * Same as calling `add()` for each entity, but the dense arrays
+     * are only grown once.
+     * 
+     * Logs an error if an entity already has data in the SparseSet,
+     * or if an entity is `ECS::NONE`.
+     * 
+     * @tparam It Iterator type of the range, with `entity` values.
+     * @param first Start of the range.
+     * @param last End of the range.
+     * @param data Data to add.
+     * 
+     * @sa add
+     */
+    template<class It>
+    void addRange(It first, It last, const T& data) {
+        const std::size_t count = std::distance(first, last);
+        dense.reserve(dense.size() + count);
+        value.reserve(value.size() + count);
+        for (; first != last; ++first) {
+            const entity e = *first;
+            GRY_Assert(e != SIZE,
+                "[SparseSet] Tried to add the NONE entity. (%d)\n", e
+            );
+            GRY_Assert(!contains(e),
+                "[SparseSet] Tried to add an entity that already existed. (%d)\n", e
+            );
+            Page& page = assurePage(e);
+            page.index[e % PAGE_SIZE] = (entity)dense.size();
+            dense.push_back(e);
+            value.push_back(data);
+        }
+        version++;
+    }
+
+    /**
+     * @brief Remove the data of every entity in a range.
+     * 
+     * @details
+     * The removed entities are marked in their pages, then the dense
+     * arrays are compacted in one pass, so the cost is linear in the
+     * size of the SparseSet rather than one swap per entity.
+     * The remaining data keeps its relative order.
+     * 
+     * Entities in the range that do not have data are ignored,
+     * including repeated entities.
+     * 
+     * @tparam It Iterator type of the range, with `entity` values.
+     * @param first Start of the range.
+     * @param last End of the range.
+     * 
+     * @sa remove
+     */
+    template<class It>
+    void removeRange(It first, It last) {
+        std::size_t removed = 0;
+        for (; first != last; ++first) {
+            const entity e = *first;
+            if (!contains(e)) { continue; }
+            index(e) = SIZE;
+            removed++;
+        }
+        if (removed == 0) { return; }
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < dense.size(); i++) {
+            const entity e = dense[i];
+            if (index(e) == SIZE) { continue; }
+            if (kept != i) {
+                dense[kept] = e;
+                value[kept] = std::move(value[i]);
+                index(e) = (entity)kept;
+            }
+            kept++;
+        }
+        dense.resize(kept);
+        value.erase(value.begin() + kept, value.end());
+        version++;
     }
 
     /**
      * @brief Remove all component data.
      * 
      * @details
-     * Effectively resets the SparseSet by calling `remove()`
-     * with any entities with data.
+     * Every sparse page is released, including the ones that had already
+     * emptied. The page table itself keeps its size.
      * 
      * @sa remove
      */
-    void removeAll() {
-        std::vector<entity> entities;
-        for (int i = 0; i < dense.size(); i++) { entities.push_back(getEntity(i)); }
-        for (entity e : entities) { remove(e); }
+    void clear() {
+        for (Page& page : sparse) { page.index.reset(); }
+        dense.clear();
+        value.clear();
+        version++;
     }
 
     /**
@@ -161,7 +363,7 @@ struct SparseSet {
 		GRY_Assert(contains(e),
 			"[SparseSet] Tried to access data for an entity that didn't exist. (%d)\n", e
 		);
-		return value[sparse[e]];
+		return value[index(e)];
     }
 
     /**
@@ -179,7 +381,7 @@ struct SparseSet {
 		GRY_Assert(contains(e),
 			"[SparseSet] Tried to access data for an entity that didn't exist. (%d)\n", e
 		);
-		return value[sparse[e]];
+		return value[index(e)];
     }
 
     /**
@@ -195,13 +397,50 @@ struct SparseSet {
      * @param i Index of an entity to retrieve. Must be less than `size()`.
      * @return An entity with data in the SparseSet.
      */
-    const entity getEntity(uint8_t i) const {
+    const entity getEntity(std::size_t i) const {
 		GRY_Assert(i < dense.size(),
-			"[SparseSet] getEntity index out of bounds. (%d)\n", i
+			"[SparseSet] getEntity index out of bounds. (%zu)\n", i
 		);
 		return dense[i];
 	}
 
+    /**
+     * @brief Get the position of `e`'s data in the dense arrays.
+     * 
+     * @param e Entity with data in the SparseSet.
+     * @return Index into `dense` and `value`.
+     */
+    const std::size_t indexOf(entity e) const {
+		GRY_Assert(contains(e),
+			"[SparseSet] Tried to get the index of an entity that didn't exist. (%d)\n", e
+		);
+		return index(e);
+	}
+
+    /**
+     * @brief Swap the positions of two entities in the dense arrays.
+     * 
+     * @details
+     * Used to keep sets in a particular order, see ECSGroup.
+     * Does not change the version of the SparseSet.
+     * 
+     * @param i Index of the first entity.
+     * @param j Index of the second entity.
+     */
+    void swapDense(std::size_t i, std::size_t j) {
+        if (i == j) { return; }
+        std::swap(index(dense[i]), index(dense[j]));
+        std::swap(dense[i], dense[j]);
+        std::swap(value[i], value[j]);
+    }
+
+    /**
+     * @brief Get the number of times data has been added or removed.
+     * 
+     * @return The version.
+     */
+    const std::size_t getVersion() const { return version; }
+
     /**
      * @brief Pointer to the first entity. Useful in range based for loops.
      * 
@@ -216,4 +455,43 @@ struct SparseSet {
      */
     const entity* end() const { return dense.data() + dense.size(); }
 
+private:
+    /**
+     * @brief Number of times data has been added or removed.
+     * 
+     */
+    std::size_t version = 0;
+
+    /**
+     * @brief Get the dense index slot of `e`. The page of `e` must be allocated.
+     * 
+     * @param e Entity to look up.
+     * @return Reference to the slot in the sparse page.
+     */
+    entity& index(entity e) { return sparse[e / PAGE_SIZE].index[e % PAGE_SIZE]; }
+
+    /**
+     * @brief @copybrief index
+     * 
+     * @param e Entity to look up.
+     * @return The slot in the sparse page.
+     */
+    const entity index(entity e) const { return sparse[e / PAGE_SIZE].index[e % PAGE_SIZE]; }
+
+    /**
+     * @brief Get the page of `e`, allocating it if needed.
+     * 
+     * @param e Entity whose page is needed.
+     * @return Reference to the page.
+     */
+    Page& assurePage(entity e) {
+        const std::size_t pageIndex = e / PAGE_SIZE;
+        if (pageIndex >= sparse.size()) { sparse.resize(pageIndex + 1); }
+        Page& page = sparse[pageIndex];
+        if (!page.index) {
+            page.index = std::make_unique<entity[]>(PAGE_SIZE);
+            std::fill_n(page.index.get(), PAGE_SIZE, SIZE);
+        }
+        return page;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,145 @@
+/**
+ * @file SpatialGrid.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief @copybrief SpatialGrid
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "Broadphase.hpp"
+
+/**
+ * @brief Uniform grid of square cells that detects collisions.
+ *
+ * @details
+ * A hitbox is stored in every cell that it overlaps, so a query only has
+ * to look at the cells that the queried box overlaps. This works best when
+ * most hitboxes are about the size of a cell, like actors on a tile map.
+ *
+ * Hitboxes that leave the grid's area are stored in the border cells.
+ * Each cell keeps a copy of its hitboxes, so queries read them sequentially.
+ */
+class SpatialGrid : public Broadphase {
+public:
+	/**
+	 * @brief Constructor.
+	 *
+	 * @param area Area that the grid covers.
+	 * @param cellSize Width and height of a cell, typically a multiple of the tile size.
+	 */
+	SpatialGrid(Hitbox area, float cellSize);
+
+	/**
+	 * @copydoc Broadphase::insert
+	 */
+	void insert(Hitbox box, ECS::handle e) final override;
+
+	/**
+	 * @copydoc Broadphase::query(Hitbox, ECS::entity, std::vector<Hitbox>&) const
+	 */
+	void query(Hitbox box, ECS::entity e, std::vector<Hitbox>& out) const final override;
+
+	/**
+	 * @copydoc Broadphase::query(Hitbox, ECS::entity, std::vector<ECS::handle>&) const
+	 */
+	void query(Hitbox box, ECS::entity e, std::vector<ECS::handle>& out) const final override;
+
+	/**
+	 * @copydoc Broadphase::update
+	 *
+	 * A box is relocated when the set of cells it overlaps changes.
+	 */
+	bool update(Hitbox box, ECS::entity e) final override;
+
+	/**
+	 * @copydoc Broadphase::contains
+	 */
+	bool contains(ECS::entity e) const final override { return e < boxes.size() && boxes[e].e != ECS::NONE_HANDLE; }
+
+	/**
+	 * @copydoc Broadphase::reset
+	 */
+	void reset() final override;
+
+	/**
+	 * @brief Get the number of cells that hold at least one hitbox.
+	 *
+	 * @return The occupied cell count.
+	 */
+	const std::size_t nodeCount() const final override { return occupiedCells; }
+
+	/**
+	 * @brief Get the number of columns of cells.
+	 *
+	 * @return The column count.
+	 */
+	const int getColumns() const { return columns; }
+
+	/**
+	 * @brief Get the number of rows of cells.
+	 *
+	 * @return The row count.
+	 */
+	const int getRows() const { return rows; }
+
+private:
+	/**
+	 * @brief A hitbox stored in a cell.
+	 *
+	 */
+	struct Item {
+		Hitbox box;
+		ECS::handle e;
+	};
+
+	/**
+	 * @brief The current hitbox of an entity, indexed by entity.
+	 *
+	 */
+	struct Entry {
+		Hitbox box;
+		ECS::handle e = ECS::NONE_HANDLE;
+	};
+
+	/**
+	 * @brief Inclusive range of cells, by column and row.
+	 *
+	 */
+	struct CellRange {
+		int x0, y0, x1, y1;
+
+		bool operator==(const CellRange&) const = default;
+	};
+
+	Hitbox area;
+	float invCellSize;
+	int columns;
+	int rows;
+
+	/**
+	 * @brief Hitboxes of each cell, row by row.
+	 *
+	 */
+	std::vector<std::vector<Item>> cells;
+
+	/**
+	 * @brief Current hitbox of each entity, used to find its cells again.
+	 *
+	 */
+	std::vector<Entry> boxes;
+
+	/**
+	 * @brief Number of cells that are not empty.
+	 *
+	 */
+	std::size_t occupiedCells = 0;
+
+	int column(float x) const;
+	int row(float y) const;
+	CellRange cellRange(Hitbox box) const;
+	void addToCells(CellRange range, Item item);
+	void removeFromCells(CellRange range, ECS::entity e);
+	template<class T>
+	void queryCells(Hitbox box, ECS::entity e, std::vector<T>& out) const;
+};
@@ -0,0 +1,101 @@
+/**
+ * @file SweptAABB.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Continuous collision of moving hitboxes against still ones.
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include <vector>
+#include "Components.hpp"
+
+/**
+ * @brief How much two hitboxes have to overlap on an axis before they count as overlapping.
+ *
+ * @details
+ * Hitboxes placed against each other by sweepAndSlide can end up overlapping
+ * by a rounding error, which must not make them pass through each other later.
+ */
+static const float SWEEP_CONTACT_EPSILON = 1.f / 1024.f;
+
+/**
+ * @brief Most times depenetrate goes over the obstacles, for a box pushed from one overlap into another.
+ *
+ */
+static const unsigned MAX_DEPENETRATION_PASSES = 4;
+
+/**
+ * @brief Where a moving hitbox first touches another.
+ *
+ */
+struct SweepHit {
+	/**
+	 * @brief Fraction of the motion, from 0 to 1, at which the hitboxes touch.
+	 *
+	 */
+	float time = 1.f;
+
+	/**
+	 * @brief Axis that the moving hitbox is blocked on, 0 for x and 1 for y, or -1 if there is no hit.
+	 *
+	 */
+	int axis = -1;
+};
+
+/**
+ * @brief Find when a hitbox moving by `motion` hits `other`.
+ *
+ * @details
+ * Hitboxes that already overlap `box` do not block it, so a hitbox
+ * that depenetrate could not push out of another can still move out of it.
+ * Hitboxes that only touch `box` on an edge block it if it moves into them.
+ *
+ * @param box The moving hitbox, before it moves.
+ * @param motion How far the hitbox moves.
+ * @param other The hitbox it might hit.
+ * @return The hit. Its axis is -1 if `box` does not hit `other` within `motion`.
+ */
+SweepHit sweepAABB(Hitbox box, Velocity2 motion, Hitbox other);
+
+/**
+ * @brief Push a hitbox out of the obstacles it overlaps, each along the shortest way out.
+ *
+ * @details
+ * The box is placed against the edge of each obstacle it is pushed out of.
+ * A box wedged between obstacles may be left overlapping some of them.
+ *
+ * @param box The hitbox.
+ * @param obstacles Hitboxes that the box cannot overlap.
+ * @return The pushed out hitbox.
+ */
+Hitbox depenetrate(Hitbox box, const std::vector<Hitbox>& obstacles);
+
+/**
+ * @brief Get the hitbox that covers `box` over the whole of `motion`.
+ *
+ * @details
+ * Anything that sweepAndSlide could hit collides with this box,
+ * so it can be used to query a Broadphase once for all of them.
+ *
+ * @param box The moving hitbox, before it moves.
+ * @param motion How far the hitbox moves.
+ * @return The swept bounds.
+ */
+Hitbox sweptBounds(Hitbox box, Velocity2 motion);
+
+/**
+ * @brief Move a hitbox, stopping against the first obstacle it hits and sliding along it.
+ *
+ * @details
+ * A hitbox that starts inside obstacles is first pushed out with depenetrate.
+ * The hitbox is moved up to the earliest hit, placed exactly against the
+ * obstacle, and then moves the rest of the way along the other axis, which
+ * may stop it at a second obstacle. So no obstacle is ever passed through,
+ * no matter how far the hitbox moves.
+ *
+ * @param box The moving hitbox, before it moves.
+ * @param motion How far the hitbox moves.
+ * @param obstacles Hitboxes that the box cannot move through, typically found with sweptBounds.
+ * @param hit If not `nullptr`, set to the first hit, or a hit with axis -1 if nothing was hit.
+ * @return The moved hitbox.
+ */
+Hitbox sweepAndSlide(Hitbox box, Velocity2 motion, const std::vector<Hitbox>& obstacles, SweepHit* hit = nullptr);
@@ -21,6 +21,30 @@ private:
 
 	ImGuiIO* io;
 
+	/**
+	 * @brief Whether `init` was called, so there is a context to shut down.
+	 * 
+	 */
+	bool initialized = false;
+
+	/**
+	 * @brief File the debugger's CPU profiles are written to.
+	 * 
+	 */
+	static constexpr const char* CPU_PROFILE_PATH = "game.prof";
+
+	/**
+	 * @brief Prefix of the debugger's heap profiles.
+	 * 
+	 */
+	static constexpr const char* HEAP_PROFILE_PREFIX = "game";
+
+	/**
+	 * @brief Show the window that starts and stops gperftools profiles.
+	 * 
+	 */
+	void processGperftools();
+
 public:
 
 	bool active = true;
@@ -38,4 +62,11 @@ public:
 	void render(SDL_Renderer* renderer);
 
 	void toggle() { active = !active; }
+
+	/**
+	 * @brief Whether the debugger was initialized. It is not when the game is headless.
+	 * 
+	 * @return `true` if `init` was called.
+	 */
+	bool isInitialized() const { return initialized; }
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
  * @copyright Copyright (c) 2024
  */
 #include "FPSHandler.hpp"
+#include "GRY_Log.hpp"
 #include "SDL3/SDL.h"
 #include <algorithm>
 
@@ -11,7 +12,8 @@ FPSHandler::FPSHandler(const unsigned int MAX_FPS) :
     MAX_FPS(MAX_FPS),
     frameLength(1000 / MAX_FPS),
     deltaTime(1.0 / MAX_FPS),
-    minDelta(1.0 / MAX_FPS) {
+    minDelta(1.0 / MAX_FPS),
+    tickLength(1.0 / DEFAULT_TICK_RATE) {
 }
 
 void FPSHandler::frameStart() {
@@ -21,10 +23,16 @@ void FPSHandler::frameStart() {
 
 void FPSHandler::computeDelta() {
     /* Delta = current time - frame start time. Divide by performance freq. to get in seconds. */
-    deltaTime = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    advance((double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency());
+}
+
+void FPSHandler::advance(double elapsed) {
+    frameTime = elapsed;
+    /* The simulation is owed the real time that passed, not the clamped delta, so it never runs in slow motion */
+    accumulator += std::min(maxFrameTime, elapsed);
 
     /* Ensure delta is between maxDelta and minDelta. */
-	deltaTime = std::max(minDelta, std::min(maxDelta, deltaTime));
+	deltaTime = std::max(minDelta, std::min(maxDelta, elapsed));
 }
 
 /**
@@ -37,4 +45,16 @@ void FPSHandler::delay() {
     if (timeSinceFrameStart < frameLength) {
         SDL_Delay(frameLength - timeSinceFrameStart);
     }
-}
\ No newline at end of file
+}
+
+void FPSHandler::setTickRate(unsigned int ticksPerSecond) {
+    GRY_Assert(ticksPerSecond > 0, "[FPSHandler] Tick rate must be greater than 0.\n");
+    tickLength = 1.0 / ticksPerSecond;
+    accumulator = 0.0;
+}
+
+bool FPSHandler::tick() {
+    if (accumulator < tickLength) { return false; }
+    accumulator -= tickLength;
+    return true;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file GRY_Atlas.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @copyright Copyright (c) 2025
+ */
+#include "GRY_Atlas.hpp"
+#include "GRY_Texture.hpp"
+#include "GRY_Log.hpp"
+#include "SDL3/SDL_render.h"
+#include <algorithm>
+#include <numeric>
+
+GRY_Atlas::~GRY_Atlas() {
+	for (SDL_Texture* page : pages) { SDL_DestroyTexture(page); }
+}
+
+void GRY_Atlas::add(SDL_Texture*& texture, bool& ownsTexture, std::vector<SDL_FRect>& sourceRects) {
+	if (!texture || !ownsTexture) { return; }
+	entries.push_back(Entry{ &texture, &ownsTexture, sourceRects.data(), sourceRects.size() });
+}
+
+void GRY_Atlas::add(GRY_Texture& texture) {
+	if (!texture.texture || !texture.ownsTexture) { return; }
+	entries.push_back(Entry{ &texture.texture, &texture.ownsTexture, &texture.area, 1 });
+}
+
+/**
+ * @details
+ * Entries are placed tallest first, left to right in rows as tall as their
+ * first entry. A row that would go past the bottom of the page starts a new
+ * page.
+ */
+std::vector<SDL_Point> GRY_Atlas::pack(int pageSize) {
+	std::vector<std::size_t> order(entries.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+		return entries[a].h > entries[b].h;
+	});
+
+	std::vector<SDL_Point> sizes;
+	int page = -1, x = 0, y = 0, rowHeight = 0;
+	for (std::size_t i : order) {
+		Entry& entry = entries[i];
+		if (entry.w > pageSize || entry.h > pageSize) {
+			GRY_Log("[GRY_Atlas] A %dx%d texture does not fit in a page, leaving it out.\n", entry.w, entry.h);
+			continue;
+		}
+
+		if (page >= 0 && x + entry.w > pageSize) {
+			x = 0;
+			y += rowHeight + PADDING;
+			rowHeight = 0;
+		}
+		if (page < 0 || y + entry.h > pageSize) {
+			page++;
+			sizes.push_back(SDL_Point{ 0, 0 });
+			x = y = rowHeight = 0;
+		}
+
+		entry.x = x;
+		entry.y = y;
+		entry.page = page;
+		x += entry.w + PADDING;
+		rowHeight = std::max(rowHeight, entry.h);
+		sizes[page].x = std::max(sizes[page].x, entry.x + entry.w);
+		sizes[page].y = std::max(sizes[page].y, entry.y + entry.h);
+	}
+	return sizes;
+}
+
+/**
+ * @details
+ * The textures are copied without blending, so partly transparent pixels
+ * keep their exact values. The finished page is read back into a static
+ * texture, and the render target is only kept if that fails.
+ */
+SDL_Texture* GRY_Atlas::drawPage(SDL_Renderer* renderer, int page, SDL_Point size) {
+	SDL_Texture* target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+	if (!target) {
+		GRY_Log("[GRY_Atlas] Could not create page texture. Error: %s\n", SDL_GetError());
+		return nullptr;
+	}
+
+	/* Save the renderer state that drawing the page changes */
+	SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+	Uint8 r, g, b, a;
+	SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+	/* Copy the textures */
+	SDL_SetRenderTarget(renderer, target);
+	SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0x00);
+	SDL_RenderClear(renderer);
+	for (const Entry& entry : entries) {
+		if (entry.page != page) { continue; }
+		SDL_BlendMode blendMode;
+		SDL_GetTextureBlendMode(*entry.texture, &blendMode);
+		SDL_SetTextureBlendMode(*entry.texture, SDL_BLENDMODE_NONE);
+		SDL_FRect dstRect{ (float)entry.x, (float)entry.y, (float)entry.w, (float)entry.h };
+		SDL_RenderTexture(renderer, *entry.texture, NULL, &dstRect);
+		SDL_SetTextureBlendMode(*entry.texture, blendMode);
+	}
+
+	/* Read it back, so it does not depend on the render target */
+	SDL_Texture* texture = target;
+	SDL_Surface* surface = SDL_RenderReadPixels(renderer, NULL);
+	if (surface) {
+		SDL_Texture* copy = SDL_CreateTextureFromSurface(renderer, surface);
+		SDL_DestroySurface(surface);
+		if (copy) {
+			SDL_DestroyTexture(target);
+			texture = copy;
+		}
+	}
+	if (texture == target) {
+		GRY_Log("[GRY_Atlas] Could not read back page, it will be lost if render targets are reset. Error: %s\n", SDL_GetError());
+	}
+
+	SDL_SetRenderDrawColor(renderer, r, g, b, a);
+	SDL_SetRenderTarget(renderer, previousTarget);
+
+	SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	return texture;
+}
+
+void GRY_Atlas::build(SDL_Renderer* renderer) {
+	if (entries.empty()) { return; }
+
+	int pageSize = MAX_PAGE_SIZE;
+	SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+	if (props) {
+		pageSize = std::min(pageSize, (int)SDL_GetNumberProperty(props, SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, MAX_PAGE_SIZE));
+	}
+
+	for (Entry& entry : entries) {
+		float w, h;
+		SDL_GetTextureSize(*entry.texture, &w, &h);
+		entry.w = (int)w;
+		entry.h = (int)h;
+	}
+
+	std::vector<SDL_Point> sizes = pack(pageSize);
+	for (int page = 0; page < (int)sizes.size(); page++) {
+		SDL_Texture* texture = drawPage(renderer, page, sizes[page]);
+		if (!texture) { continue; }
+		pages.push_back(texture);
+
+		/* Point the resources at the page */
+		for (Entry& entry : entries) {
+			if (entry.page != page) { continue; }
+			SDL_DestroyTexture(*entry.texture);
+			*entry.texture = texture;
+			*entry.ownsTexture = false;
+			for (std::size_t i = 0; i < entry.rectCount; i++) {
+				entry.rects[i].x += entry.x;
+				entry.rects[i].y += entry.y;
+			}
+		}
+	}
+	entries.clear();
+}
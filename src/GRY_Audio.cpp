@@ -9,8 +9,9 @@ static void GRY_FMODCheck(FMOD_RESULT result) {
 	);
 }
 
-GRY_Audio::GRY_Audio() {
+GRY_Audio::GRY_Audio(bool silent) {
 	GRY_FMODCheck(FMOD_System_Create(&system, FMOD_VERSION));
+	if (silent) { GRY_FMODCheck(FMOD_System_SetOutput(system, FMOD_OUTPUTTYPE_NOSOUND)); }
 
 	GRY_FMODCheck(FMOD_System_Init(system, 512, FMOD_INIT_NORMAL, 0));
 }
@@ -5,7 +5,10 @@
  */
 #include "GRY_Game.hpp"
 #include "GRY_Log.hpp"
+#include "GRY_Gperftools.hpp"
+#include "GRY_Profiler.hpp"
 #include "SDL3/SDL_render.h"
+#include "SDL3/SDL_timer.h"
 #include "imgui.h"
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_sdlrenderer3.h"
@@ -15,8 +18,10 @@
 #include <SDL3/SDL_opengl.h>
 #endif
 
-GRY_Game::GRY_Game(int WINDOW_WIDTH, int WINDOW_HEIGHT, int MAX_FPS, bool USE_VSYNC) :
-	video(WINDOW_WIDTH, WINDOW_HEIGHT, USE_VSYNC), fps(MAX_FPS), imguiDebug(this) {
+GRY_Game::GRY_Game(int WINDOW_WIDTH, int WINDOW_HEIGHT, int MAX_FPS, bool USE_VSYNC, bool HEADLESS) :
+	video(WINDOW_WIDTH, WINDOW_HEIGHT, USE_VSYNC, HEADLESS), audio(HEADLESS), fps(MAX_FPS), imguiDebug(this) {
+
+	GRY_Gperftools::startFromEnvironment();
 
 	if (!video.init()) { 
 		GRY_Log("[Game] GRY_Video initialization failed.\n");
@@ -24,39 +29,120 @@ GRY_Game::GRY_Game(int WINDOW_WIDTH, int WINDOW_HEIGHT, int MAX_FPS, bool USE_VS
 		return;
 	}
 
+	/* There is no window for the debugger to draw in */
+	if (HEADLESS) { return; }
 	imguiDebug.init();
 }
 
+GRY_Game::~GRY_Game() {
+	GRY_Gperftools::stopAll();
+}
+
+/**
+ * @details
+ * Input is read first, then the scenes get the ticks owed from earlier
+ * frames, then this frame's length is measured, or taken from the replay.
+ * runHeadless steps frames in the same order, so a replay drives both
+ * loops through the same ticks with the same input.
+ */
 void GRY_Game::runGame() {
+	const bool windowed = !video.isHeadless();
     auto& gameRenderer = video.gameRenderer;
-	ImGuiIO& io = ImGui::GetIO();
+
+	bool replayed = false;
 
     /* Game loop */
 	while (gameRunning) {
 		/* Mark start time of frame */
 		fps.frameStart();
+		GRY_ProfileFrame();
 
 		/* Clear renderer */
 		SDL_RenderClear(gameRenderer);
+		if (windowed) { beginRender(); }
 
 		/* Handle inputs */
-		input.process(gameRunning);
-		imguiDebug.startFrame();
+		if (windowed) {
+			{ GRY_ProfileScope("Input"); input.process(gameRunning); }
+			imguiDebug.startFrame();
+			{ GRY_ProfileScope("Debugger"); imguiDebug.process(); }
+		}
+		else {
+			input.updateFrame();
+			/* Without a window there is no input after the replay, so stop where runHeadless would */
+			if (input.isReplaying()) { replayed = true; }
+			else if (replayed) { break; }
+		}
 
 		/* Update game */
-		imguiDebug.process();
 		process();
-		scenes.process();
-		audio.process();
-		
-		imguiDebug.render(gameRenderer);
+		updateScenes(UINT64_MAX);
 
-		/* Output */
-		SDL_RenderPresent(gameRenderer);
+		if (windowed) {
+			{ GRY_ProfileScope("End render"); endRender(); }
+			{ GRY_ProfileScope("Debugger render"); imguiDebug.render(gameRenderer); }
 
-		if (!video.USE_VSYNC) { fps.delay(); }
-		fps.computeDelta();
+			/* Output */
+			{ GRY_ProfileScope("Present"); SDL_RenderPresent(gameRenderer); }
+			if (!video.USE_VSYNC) { fps.delay(); }
+		}
+		endFrame();
+	}
+}
+
+double GRY_Game::runHeadless(uint64_t ticks) {
+	GRY_Assert(video.isHeadless(), "[Game] runHeadless was called on a game with a window.\n");
+
+	uint64_t start = SDL_GetPerformanceCounter();
+	uint64_t ran = 0;
+	bool replayed = false;
+	while (ran < ticks && gameRunning) {
+		input.updateFrame();
+		/* Stop at the end of the replay, rather than running on with no input */
+		if (input.isReplaying()) { replayed = true; }
+		else if (replayed) { break; }
+
+		process();
+		ran += updateScenes(ticks - ran);
+		endFrame();
 	}
+	double seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+
+	double ticksPerSecond = seconds > 0 ? ran / seconds : 0;
+	GRY_Log("[Game] Ran %llu ticks (%.1f s of game time) in %.3f s, %.1f ticks per second.\n",
+		(unsigned long long)ran, ran * fps.getTickLength(), seconds, ticksPerSecond
+	);
+	return ticksPerSecond;
+}
+
+/**
+ * @details
+ * The ticks come from the time of the frames before this one, so the
+ * ticks and the per frame update of a frame see the same input.
+ */
+uint64_t GRY_Game::updateScenes(uint64_t maxTicks) {
+	uint64_t ran = 0;
+	/* Simulate in fixed ticks for the time that has passed, then draw between the last two of them */
+	while (ran < maxTicks && fps.tick()) {
+		GRY_ProfileScope("Tick");
+		scenes.tick();
+		ran++;
+	}
+	{ GRY_ProfileScope("Scene"); scenes.process(); }
+	{ GRY_ProfileScope("Audio"); audio.process(); }
+	return ran;
+}
+
+/**
+ * @details
+ * A replayed frame lasts as long as it did when recorded, so the same ticks
+ * run after it. Without a replay, a headless frame lasts one tick.
+ */
+void GRY_Game::endFrame() {
+	if (input.isReplaying()) { fps.advance(input.getReplayDelta()); }
+	else if (video.isHeadless()) { fps.advance(fps.getTickLength()); }
+	else { fps.computeDelta(); }
+	input.recordFrame(fps.getFrameTime());
 }
 
 /**
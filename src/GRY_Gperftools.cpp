@@ -0,0 +1,96 @@
+/**
+ * @file GRY_Gperftools.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @copyright Copyright (c) 2025
+ */
+#include "GRY_Gperftools.hpp"
+#include "GRY_Log.hpp"
+#include <cstdlib>
+#ifdef GRY_GPERFTOOLS
+#include <gperftools/profiler.h>
+#include <gperftools/heap-profiler.h>
+#endif
+
+#ifdef GRY_GPERFTOOLS
+
+bool GRY_Gperftools::isAvailable() { return true; }
+
+bool GRY_Gperftools::startCpuProfile(const char* path) {
+	if (isCpuProfiling()) { return false; }
+	if (!ProfilerStart(path)) {
+		GRY_Log("[Gperftools] Could not start a CPU profile at %s.\n", path);
+		return false;
+	}
+	GRY_Log("[Gperftools] Started a CPU profile at %s.\n", path);
+	return true;
+}
+
+void GRY_Gperftools::stopCpuProfile() {
+	if (!isCpuProfiling()) { return; }
+	ProfilerStop();
+	GRY_Log("[Gperftools] Stopped the CPU profile.\n");
+}
+
+bool GRY_Gperftools::isCpuProfiling() {
+	ProfilerState state;
+	ProfilerGetCurrentState(&state);
+	return state.enabled;
+}
+
+bool GRY_Gperftools::startHeapProfile(const char* prefix) {
+	if (isHeapProfiling()) { return false; }
+	HeapProfilerStart(prefix);
+	GRY_Log("[Gperftools] Started a heap profile at %s.\n", prefix);
+	return true;
+}
+
+void GRY_Gperftools::dumpHeapProfile(const char* reason) {
+	if (isHeapProfiling()) { HeapProfilerDump(reason); }
+}
+
+void GRY_Gperftools::stopHeapProfile() {
+	if (!isHeapProfiling()) { return; }
+	HeapProfilerDump("stop");
+	HeapProfilerStop();
+	GRY_Log("[Gperftools] Stopped the heap profile.\n");
+}
+
+bool GRY_Gperftools::isHeapProfiling() { return IsHeapProfilerRunning(); }
+
+#else
+
+bool GRY_Gperftools::isAvailable() { return false; }
+
+bool GRY_Gperftools::startCpuProfile(const char*) {
+	GRY_Log("[Gperftools] Built without ENABLE_GPERFTOOLS, so no CPU profile can be taken.\n");
+	return false;
+}
+
+void GRY_Gperftools::stopCpuProfile() {}
+
+bool GRY_Gperftools::isCpuProfiling() { return false; }
+
+bool GRY_Gperftools::startHeapProfile(const char*) {
+	GRY_Log("[Gperftools] Built without ENABLE_GPERFTOOLS, so no heap profile can be taken.\n");
+	return false;
+}
+
+void GRY_Gperftools::dumpHeapProfile(const char*) {}
+
+void GRY_Gperftools::stopHeapProfile() {}
+
+bool GRY_Gperftools::isHeapProfiling() { return false; }
+
+#endif
+
+void GRY_Gperftools::startFromEnvironment() {
+	const char* cpuPath = getenv(CPU_PROFILE_ENV);
+	if (cpuPath && *cpuPath) { startCpuProfile(cpuPath); }
+	const char* heapPrefix = getenv(HEAP_PROFILE_ENV);
+	if (heapPrefix && *heapPrefix) { startHeapProfile(heapPrefix); }
+}
+
+void GRY_Gperftools::stopAll() {
+	stopCpuProfile();
+	stopHeapProfile();
+}
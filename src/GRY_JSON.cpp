@@ -25,7 +25,7 @@ void GRY_JSON::loadDoc(Document& doc, const char* path) {
 	if (!fp) { return; }
     /* Create a buffer, and pass it into the stream with the file */
     char* readBuffer = new char[BUFFER_SIZE];
-    rapidjson::FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+    rapidjson::FileReadStream is(fp, readBuffer, BUFFER_SIZE);
 
     /* Parse the doc */
     doc.ParseStream(is);
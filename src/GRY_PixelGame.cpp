@@ -5,17 +5,41 @@
  */
 #include "GRY_PixelGame.hpp"
 #include "GRY_JSON.hpp"
+#include "GRY_Log.hpp"
+#include "SDL3/SDL_render.h"
 
 static const char* PIXEL_GAME_CONFIG_PATH = "config/pixelGameConfig.json";
 
-GRY_PixelGame::GRY_PixelGame(int WINDOW_WIDTH, int WINDOW_HEIGHT, int MAX_FPS, bool USE_VSYNC) : 
-	GRY_Game(WINDOW_WIDTH, WINDOW_HEIGHT, MAX_FPS, USE_VSYNC) {
+GRY_PixelGame::GRY_PixelGame(int WINDOW_WIDTH, int WINDOW_HEIGHT, int MAX_FPS, bool USE_VSYNC, bool HEADLESS) : 
+	GRY_Game(WINDOW_WIDTH, WINDOW_HEIGHT, MAX_FPS, USE_VSYNC, HEADLESS) {
 	GRY_JSON::Document doc;
 	GRY_JSON::loadDoc(doc, PIXEL_GAME_CONFIG_PATH);
 
 	SCREEN_WIDTH_PIXELS = doc["SCREEN_WIDTH_PIXELS"].GetUint();
 	SCREEN_HEIGHT_PIXELS = doc["SCREEN_HEIGHT_PIXELS"].GetUint();
+	if (doc.HasMember("TICK_RATE")) { fps.setTickRate(doc["TICK_RATE"].GetUint()); }
 
+	updatePixelScaling();
+
+	/* Nothing is drawn to the screen when headless */
+	if (HEADLESS || !gameRunning) { return; }
+	screenTarget = SDL_CreateTexture(video.getRenderer(), SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+		SCREEN_WIDTH_PIXELS, SCREEN_HEIGHT_PIXELS
+	);
+	if (!screenTarget) {
+		GRY_Log("[GRY_PixelGame] Could not create screen texture. Error: %s\n", SDL_GetError());
+		gameRunning = false;
+		return;
+	}
+	SDL_SetTextureScaleMode(screenTarget, SDL_SCALEMODE_NEAREST);
+	SDL_SetTextureBlendMode(screenTarget, SDL_BLENDMODE_NONE);
+}
+
+GRY_PixelGame::~GRY_PixelGame() {
+	SDL_DestroyTexture(screenTarget);
+}
+
+void GRY_PixelGame::updatePixelScaling() {
 	int w;
 	video.getWindowSize(&w, NULL);
 	pixelScaling = w / (float)SCREEN_WIDTH_PIXELS;
@@ -28,12 +52,25 @@ GRY_PixelGame::GRY_PixelGame(int WINDOW_WIDTH, int WINDOW_HEIGHT, int MAX_FPS, b
  * Toggles the debug screen if SELECT is pressed while START is being pressed.
  */
 void GRY_PixelGame::process() {
-	int w;
-	video.getWindowSize(&w, NULL);
-	pixelScaling = w / (float)SCREEN_WIDTH_PIXELS;
-	pixelScaling = SDL_ceilf(pixelScaling);
+	updatePixelScaling();
 
 	if (input.isPressingVButton(GAME_START) && input.getSingleInputVButton() == GAME_SELECT) {
 		imguiDebug.toggle();
 	}
 }
+
+void GRY_PixelGame::beginRender() {
+	SDL_SetRenderTarget(video.getRenderer(), screenTarget);
+	SDL_RenderClear(video.getRenderer());
+}
+
+/**
+ * @details
+ * The texture is copied without blending, so whatever alpha the scenes left
+ * in it does not matter.
+ */
+void GRY_PixelGame::endRender() {
+	SDL_SetRenderTarget(video.getRenderer(), NULL);
+	SDL_FRect dstRect{ 0, 0, SCREEN_WIDTH_PIXELS * pixelScaling, SCREEN_HEIGHT_PIXELS * pixelScaling };
+	SDL_RenderTexture(video.getRenderer(), screenTarget, NULL, &dstRect);
+}
@@ -0,0 +1,161 @@
+/**
+ * @file GRY_Profiler.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @copyright Copyright (c) 2025
+ */
+#include "GRY_Profiler.hpp"
+#include "GRY_Log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace {
+	/**
+	 * @brief Ring buffer of frames, allocated by the first call to beginFrame.
+	 *
+	 */
+	std::vector<GRY_Profiler::Frame> frames;
+
+	/**
+	 * @brief Index in `frames` of the frame being recorded.
+	 *
+	 */
+	std::size_t current = 0;
+
+	/**
+	 * @brief Number of finished frames in `frames`.
+	 *
+	 */
+	std::size_t finished = 0;
+
+	/**
+	 * @brief Number of zones that have begun but not ended.
+	 *
+	 */
+	uint32_t depth = 0;
+
+	/**
+	 * @brief Whether a frame is being recorded.
+	 *
+	 */
+	bool recording = false;
+
+	/**
+	 * @brief Whether recording was stopped with setPaused.
+	 *
+	 */
+	bool paused = false;
+
+	const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+	uint64_t now() {
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+	}
+
+	/**
+	 * @brief Write a Chrome trace "complete" event, with times in microseconds.
+	 *
+	 */
+	void writeEvent(FILE* file, bool& first, const char* name, uint64_t start, uint64_t end, uint32_t depth) {
+		fprintf(file, "%s\n{\"name\":\"", first ? "" : ",");
+		for (const char* c = name; *c; c++) {
+			if (*c == '"' || *c == '\\') { fputc('\\', file); }
+			fputc(*c, file);
+		}
+		fprintf(file, "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1,\"args\":{\"depth\":%u}}",
+			start / 1000.0, (end - start) / 1000.0, depth
+		);
+		first = false;
+	}
+}
+
+/**
+ * @details
+ * The frame being recorded is not counted as finished until the next one
+ * begins, so the ring holds at most `FRAME_HISTORY - 1` finished frames.
+ */
+void GRY_Profiler::beginFrame() {
+	if (paused) { return; }
+	if (frames.empty()) { frames.resize(FRAME_HISTORY); }
+
+	uint64_t time = now();
+	if (recording) {
+		frames[current].end = time;
+		current = (current + 1) % FRAME_HISTORY;
+		finished = std::min(finished + 1, FRAME_HISTORY - 1);
+	}
+
+	Frame& frame = frames[current];
+	frame.start = time;
+	frame.end = 0;
+	frame.zoneCount = 0;
+	depth = 0;
+	recording = true;
+}
+
+std::size_t GRY_Profiler::beginZone(const char* name) {
+	if (!recording) { return MAX_ZONES; }
+	Frame& frame = frames[current];
+	if (frame.zoneCount == MAX_ZONES) { return MAX_ZONES; }
+
+	frame.zones[frame.zoneCount] = Zone{ name, now(), 0, depth };
+	depth++;
+	return frame.zoneCount++;
+}
+
+void GRY_Profiler::endZone(std::size_t zone) {
+	if (!recording || zone >= frames[current].zoneCount) { return; }
+	frames[current].zones[zone].end = now();
+	depth--;
+}
+
+/**
+ * @details
+ * The frame that was being recorded when pausing is thrown away,
+ * and recording starts again at the next call to beginFrame.
+ */
+void GRY_Profiler::setPaused(bool pause) {
+	paused = pause;
+	if (pause) { recording = false; }
+}
+
+bool GRY_Profiler::isPaused() { return paused; }
+
+std::size_t GRY_Profiler::frameCount() { return finished; }
+
+const GRY_Profiler::Frame& GRY_Profiler::getFrame(std::size_t age) {
+	GRY_Assert(age < finished, "[GRY_Profiler] Tried to get frame %zu, but only %zu are kept.\n", age, finished);
+	return frames[(current + FRAME_HISTORY - 1 - age) % FRAME_HISTORY];
+}
+
+/**
+ * @details
+ * Each frame becomes a "Frame" event, and each of its zones an event nested
+ * in it, oldest frame first.
+ */
+bool GRY_Profiler::exportChromeTrace(const char* path) {
+	FILE* file = fopen(path, "w");
+	if (!file) {
+		GRY_Log("[GRY_Profiler] Could not open %s.\n", path);
+		return false;
+	}
+
+	fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	bool first = true;
+	for (std::size_t age = finished; age-- > 0;) {
+		const Frame& frame = getFrame(age);
+		writeEvent(file, first, "Frame", frame.start, frame.end, 0);
+		for (std::size_t i = 0; i < frame.zoneCount; i++) {
+			const Zone& zone = frame.zones[i];
+			/* Zones still open at the end of the frame are cut off there */
+			writeEvent(file, first, zone.name, zone.start, zone.end ? zone.end : frame.end, zone.depth + 1);
+		}
+	}
+	fprintf(file, "\n]}\n");
+
+	bool written = !ferror(file);
+	fclose(file);
+	if (written) { GRY_Log("[GRY_Profiler] Wrote %zu frames to %s.\n", finished, path); }
+	return written;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file GRY_RenderBatch.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @copyright Copyright (c) 2025
+ */
+#include "GRY_RenderBatch.hpp"
+
+static const SDL_FColor WHITE{ 1.f, 1.f, 1.f, 1.f };
+
+/**
+ * @brief Corners of a quad for its two triangles, in the order they are added.
+ *
+ */
+static const int QUAD_INDICES[6] = { 0, 1, 2, 0, 2, 3 };
+
+void GRY_RenderBatch::add(SDL_Texture* quadTexture, const SDL_FRect& srcRect, const SDL_FRect& dstRect) {
+	if (!quadTexture) { return; }
+	if (quadTexture != texture) {
+		flush();
+		texture = quadTexture;
+		SDL_GetTextureSize(texture, &textureWidth, &textureHeight);
+	}
+
+	const float u0 = srcRect.x / textureWidth;
+	const float v0 = srcRect.y / textureHeight;
+	const float u1 = (srcRect.x + srcRect.w) / textureWidth;
+	const float v1 = (srcRect.y + srcRect.h) / textureHeight;
+	const float x1 = dstRect.x + dstRect.w;
+	const float y1 = dstRect.y + dstRect.h;
+
+	const int first = (int)vertices.size();
+	vertices.push_back(SDL_Vertex{ { dstRect.x, dstRect.y }, WHITE, { u0, v0 } });
+	vertices.push_back(SDL_Vertex{ { x1, dstRect.y }, WHITE, { u1, v0 } });
+	vertices.push_back(SDL_Vertex{ { x1, y1 }, WHITE, { u1, v1 } });
+	vertices.push_back(SDL_Vertex{ { dstRect.x, y1 }, WHITE, { u0, v1 } });
+	for (int corner : QUAD_INDICES) { indices.push_back(first + corner); }
+}
+
+void GRY_RenderBatch::flush() {
+	if (vertices.empty()) { return; }
+	SDL_RenderGeometry(renderer, texture, vertices.data(), (int)vertices.size(), indices.data(), (int)indices.size());
+	current.drawCalls++;
+	current.vertices += vertices.size();
+	vertices.clear();
+	indices.clear();
+}
+
+/**
+ * @details
+ * The texture is looked up again next frame, in case it was destroyed
+ * and another one was made at the same address.
+ */
+void GRY_RenderBatch::endFrame() {
+	flush();
+	texture = nullptr;
+	last = current;
+	current = Stats{};
+}
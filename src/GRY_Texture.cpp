@@ -8,7 +8,7 @@
 #include "SDL3/SDL_render.h"
 
 GRY_Texture::~GRY_Texture() {
-	SDL_DestroyTexture(texture);
+	if (ownsTexture) { SDL_DestroyTexture(texture); }
 	texture = nullptr;
 }
 
@@ -17,5 +17,6 @@ bool GRY_Texture::load(GRY_Game* game) {
     if (texture) { return true; }
 
     texture = game->getVideo().loadTexture(path);
+    if (texture) { SDL_GetTextureSize(texture, &area.w, &area.h); }
     return false;
 }
\ No newline at end of file
@@ -8,15 +8,18 @@
 #include "SDL3/SDL.h"
 #include "SDL3_image/SDL_image.h"
 
-GRY_Video::GRY_Video(int WINDOW_WIDTH, int WINDOW_HEIGHT, bool USE_VSYNC) : 
+GRY_Video::GRY_Video(int WINDOW_WIDTH, int WINDOW_HEIGHT, bool USE_VSYNC, bool HEADLESS) : 
 	WINDOW_WIDTH(WINDOW_WIDTH),
 	WINDOW_HEIGHT(WINDOW_HEIGHT),
-	USE_VSYNC(USE_VSYNC) {
+	USE_VSYNC(USE_VSYNC),
+	HEADLESS(HEADLESS) {
 }
 
 GRY_Video::~GRY_Video() { exit(); }
 
 bool GRY_Video::init() {
+	if (HEADLESS) { return initHeadless(); }
+
 	/* Initialize SDL */
 	if (SDL_Init(SDL_INIT_VIDEO) < 0) {
 		GRY_Log("Could not initialize SDL. Error: %s\n", SDL_GetError());
@@ -58,12 +61,36 @@ bool GRY_Video::init() {
 	return true;
 }
 
+/**
+ * @details
+ * The video subsystem is not initialized, since there may be no display at all.
+ * Software renderers work without it, and textures made with one behave the same
+ * as any other, so resources load exactly like they do with a window.
+ */
+bool GRY_Video::initHeadless() {
+	headlessTarget = SDL_CreateSurface(WINDOW_WIDTH, WINDOW_HEIGHT, SDL_PIXELFORMAT_RGBA32);
+	if (headlessTarget == NULL) {
+		GRY_Log("Could not create headless surface. Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	gameRenderer = SDL_CreateSoftwareRenderer(headlessTarget);
+	if (gameRenderer == NULL) {
+		GRY_Log("Could not create software renderer. Error: %s\n", SDL_GetError());
+		return false;
+	}
+	GRY_Log("[GRY_Video] Running headless.\n");
+	return true;
+}
+
 void GRY_Video::exit() {	
 	/* Free renderer and window. */
 	SDL_DestroyRenderer(gameRenderer);
 	SDL_DestroyWindow(gameWindow);
+	SDL_DestroySurface(headlessTarget);
 	gameRenderer = NULL;
 	gameWindow = NULL;
+	headlessTarget = NULL;
 
 	/* Close SDL subsystems */
 	SDL_Quit();
@@ -103,6 +130,11 @@ void GRY_Video::toggleFullscreen() {
 }
 
 void GRY_Video::getWindowSize(int *w, int *h) {
+	if (HEADLESS) {
+		if (w) { *w = WINDOW_WIDTH; }
+		if (h) { *h = WINDOW_HEIGHT; }
+		return;
+	}
 	SDL_GetWindowSize(gameWindow, w, h);	
 }
 
@@ -147,13 +147,44 @@ void InputHandler::process(bool& gameRunning) {
 			break;
 		case SDL_EVENT_KEY_UP:
 			break;
+		case SDL_EVENT_RENDER_TARGETS_RESET:
+		case SDL_EVENT_RENDER_DEVICE_RESET:
+			renderTargetResets++;
+			break;
 		default:
 			break;
 		}
 	}
 
 	/* Remove from `inputs` until an active input is found */
-	while (!inputs.empty() && !isPressingVButton(inputs.back())) {
+	while (!inputs.empty() && !isHoldingVButton(inputs.back())) {
 		inputs.pop_back();
 	}
+
+	updateFrame();
+}
+
+/**
+ * @details
+ * A replayed frame replaces the live one entirely, so everything that reads
+ * input sees exactly what was recorded.
+ */
+void InputHandler::updateFrame() {
+	if (const InputFrame* recorded = replay.next()) {
+		frame = *recorded;
+		replaying = true;
+		return;
+	}
+	if (replaying) {
+		GRY_Log("[InputHandler] Replay finished after %zu frames.\n", replay.size());
+		replaying = false;
+	}
+
+	frame.pressed = 0;
+	for (int b = 1; b < VirtualButton::VIRTUAL_BUTTON_SIZE; b++) {
+		if (isHoldingVButton(static_cast<VirtualButton>(b))) { frame.pressed |= (uint16_t)(1 << b); }
+	}
+	frame.latest = inputs.size() ? inputs.back() : VirtualButton::GAME_NONE;
+	frame.single = singleInput;
+	frame.delta = 0.0;
 }
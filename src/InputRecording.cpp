@@ -0,0 +1,106 @@
+/**
+ * @file InputRecording.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @copyright Copyright (c) 2025
+ */
+#include "InputRecording.hpp"
+#include "GRY_Log.hpp"
+#include <cstring>
+
+static const char RECORDING_MAGIC[4] = { 'G', 'R', 'Y', 'I' };
+static const uint8_t RECORDING_VERSION = 1;
+static const std::size_t HEADER_SIZE = 6;
+static const std::size_t FRAME_SIZE = 12;
+
+static void encodeFrame(const InputFrame& frame, uint8_t* bytes) {
+	uint64_t delta;
+	memcpy(&delta, &frame.delta, sizeof(delta));
+	bytes[0] = (uint8_t)frame.pressed;
+	bytes[1] = (uint8_t)(frame.pressed >> 8);
+	bytes[2] = (uint8_t)frame.latest;
+	bytes[3] = (uint8_t)frame.single;
+	for (int i = 0; i < 8; i++) { bytes[4 + i] = (uint8_t)(delta >> (8 * i)); }
+}
+
+static bool decodeFrame(const uint8_t* bytes, InputFrame& frame) {
+	if (bytes[2] >= VirtualButton::VIRTUAL_BUTTON_SIZE || bytes[3] >= VirtualButton::VIRTUAL_BUTTON_SIZE) { return false; }
+	uint64_t delta = 0;
+	for (int i = 0; i < 8; i++) { delta |= (uint64_t)bytes[4 + i] << (8 * i); }
+	frame.pressed = (uint16_t)(bytes[0] | bytes[1] << 8);
+	frame.latest = static_cast<VirtualButton>(bytes[2]);
+	frame.single = static_cast<VirtualButton>(bytes[3]);
+	memcpy(&frame.delta, &delta, sizeof(delta));
+	return true;
+}
+
+bool InputRecorder::open(const char* path) {
+	close();
+	file = fopen(path, "wb");
+	if (!file) {
+		GRY_Log("[InputRecorder] Could not open %s for recording.\n", path);
+		return false;
+	}
+	uint8_t header[HEADER_SIZE];
+	memcpy(header, RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+	header[4] = RECORDING_VERSION;
+	header[5] = VirtualButton::VIRTUAL_BUTTON_SIZE;
+	fwrite(header, 1, HEADER_SIZE, file);
+	return true;
+}
+
+void InputRecorder::record(const InputFrame& frame) {
+	if (!file) { return; }
+	uint8_t bytes[FRAME_SIZE];
+	encodeFrame(frame, bytes);
+	fwrite(bytes, 1, FRAME_SIZE, file);
+}
+
+void InputRecorder::close() {
+	if (!file) { return; }
+	fclose(file);
+	file = nullptr;
+}
+
+/**
+ * @details
+ * Recordings made with a different set of VirtualButtons are rejected,
+ * since their bitmasks would not mean the same buttons.
+ * A partly written last frame, left by a game that did not close its
+ * recording, is ignored.
+ */
+bool InputReplay::load(const char* path) {
+	frames.clear();
+	position = 0;
+
+	FILE* file = fopen(path, "rb");
+	if (!file) {
+		GRY_Log("[InputReplay] Could not open %s.\n", path);
+		return false;
+	}
+
+	uint8_t header[HEADER_SIZE];
+	if (fread(header, 1, HEADER_SIZE, file) != HEADER_SIZE || memcmp(header, RECORDING_MAGIC, sizeof(RECORDING_MAGIC))) {
+		GRY_Log("[InputReplay] %s is not an input recording.\n", path);
+		fclose(file);
+		return false;
+	}
+	if (header[4] != RECORDING_VERSION || header[5] != VirtualButton::VIRTUAL_BUTTON_SIZE) {
+		GRY_Log("[InputReplay] %s was recorded with a different version of the game.\n", path);
+		fclose(file);
+		return false;
+	}
+
+	uint8_t bytes[FRAME_SIZE];
+	InputFrame frame;
+	while (fread(bytes, 1, FRAME_SIZE, file) == FRAME_SIZE) {
+		if (!decodeFrame(bytes, frame)) {
+			GRY_Log("[InputReplay] %s has an invalid frame at %zu.\n", path, frames.size());
+			frames.clear();
+			fclose(file);
+			return false;
+		}
+		frames.push_back(frame);
+	}
+	fclose(file);
+	return true;
+}
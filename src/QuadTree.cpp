@@ -1,158 +1,258 @@
 #include "QuadTree.hpp"
 #include "GRY_Log.hpp"
+#include <algorithm>
+#include <type_traits>
 
 static const unsigned int THRESHOLD = 6;
 static const unsigned int NUM_QUADRANTS = 4;
 static const float MIN_BOX_SIZE = 2.0f;
 
-static void query(const QuadNode* node, Hitbox box, ECS::entity e, std::vector<Hitbox>& out);
-static void query(const QuadNode* node, Hitbox box, ECS::entity e, std::vector<ECS::entity>& out);
-static bool update(QuadNode* node, Hitbox oldBox, Hitbox newBox, ECS::entity e);
-static void insert(QuadNode* node, Hitbox box, ECS::entity e);
-static void mergeLeaves(QuadNode* node);
-
 static Hitbox quadrantRect(Hitbox box, int quadrant);
 static bool isWithin(const Hitbox outerBox, const Hitbox innerBox);
+static bool collides(const Hitbox box, const Hitbox other);
+static int quadrantOf(const Hitbox area, const Hitbox box);
 
-QuadTree::QuadTree(Hitbox area) : node(area) {
+QuadTree::QuadTree(Hitbox area) {
+	reset();
+	nodes[ROOT].area = area;
 }
 
-void QuadTree::insert(Hitbox box, ECS::entity e) {
-	::insert(&node, box, e);
+void QuadTree::insert(Hitbox box, ECS::handle e) {
+	uint32_t leaf = createNode(box, e);
+	if (e.index >= leaves.size()) { leaves.resize(e.index + 1, QuadNode::NONE); }
+	leaves[e.index] = leaf;
+	insertNode(ROOT, leaf);
 }
 
 void QuadTree::query(Hitbox box, ECS::entity e, std::vector<Hitbox>& out) const {
-	::query(&node, box, e, out);
+	query<Hitbox>(ROOT, box, e, out);
 }
 
-void QuadTree::query(Hitbox box, ECS::entity e, std::vector<ECS::entity>& out) const {
-	::query(&node, box, e, out);
+void QuadTree::query(Hitbox box, ECS::entity e, std::vector<ECS::handle>& out) const {
+	query<ECS::handle>(ROOT, box, e, out);
 }
 
 /**
  * @details
- * 
- * This function will not rebuild the Quadtree. Therefore, any queries
- * may become inaccurate if the new box would normally be inserted into
- * a different node.
- * This function is intended mainly for small movements.
- * Larger updates may be tolerable if they are not constantly being used.
+ * A leaf can stay where it is as long as its branch still contains it,
+ * and it falls in the same quadrant of that branch as before, since
+ * that is all that insertion looks at. Otherwise it is unlinked,
+ * branches that were left empty are unlinked too, and the leaf is
+ * inserted again from the closest ancestor that contains it.
  */
-void QuadTree::update(Hitbox oldBox, Hitbox newBox, ECS::entity e) {
-	::update(&node, oldBox, newBox, e);
+bool QuadTree::update(Hitbox box, ECS::entity e) {
+	if (!contains(e)) { return false; }
+	uint32_t leaf = leaves[e];
+	uint32_t parent = nodes[leaf].parent;
+	Hitbox oldBox = nodes[leaf].area;
+	nodes[leaf].area = box;
+
+	const Hitbox& area = nodes[parent].area;
+	if ((parent == ROOT || isWithin(area, box)) && quadrantOf(area, oldBox) == quadrantOf(area, box)) {
+		return false;
+	}
+
+	uint32_t ancestor = parent;
+	while (ancestor != ROOT && !isWithin(nodes[ancestor].area, box)) {
+		ancestor = nodes[ancestor].parent;
+	}
+	unlinkChild(parent, leaf);
+	while (parent != ROOT && parent != ancestor && nodes[parent].childCount == 0) {
+		uint32_t next = nodes[parent].parent;
+		unlinkChild(next, parent);
+		parent = next;
+	}
+	insertNode(ancestor, leaf);
+	return true;
 }
 
 void QuadTree::reset() {
-	for (auto child : node.nodes) { delete child; }
-	node.nodes.clear();
+	Hitbox area = nodes.empty() ? Hitbox{} : nodes[ROOT].area;
+	nodes.clear();
+	nodes.push_back(QuadNode{ .area = area, .type = QuadNode::Branch });
+	std::fill(leaves.begin(), leaves.end(), QuadNode::NONE);
+	compacted = true;
 }
 
-void query(const QuadNode *node, Hitbox box, ECS::entity e, std::vector<Hitbox> &out) {
-	auto collides = [box](const Hitbox other) {
-		return
-			box.x + box.w > other.x &&
-			box.x < other.x + other.w &&
-			box.y + box.h > other.y &&
-			box.y < other.y + other.h;
-	};
-
-	for (auto child : node->nodes) {
-		if (!collides(child->area)) { continue; }
-
-		if (child->type == QuadNode::Leaf && child->e != e) {
-			out.push_back(child->area);
+/**
+ * @details
+ * Copies the nodes into `scratch` breadth-first, so the children of every
+ * branch end up next to each other, then swaps the two arrays.
+ * Nodes that were unlinked by update are not copied.
+ * The links stay valid, so the tree can still be inserted into afterwards.
+ */
+void QuadTree::compact() {
+	scratch.clear();
+	scratch.push_back(nodes[ROOT]);
+	for (uint32_t head = 0; head < scratch.size(); head++) {
+		uint32_t child = scratch[head].firstChild;
+		if (child == QuadNode::NONE) { continue; }
+		scratch[head].firstChild = (uint32_t)scratch.size();
+		while (child != QuadNode::NONE) {
+			scratch.push_back(nodes[child]);
+			scratch.back().nextSibling = (uint32_t)scratch.size();
+			scratch.back().parent = head;
+			if (nodes[child].type == QuadNode::Leaf) { leaves[nodes[child].e.index] = (uint32_t)(scratch.size() - 1); }
+			child = nodes[child].nextSibling;
 		}
-		else { query(child, box, e, out); }
+		scratch.back().nextSibling = QuadNode::NONE;
+		scratch[head].lastChild = (uint32_t)(scratch.size() - 1);
 	}
+	nodes.swap(scratch);
+	compacted = true;
 }
 
-void query(const QuadNode *node, Hitbox box, ECS::entity e, std::vector<ECS::entity> &out) {
-	auto collides = [box](const Hitbox other) {
-		return
-			box.x + box.w > other.x &&
-			box.x < other.x + other.w &&
-			box.y + box.h > other.y &&
-			box.y < other.y + other.h;
-	};
+uint32_t QuadTree::createNode(Hitbox area, ECS::handle e) {
+	nodes.push_back(QuadNode{
+		.area = area,
+		.type = e == ECS::NONE_HANDLE ? QuadNode::Branch : QuadNode::Leaf,
+		.e = e
+	});
+	return (uint32_t)(nodes.size() - 1);
+}
+
+void QuadTree::linkChild(uint32_t parent, uint32_t child) {
+	QuadNode& node = nodes[parent];
+	compacted = false;
+	nodes[child].parent = parent;
+	nodes[child].nextSibling = QuadNode::NONE;
+	if (node.lastChild == QuadNode::NONE) { node.firstChild = child; }
+	else { nodes[node.lastChild].nextSibling = child; }
+	node.lastChild = child;
+	node.childCount++;
+}
 
-	for (auto child : node->nodes) {
-		if (!collides(child->area)) { continue; }
+void QuadTree::unlinkChild(uint32_t parent, uint32_t child) {
+	QuadNode& node = nodes[parent];
+	compacted = false;
+	uint32_t prev = QuadNode::NONE;
+	for (uint32_t i = node.firstChild; i != child; i = nodes[i].nextSibling) { prev = i; }
+	if (prev == QuadNode::NONE) { node.firstChild = nodes[child].nextSibling; }
+	else { nodes[prev].nextSibling = nodes[child].nextSibling; }
+	if (node.lastChild == child) { node.lastChild = prev; }
+	node.childCount--;
+	nodes[child].nextSibling = QuadNode::NONE;
+}
 
-		if (child->type == QuadNode::Leaf && child->e != e) {
-			out.push_back(child->e);
+template<class T>
+void QuadTree::query(uint32_t node, Hitbox box, ECS::entity e, std::vector<T>& out) const {
+	/* When compacted, the children are next to each other and can be read without following links */
+	if (compacted) {
+		for (uint32_t i = nodes[node].firstChild, end = i + nodes[node].childCount; i != end; i++) {
+			queryChild(i, box, e, out);
+		}
+	}
+	else {
+		for (uint32_t i = nodes[node].firstChild; i != QuadNode::NONE; i = nodes[i].nextSibling) {
+			queryChild(i, box, e, out);
 		}
-		else { query(child, box, e, out); }
 	}
 }
 
-bool update(QuadNode* node, Hitbox oldBox, Hitbox newBox, ECS::entity e) {
-	auto collides = [oldBox](const Hitbox other) {
-		return
-			oldBox.x + oldBox.w > other.x &&
-			oldBox.x < other.x + other.w &&
-			oldBox.y + oldBox.h > other.y &&
-			oldBox.y < other.y + other.h;
-	};
-	for (auto child : node->nodes) {
-		if (!collides(child->area)) { continue; }
+template<class T>
+inline void QuadTree::queryChild(uint32_t i, Hitbox box, ECS::entity e, std::vector<T>& out) const {
+	const QuadNode& child = nodes[i];
+	if (!collides(box, child.area)) { return; }
 
-		if (child->type == QuadNode::Leaf && child->e == e) {
-			child->area = newBox;
-			return true;
-		}
-		else if (update(child, oldBox, newBox, e)) {
-			return true;
-		}
+	if (child.type == QuadNode::Branch) { query(i, box, e, out); }
+	else if (child.e.index != e) {
+		if constexpr (std::is_same_v<T, Hitbox>) { out.push_back(child.area); }
+		else { out.push_back(child.e); }
 	}
-	return false;
 }
 
-void insert(QuadNode *node, Hitbox box, ECS::entity e) {
-	for (auto child : node->nodes) {
-		if (child->type == QuadNode::Leaf) { continue; }
-		if (isWithin(child->area, box)) {
-			insert(child, box, e);
+/**
+ * @details
+ * Once a node holds more than `THRESHOLD` children, no two of its leaves
+ * are left sharing a quadrant, so it is enough to check the quadrant of
+ * each new leaf instead of scanning all four quadrants on every insert.
+ */
+void QuadTree::insertNode(uint32_t node, uint32_t leaf) {
+	for (uint32_t i = nodes[node].firstChild; i != QuadNode::NONE; i = nodes[i].nextSibling) {
+		if (nodes[i].type == QuadNode::Leaf) { continue; }
+		if (isWithin(nodes[i].area, nodes[leaf].area)) {
+			insertNode(i, leaf);
 			return;
 		}
 	}
 
-	node->nodes.push_back(new QuadNode(box, e));
-	if (node->nodes.size() > THRESHOLD) { mergeLeaves(node); }
+	linkChild(node, leaf);
+	if (nodes[node].childCount == THRESHOLD + 1) { mergeLeaves(node); }
+	else if (nodes[node].childCount > THRESHOLD) {
+		int quadrant = quadrantOf(nodes[node].area, nodes[leaf].area);
+		if (quadrant >= 0) { mergeQuadrant(node, quadrant); }
+	}
+}
+
+/**
+ * @details
+ * Leaves that straddle the quadrants stay in `node`, so it may still
+ * hold more than `THRESHOLD` children afterwards.
+ */
+void QuadTree::mergeLeaves(uint32_t node) {
+	for (unsigned i = 0; i < NUM_QUADRANTS; i++) {
+		mergeQuadrant(node, i);
+	}
 }
 
-void mergeLeaves(QuadNode* node) {
+/**
+ * @details
+ * Nothing happens if fewer than two leaves of `node` are within the quadrant,
+ * or if the quadrant would be smaller than `MIN_BOX_SIZE`, e.g. when
+ * many entities are stacked on the same spot.
+ * The leaves are relinked rather than copied, and keep their order.
+ */
+bool QuadTree::mergeQuadrant(uint32_t node, int quadrant) {
 	/* Make sure the area won't turn out too small when we create a new node */
-	if (node->area.w < MIN_BOX_SIZE || node->area.h < MIN_BOX_SIZE) {
-		GRY_Log("QuadTree: Minimum size reached for area."); { return; }
+	if (nodes[node].area.w < MIN_BOX_SIZE || nodes[node].area.h < MIN_BOX_SIZE) { return false; }
+
+	Hitbox box = quadrantRect(nodes[node].area, quadrant);
+	unsigned count = 0;
+	for (uint32_t j = nodes[node].firstChild; j != QuadNode::NONE; j = nodes[j].nextSibling) {
+		if (nodes[j].type == QuadNode::Leaf && isWithin(box, nodes[j].area)) { count++; }
 	}
+	if (count < 2) { return false; }
 
-	for (int i = 0; i < NUM_QUADRANTS; i++) {
-		Hitbox box = quadrantRect(node->area, i);
-		unsigned count = 0;
-		for (auto& child : node->nodes) {
-			if (child->type == QuadNode::Branch || !isWithin(box, child->area)) { continue; }
-			count++;
+	/* Unlink the leaves within the quadrant from the node, keeping them in order */
+	uint32_t movedFirst = QuadNode::NONE;
+	uint32_t movedLast = QuadNode::NONE;
+	uint32_t prev = QuadNode::NONE;
+	uint32_t j = nodes[node].firstChild;
+	nodes[node].lastChild = QuadNode::NONE;
+	while (j != QuadNode::NONE) {
+		uint32_t next = nodes[j].nextSibling;
+		if (nodes[j].type == QuadNode::Leaf && isWithin(box, nodes[j].area)) {
+			if (prev == QuadNode::NONE) { nodes[node].firstChild = next; }
+			else { nodes[prev].nextSibling = next; }
+			nodes[node].childCount--;
+			nodes[j].nextSibling = QuadNode::NONE;
+			if (movedLast == QuadNode::NONE) { movedFirst = j; }
+			else { nodes[movedLast].nextSibling = j; }
+			movedLast = j;
 		}
-		if (count < 2) { continue; }
-
-		QuadNode* newNode = new QuadNode(box);
-		newNode->type = QuadNode::Branch;
-		for (int j = node->nodes.size() - 1; j >= 0; j++) {
-			QuadNode* child = node->nodes.at(j);
-			if (child->type == QuadNode::Branch || !isWithin(box, child->area)) { continue; }
-			insert(newNode, child->area, child->e);
-
-			std::swap(node->nodes.at(j), node->nodes.back());
-			delete node->nodes.back();
-			node->nodes.pop_back();
+		else {
+			prev = j;
+			nodes[node].lastChild = j;
 		}
-		node->nodes.push_back(newNode);
-		break;
+		j = next;
+	}
+
+	/* Insert them into a new branch for the quadrant */
+	uint32_t newNode = createNode(box, ECS::NONE_HANDLE);
+	linkChild(node, newNode);
+	while (movedFirst != QuadNode::NONE) {
+		uint32_t next = nodes[movedFirst].nextSibling;
+		insertNode(newNode, movedFirst);
+		movedFirst = next;
 	}
+	return true;
+}
 
-	if (node->nodes.size() > THRESHOLD) {
-		GRY_Log("[QuadTree] Could not reduce below threshold.");
+static int quadrantOf(const Hitbox area, const Hitbox box) {
+	for (unsigned i = 0; i < NUM_QUADRANTS; i++) {
+		if (isWithin(quadrantRect(area, i), box)) { return i; }
 	}
+	return -1;
 }
 
 static Hitbox quadrantRect(Hitbox box, int quadrant) {
@@ -174,3 +274,11 @@ static bool isWithin(const Hitbox outerBox, const Hitbox innerBox) {
 		innerBox.x + innerBox.w <= outerBox.x + outerBox.w &&
 		innerBox.y + innerBox.h <= outerBox.y + outerBox.h;
 }
+
+static bool collides(const Hitbox box, const Hitbox other) {
+	return
+		box.x + box.w > other.x &&
+		box.x < other.x + other.w &&
+		box.y + box.h > other.y &&
+		box.y < other.y + other.h;
+}
@@ -14,6 +14,10 @@ SceneManager::~SceneManager() {
 	delete transition;
 }
 
+void SceneManager::tick() {
+	if (!allScenes.empty()) { allScenes.back()->tick(); }
+}
+
 void SceneManager::process() {
     if (allScenes.empty()) {
 		GRY_Log("No scenes in the scene manager.");
@@ -0,0 +1,128 @@
+#include "SpatialGrid.hpp"
+#include "GRY_Log.hpp"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+static bool collides(const Hitbox box, const Hitbox other);
+
+SpatialGrid::SpatialGrid(Hitbox area, float cellSize) :
+	area(area),
+	invCellSize(1.0f / cellSize),
+	columns(std::max(1, (int)ceilf(area.w / cellSize))),
+	rows(std::max(1, (int)ceilf(area.h / cellSize))),
+	cells((std::size_t)columns * rows) {
+	GRY_Assert(cellSize > 0, "[SpatialGrid] Cell size must be positive (was %f).\n", cellSize);
+}
+
+void SpatialGrid::insert(Hitbox box, ECS::handle e) {
+	if (e.index >= boxes.size()) { boxes.resize(e.index + 1); }
+	boxes[e.index] = Entry{ box, e };
+	addToCells(cellRange(box), Item{ box, e });
+}
+
+void SpatialGrid::query(Hitbox box, ECS::entity e, std::vector<Hitbox>& out) const {
+	queryCells(box, e, out);
+}
+
+void SpatialGrid::query(Hitbox box, ECS::entity e, std::vector<ECS::handle>& out) const {
+	queryCells(box, e, out);
+}
+
+/**
+ * @details
+ * If the box still overlaps the same cells, its copies are rewritten
+ * in place. Otherwise it is removed from its old cells and added to the new ones.
+ */
+bool SpatialGrid::update(Hitbox box, ECS::entity e) {
+	if (!contains(e)) { return false; }
+	CellRange oldRange = cellRange(boxes[e].box);
+	CellRange newRange = cellRange(box);
+	boxes[e].box = box;
+
+	if (oldRange == newRange) {
+		for (int y = oldRange.y0; y <= oldRange.y1; y++) {
+			for (int x = oldRange.x0; x <= oldRange.x1; x++) {
+				for (Item& item : cells[y * columns + x]) {
+					if (item.e.index == e) { item.box = box; break; }
+				}
+			}
+		}
+		return false;
+	}
+
+	removeFromCells(oldRange, e);
+	addToCells(newRange, Item{ box, boxes[e].e });
+	return true;
+}
+
+void SpatialGrid::reset() {
+	for (auto& cell : cells) { cell.clear(); }
+	for (auto& entry : boxes) { entry.e = ECS::NONE_HANDLE; }
+	occupiedCells = 0;
+}
+
+int SpatialGrid::column(float x) const {
+	return std::clamp((int)floorf((x - area.x) * invCellSize), 0, columns - 1);
+}
+
+int SpatialGrid::row(float y) const {
+	return std::clamp((int)floorf((y - area.y) * invCellSize), 0, rows - 1);
+}
+
+SpatialGrid::CellRange SpatialGrid::cellRange(Hitbox box) const {
+	return CellRange{ column(box.x), row(box.y), column(box.x + box.w), row(box.y + box.h) };
+}
+
+void SpatialGrid::addToCells(CellRange range, Item item) {
+	for (int y = range.y0; y <= range.y1; y++) {
+		for (int x = range.x0; x <= range.x1; x++) {
+			auto& cell = cells[y * columns + x];
+			if (cell.empty()) { occupiedCells++; }
+			cell.push_back(item);
+		}
+	}
+}
+
+void SpatialGrid::removeFromCells(CellRange range, ECS::entity e) {
+	for (int y = range.y0; y <= range.y1; y++) {
+		for (int x = range.x0; x <= range.x1; x++) {
+			auto& cell = cells[y * columns + x];
+			for (std::size_t i = 0; i < cell.size(); i++) {
+				if (cell[i].e.index != e) { continue; }
+				cell[i] = cell.back();
+				cell.pop_back();
+				break;
+			}
+			if (cell.empty()) { occupiedCells--; }
+		}
+	}
+}
+
+/**
+ * @details
+ * A hitbox that spans several cells is only reported from the first
+ * cell that it shares with the queried box, so it is never reported twice.
+ */
+template<class T>
+void SpatialGrid::queryCells(Hitbox box, ECS::entity e, std::vector<T>& out) const {
+	CellRange range = cellRange(box);
+	for (int y = range.y0; y <= range.y1; y++) {
+		for (int x = range.x0; x <= range.x1; x++) {
+			for (const Item& item : cells[y * columns + x]) {
+				if (item.e.index == e || !collides(box, item.box)) { continue; }
+				if (x != std::max(range.x0, column(item.box.x)) || y != std::max(range.y0, row(item.box.y))) { continue; }
+				if constexpr (std::is_same_v<T, Hitbox>) { out.push_back(item.box); }
+				else { out.push_back(item.e); }
+			}
+		}
+	}
+}
+
+static bool collides(const Hitbox box, const Hitbox other) {
+	return
+		box.x + box.w > other.x &&
+		box.x < other.x + other.w &&
+		box.y + box.h > other.y &&
+		box.y < other.y + other.h;
+}
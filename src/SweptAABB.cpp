@@ -0,0 +1,135 @@
+/**
+ * @file SweptAABB.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @copyright Copyright (c) 2025
+ */
+#include "SweptAABB.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @details
+ * Finds, for each axis, the fractions of the motion at which the hitboxes
+ * start touching and stop overlapping on that axis. They collide between the
+ * latest start and the earliest stop, and the axis that starts last is the
+ * one that blocks the motion. Hitboxes stop overlapping once they overlap by
+ * no more than SWEEP_CONTACT_EPSILON, so a box resting against another can move away from it.
+ */
+SweepHit sweepAABB(Hitbox box, Velocity2 motion, Hitbox other) {
+	const float boxMin[2] = { box.x, box.y };
+	const float boxSize[2] = { box.w, box.h };
+	const float otherMin[2] = { other.x, other.y };
+	const float otherSize[2] = { other.w, other.h };
+
+	float entry[2];
+	float exit[2];
+	bool overlapping[2];
+	for (int i = 0; i < 2; i++) {
+		float boxMax = boxMin[i] + boxSize[i];
+		float otherMax = otherMin[i] + otherSize[i];
+		overlapping[i] = boxMax - otherMin[i] > SWEEP_CONTACT_EPSILON && otherMax - boxMin[i] > SWEEP_CONTACT_EPSILON;
+		if (motion[i] > 0) {
+			entry[i] = (otherMin[i] - boxMax) / motion[i];
+			exit[i] = (otherMax - SWEEP_CONTACT_EPSILON - boxMin[i]) / motion[i];
+		}
+		else if (motion[i] < 0) {
+			entry[i] = (otherMax - boxMin[i]) / motion[i];
+			exit[i] = (otherMin[i] + SWEEP_CONTACT_EPSILON - boxMax) / motion[i];
+		}
+		else {
+			/* Not moving on this axis, so the hitboxes either always or never overlap on it */
+			if (!overlapping[i]) { return SweepHit{}; }
+			entry[i] = -INFINITY;
+			exit[i] = INFINITY;
+		}
+	}
+	/* Still inside of it after depenetrate, so let the box move out */
+	if (overlapping[0] && overlapping[1]) { return SweepHit{}; }
+
+	int axis = entry[0] > entry[1] ? 0 : 1;
+	float entryTime = entry[axis];
+	float exitTime = std::min(exit[0], exit[1]);
+	if (overlapping[axis] || entryTime >= exitTime || exitTime <= 0 || entryTime > 1) { return SweepHit{}; }
+	return SweepHit{ std::max(entryTime, 0.f), axis };
+}
+
+/**
+ * @details
+ * Each pass pushes the box out of every obstacle it still overlaps, along
+ * the axis it overlaps the least, and places it against that obstacle's
+ * edge. Being pushed out of one obstacle can push the box into another,
+ * which the next pass handles, up to MAX_DEPENETRATION_PASSES passes.
+ */
+Hitbox depenetrate(Hitbox box, const std::vector<Hitbox>& obstacles) {
+	for (unsigned pass = 0; pass < MAX_DEPENETRATION_PASSES; pass++) {
+		bool pushed = false;
+		for (const Hitbox& other : obstacles) {
+			float left = box.x + box.w - other.x;
+			float right = other.x + other.w - box.x;
+			float up = box.y + box.h - other.y;
+			float down = other.y + other.h - box.y;
+			if (left <= SWEEP_CONTACT_EPSILON || right <= SWEEP_CONTACT_EPSILON ||
+				up <= SWEEP_CONTACT_EPSILON || down <= SWEEP_CONTACT_EPSILON) { continue; }
+
+			if (std::min(left, right) <= std::min(up, down)) {
+				box.x = left < right ? other.x - box.w : other.x + other.w;
+			}
+			else {
+				box.y = up < down ? other.y - box.h : other.y + other.h;
+			}
+			pushed = true;
+		}
+		if (!pushed) { break; }
+	}
+	return box;
+}
+
+Hitbox sweptBounds(Hitbox box, Velocity2 motion) {
+	return Hitbox{
+		motion.x < 0 ? box.x + motion.x : box.x,
+		motion.y < 0 ? box.y + motion.y : box.y,
+		box.w + fabsf(motion.x),
+		box.h + fabsf(motion.y)
+	};
+}
+
+/**
+ * @details
+ * Makes at most two sweeps over `obstacles`: one for the whole motion,
+ * and one for what is left of it along the axis that was not blocked.
+ * The second sweep stays within the swept bounds of the first.
+ */
+Hitbox sweepAndSlide(Hitbox box, Velocity2 motion, const std::vector<Hitbox>& obstacles, SweepHit* hit) {
+	if (hit) { *hit = SweepHit{}; }
+	box = depenetrate(box, obstacles);
+	for (int pass = 0; pass < 2 && (motion.x || motion.y); pass++) {
+		SweepHit earliest;
+		const Hitbox* blocker = nullptr;
+		for (const Hitbox& obstacle : obstacles) {
+			SweepHit obstacleHit = sweepAABB(box, motion, obstacle);
+			if (obstacleHit.axis >= 0 && (!blocker || obstacleHit.time < earliest.time)) {
+				earliest = obstacleHit;
+				blocker = &obstacle;
+			}
+		}
+		if (!blocker) {
+			box.x += motion.x;
+			box.y += motion.y;
+			break;
+		}
+		if (hit && pass == 0) { *hit = earliest; }
+
+		/* Place the box right against the blocker, rather than trusting motion * time to land on its edge */
+		if (earliest.axis == 0) {
+			box.x = motion.x > 0 ? blocker->x - box.w : blocker->x + blocker->w;
+			box.y += motion.y * earliest.time;
+			motion = Velocity2{ 0, motion.y * (1 - earliest.time) };
+		}
+		else {
+			box.x += motion.x * earliest.time;
+			box.y = motion.y > 0 ? blocker->y - box.h : blocker->y + blocker->h;
+			motion = Velocity2{ motion.x * (1 - earliest.time), 0 };
+		}
+	}
+	return box;
+}
@@ -1,5 +1,7 @@
 #include "imguiDebugger.hpp"
 #include "GRY_Game.hpp"
+#include "GRY_Gperftools.hpp"
+#include "GRY_ProfilerImGui.hpp"
 #include "imgui.h"
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_sdlrenderer3.h"
@@ -12,6 +14,7 @@
 imguiDebugger::imguiDebugger(GRY_Game* game) : game(game) {}
 
 imguiDebugger::~imguiDebugger() {
+    if (!initialized) { return; }
     ImGui_ImplSDLRenderer3_Shutdown();
     ImGui_ImplSDL3_Shutdown();
     ImGui::DestroyContext();
@@ -32,6 +35,7 @@ void imguiDebugger::init() {
     /* Setup with SDL */
     ImGui_ImplSDL3_InitForSDLRenderer(game->getVideo().getWindow(), game->getVideo().getRenderer());
     ImGui_ImplSDLRenderer3_Init(game->getVideo().getRenderer());
+    initialized = true;
 }
 
 void imguiDebugger::startFrame() {
@@ -61,6 +65,31 @@ void imguiDebugger::process() {
 		game->getVideo().toggleFullscreen();
 	}
 	ImGui::End();
+
+	imguiProfiler();
+	processGperftools();
+}
+
+void imguiDebugger::processGperftools() {
+	ImGui::Begin("gperftools");
+	if (!GRY_Gperftools::isAvailable()) {
+		ImGui::TextUnformatted("Built without ENABLE_GPERFTOOLS.");
+		ImGui::End();
+		return;
+	}
+
+	if (GRY_Gperftools::isCpuProfiling()) {
+		if (ImGui::Button("Stop CPU profile")) { GRY_Gperftools::stopCpuProfile(); }
+	}
+	else if (ImGui::Button("Start CPU profile")) { GRY_Gperftools::startCpuProfile(CPU_PROFILE_PATH); }
+
+	if (GRY_Gperftools::isHeapProfiling()) {
+		if (ImGui::Button("Dump heap profile")) { GRY_Gperftools::dumpHeapProfile("debugger"); }
+		ImGui::SameLine();
+		if (ImGui::Button("Stop heap profile")) { GRY_Gperftools::stopHeapProfile(); }
+	}
+	else if (ImGui::Button("Start heap profile")) { GRY_Gperftools::startHeapProfile(HEAP_PROFILE_PREFIX); }
+	ImGui::End();
 }
 
 void imguiDebugger::render(SDL_Renderer* renderer) {
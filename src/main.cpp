@@ -4,6 +4,8 @@
  * @copyright Copyright (c) 2024
  */
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "GRY_PixelGame.hpp"
 #include "scenes/TilesetScene.hpp"
 #include "scenes/TileMapScene.hpp"
@@ -13,11 +15,64 @@ int WINDOW_HEIGHT = 540;
 int MAX_FPS = 120;
 bool USE_VSYNC = true;
 
-static GRY_PixelGame game(WINDOW_WIDTH, WINDOW_HEIGHT, MAX_FPS, USE_VSYNC);
-
 const char* scenePath = "assets/tilemapscene/map02/scene.json";
 
-Tile::MapScene* scene = new Tile::MapScene(&game, scenePath);
+/**
+ * @brief Number of ticks to run with `--headless` if no count is given, one minute of game time by default.
+ *
+ */
+const uint64_t DEFAULT_HEADLESS_TICKS = 3600;
+
+/**
+ * @brief How to run the game, from the command line.
+ *
+ */
+struct RunOptions {
+	/**
+	 * @brief Whether to run without a window.
+	 *
+	 */
+	bool headless = false;
+
+	/**
+	 * @brief Number of ticks to run when headless.
+	 *
+	 */
+	uint64_t ticks = DEFAULT_HEADLESS_TICKS;
+
+	/**
+	 * @brief File to record input to, or `NULL`.
+	 *
+	 */
+	const char* recordPath = NULL;
+
+	/**
+	 * @brief File to replay input from, or `NULL`.
+	 *
+	 */
+	const char* replayPath = NULL;
+};
+
+/**
+ * @brief Run the game, in a window or headless.
+ *
+ * @param options How to run the game.
+ * @return Exit code.
+ */
+static int run(const RunOptions& options) {
+	GRY_PixelGame game(WINDOW_WIDTH, WINDOW_HEIGHT, MAX_FPS, USE_VSYNC, options.headless);
+
+	if (options.replayPath && !game.replayInput(options.replayPath)) { return 1; }
+	if (options.recordPath && !game.recordInput(options.recordPath)) { return 1; }
+
+	/* Add initial scene */
+	game.stackScene(new Tile::MapScene(&game, scenePath));
+
+	if (options.headless) { game.runHeadless(options.ticks); }
+	else { game.runGame(); }
+
+	return 0;
+}
 
 #ifdef _WIN32
 #ifndef NOMINMAX
@@ -30,23 +85,35 @@ _Use_decl_annotations_ int WINAPI WinMain(
 	HINSTANCE hPrevInstance,
 	LPSTR lpCmdLine,
 	int nCmdShow) {
-	
-	/* Add initial scene */
-	game.stackScene(scene);
 
-	game.runGame();
-	
-	return 0;
+	return run(RunOptions{});
 }
 #endif
 
+/**
+ * @details
+ * Usage: `game [--headless [ticks]] [--record file] [--replay file]`
+ *
+ * With `--headless`, the map is simulated for `ticks` ticks as fast as possible,
+ * without a window, and the ticks per second are printed. Interactions,
+ * dialogue and map switches still run, see GRY_Game::runHeadless.
+ * `--record` saves every frame's input to `file`, and `--replay` plays
+ * back a recording made with `--record` instead of using live input.
+ */
 int main(int argc, char* argv[]) {
+	RunOptions options;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--headless") == 0) {
+			options.headless = true;
+			if (i + 1 < argc && argv[i + 1][0] != '-') { options.ticks = strtoull(argv[++i], NULL, 10); }
+		}
+		else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) { options.recordPath = argv[++i]; }
+		else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) { options.replayPath = argv[++i]; }
+		else {
+			printf("Unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
 
-	/* Add initial scene */
-	game.stackScene(scene);
-
-	game.runGame();
-
-	return 0;
+	return run(options);
 }
-
@@ -1,8 +1,8 @@
 #include "MenuScene.hpp"
 #include "GRY_PixelGame.hpp"
 #include "GRY_JSON.hpp"
+#include "GRY_Atlas.hpp"
 #include "SDL3/SDL_render.h"
-#include "SDL_RectOps.hpp"
 
 static const float LEFT_MARGIN = 8.f;
 static const float TOP_MARGIN = 8.f;
@@ -26,11 +26,8 @@ void MenuScene::setSelection(uint8_t selectionValue) {
 
 void MenuScene::renderMenu(const Fontset& font) {
 	SDL_Renderer* renderer = getGame()->getVideo().getRenderer();
-	const float* pixelScaling = &((GRY_PixelGame*)game)->getPixelScalingRef();
 
-	SDL_FRect boxDstRect = boxTextureArea;
-	boxDstRect *= *pixelScaling;
-	SDL_RenderTexture(renderer, boxTexture.texture, NULL, &boxDstRect);
+	SDL_RenderTexture(renderer, boxTexture.texture, &boxTexture.area, &boxTextureArea);
 
 	float cursorX = textArea.x;
 	float cursorY = textArea.y;
@@ -40,8 +37,6 @@ void MenuScene::renderMenu(const Fontset& font) {
 			for (char* c = selectionStrings[i * numCols + j]; *c; c++) {
 				const SDL_FRect* srcRect = font.getSourceRect(*c - ' ');
 				SDL_FRect dstRect { cursorX, cursorY, srcRect->w, srcRect->h };
-
-				dstRect *= *pixelScaling;
 				SDL_RenderTexture(renderer, font.texture, font.getSourceRect(*c - ' '), &dstRect);
 
 				cursorX += srcRect->w;
@@ -68,12 +63,8 @@ MenuScene::~MenuScene() {
 void MenuScene::init() {
 	setControls();
 	
-	float textureWidth;
-	float textureHeight;
-	SDL_GetTextureSize(boxTexture.texture, &textureWidth, &textureHeight);
-
-	boxTextureArea.w = textureWidth;
-	boxTextureArea.h = textureHeight;
+	boxTextureArea.w = boxTexture.area.w;
+	boxTextureArea.h = boxTexture.area.h;
 
 	/* Recall that textArea width and height have the margins stored in them right now */
 	textArea.x = (int)boxTextureArea.x + textArea.w;
@@ -123,6 +114,10 @@ bool MenuScene::load() {
 	return false;
 }
 
+void MenuScene::addToAtlas(GRY_Atlas& atlas) {
+	atlas.add(boxTexture);
+}
+
 void MenuScene::open() {
 	GRY_Assert(!active, "[MenuScene] open() called when the decision box was already open!");
 	activateControlScheme();
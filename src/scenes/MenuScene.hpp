@@ -10,6 +10,7 @@
 #include "../textbox/Fontset.hpp"
 
 class GRY_PixelGame;
+class GRY_Atlas;
 struct SDL_Renderer;
 
 class MenuScene : public Scene {
@@ -73,6 +74,13 @@ public:
 	 */
 	bool load() override;
 
+	/**
+	 * @brief Add the scene's textures to an atlas. Call after the scene is loaded.
+	 *
+	 * @param atlas Atlas to add to.
+	 */
+	virtual void addToAtlas(GRY_Atlas& atlas);
+
 	void open();
 
 	void close();
@@ -6,6 +6,7 @@
 #include "TextBoxScene.hpp"
 #include "GRY_JSON.hpp"
 #include "GRY_PixelGame.hpp"
+#include "GRY_Atlas.hpp"
 #include "SDL3/SDL_render.h"
 
 static const float BOTTOM_MARGIN = 8.f;
@@ -58,9 +59,8 @@ void TextBoxScene::init() {
 	unsigned screenWidth = pGame->getScreenWidthPixels();
 	unsigned screenHeight = pGame->getScreenHeightPixels();
 
-	float textureWidth;
-	float textureHeight;
-	SDL_GetTextureSize(boxTexture.texture, &textureWidth, &textureHeight);
+	float textureWidth = boxTexture.area.w;
+	float textureHeight = boxTexture.area.h;
 
 	float x = ((float)screenWidth - textureWidth) * 0.5f;
 	float y = ((float)screenHeight - textureHeight - BOTTOM_MARGIN);
@@ -146,6 +146,12 @@ bool TextBoxScene::load() {
 	return false;
 }
 
+void TextBoxScene::addToAtlas(GRY_Atlas& atlas) {
+	atlas.add(boxTexture);
+	atlas.add(font.texture, font.ownsTexture, font.sourceRects);
+	decisionScene.addToAtlas(atlas);
+}
+
 bool TextBoxScene::isReady() {
 	GRY_Assert(active, "[TextBoxScene] You must open the text box before calling isReady()!");
 	return !*incomingLine;
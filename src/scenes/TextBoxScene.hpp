@@ -13,6 +13,7 @@
 #include "../textbox/TextBoxRenderer.hpp"
 
 class GRY_PixelGame;
+class GRY_Atlas;
 
 /**
  * @brief Displays an interactive text box at the bottom of the screen.
@@ -105,6 +106,13 @@ public:
 	 */
 	bool load() final;
 
+	/**
+	 * @brief Add the textures of the box, its font and its decision box to an atlas. Call after the scene is loaded.
+	 *
+	 * @param atlas Atlas to add to.
+	 */
+	void addToAtlas(GRY_Atlas& atlas);
+
 	/**
 	 * @brief Whether the box is ready to accept a new line of dialogue.
 	 * 
@@ -157,9 +165,9 @@ public:
 	/**
 	 * @brief Get the text box texture.
 	 * 
-	 * @return The text box texture
+	 * @return `const` reference to the text box texture
 	 */
-	SDL_Texture* getBoxTexture() const { return boxTexture.texture; }
+	const GRY_Texture& getBoxTexture() const { return boxTexture; }
 
 	/**
 	 * @brief Get the text box texture area.
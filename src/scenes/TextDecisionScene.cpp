@@ -2,7 +2,7 @@
 #include "TextBoxScene.hpp"
 #include "GRY_JSON.hpp"
 #include "GRY_PixelGame.hpp"
-#include "SDL_RectOps.hpp"
+#include "GRY_Atlas.hpp"
 #include "SDL3/SDL_render.h"
 
 static const float LINE_SPACING = 2.f;
@@ -24,16 +24,14 @@ void TextDecisionScene::setControls() {
 TextDecisionScene::TextDecisionScene(GRY_PixelGame *pGame, const char *scenePath, TextBoxScene* scene) :
 	Scene((GRY_Game*)pGame, scenePath),
 	scene(scene),
-	renderer(scene->getGame()->getVideo().getRenderer()),
-	pixelScaling(&scene->getPixelGame()->getPixelScalingRef()) {
+	renderer(scene->getGame()->getVideo().getRenderer()) {
 }
 
 void TextDecisionScene::init() {
 	setControls();
 	
-	float textureWidth;
-	float textureHeight;
-	SDL_GetTextureSize(boxTexture.texture, &textureWidth, &textureHeight);
+	float textureWidth = boxTexture.area.w;
+	float textureHeight = boxTexture.area.h;
 
 	boxTextureArea = scene->getBoxTextureArea();
 	boxTextureArea.x += boxTextureArea.w - textureWidth;
@@ -71,9 +69,7 @@ void TextDecisionScene::process() {
 
 	const Fontset& font = scene->getFont();
 
-	SDL_FRect boxDstRect = boxTextureArea;
-	boxDstRect *= *pixelScaling;
-	SDL_RenderTexture(renderer, boxTexture.texture, NULL, &boxDstRect);
+	SDL_RenderTexture(renderer, boxTexture.texture, &boxTexture.area, &boxTextureArea);
 
 	float cursorX = textArea.x;
 	float cursorY = textArea.y;
@@ -82,8 +78,6 @@ void TextDecisionScene::process() {
 		for (char* c = selectionStrings[i]; *c; c++) {
 			const SDL_FRect* srcRect = font.getSourceRect(*c - ' ');
 			SDL_FRect dstRect { cursorX, cursorY, srcRect->w, srcRect->h };
-
-			dstRect *= *pixelScaling;
 			SDL_RenderTexture(renderer, font.texture, font.getSourceRect(*c - ' '), &dstRect);
 
 			cursorX += srcRect->w;
@@ -110,6 +104,10 @@ bool TextDecisionScene::load() {
 	return false;
 }
 
+void TextDecisionScene::addToAtlas(GRY_Atlas& atlas) {
+	atlas.add(boxTexture);
+}
+
 void TextDecisionScene::open() {
 	GRY_Assert(!active, "[DecisionBoxScene] open() called when the decision box was already open!");
 	activateControlScheme();
@@ -11,6 +11,7 @@
 
 class GRY_PixelGame;
 class TextBoxScene;
+class GRY_Atlas;
 struct SDL_Renderer;
 
 /**
@@ -34,12 +35,6 @@ private:
 
 	SDL_Renderer* renderer;
 
-	/**
-	 * @brief Scaling factor for the box texture.
-	 * 
-	 */
-	const float* pixelScaling;
-
 	enum Selection { NONE = 0, YES = 1, NO = 2 } selection = NONE;
 
 	char selectionStrings[3][5] = { ">", " Yes", " No" };
@@ -74,6 +69,13 @@ public:
 	 */
 	bool load() final;
 
+	/**
+	 * @brief Add the scene's textures to an atlas. Call after the scene is loaded.
+	 *
+	 * @param atlas Atlas to add to.
+	 */
+	void addToAtlas(GRY_Atlas& atlas);
+
 	/**
 	 * @brief Opens and activates the decision box.
 	 * 
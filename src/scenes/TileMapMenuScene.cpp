@@ -2,6 +2,7 @@
 #include "TileMapScene.hpp"
 #include "GRY_Game.hpp"
 #include "GRY_JSON.hpp"
+#include "GRY_Atlas.hpp"
 
 void Tile::MapMenuScene::makeSelection(uint8_t selection) {
 	switch (static_cast<Selection>(selection)) {
@@ -68,3 +69,9 @@ bool Tile::MapMenuScene::load() {
 	font.setPath(sceneDoc["fontTexturePath"].GetString());
 	return false;
 }
+
+void Tile::MapMenuScene::addToAtlas(GRY_Atlas& atlas) {
+	MenuScene::addToAtlas(atlas);
+	miscScene.addToAtlas(atlas);
+	atlas.add(font.texture, font.ownsTexture, font.sourceRects);
+}
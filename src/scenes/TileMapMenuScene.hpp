@@ -29,6 +29,8 @@ namespace Tile {
 
 		bool load() final;
 
+		void addToAtlas(GRY_Atlas& atlas) final;
+
 		const Fontset& getFont() { return font; }
 	};
 };
@@ -1,7 +1,9 @@
 #include "TileMapScene.hpp"
 #include "GRY_PixelGame.hpp"
 #include "GRY_JSON.hpp"
+#include "GRY_Profiler.hpp"
 #include "../transitions/FadeToBlack.hpp"
+#include <cstring>
 #ifndef NDEBUG
 #include "../tile/TileMapImGui.hpp"
 #endif
@@ -35,16 +37,28 @@ Tile::MapScene::MapScene(GRY_PixelGame *pGame, const char *tileMapPath, MapScene
 
 /**
  * @details
- * Assign collision rectangles to tiles and initialize systems.
+ * Pack the textures into an atlas, assign collision rectangles to tiles,
+ * build the collision mask, and initialize systems.
  */
 void Tile::MapScene::init() {
 	setControls();
+
+	/* Tiles, sprites, text and boxes then draw from the same few textures */
+	atlas.add(tileMap.tileset.texture, tileMap.tileset.ownsTexture, tileMap.tileset.sourceRects);
+	for (Tileset& tileset : entityMap.tilesets) {
+		atlas.add(tileset.texture, tileset.ownsTexture, tileset.sourceRects);
+	}
+	textBoxScene.addToAtlas(atlas);
+	menuScene.addToAtlas(atlas);
+	atlas.build(game->getVideo().getRenderer());
 	
+	tileCollisionMask.reset(tileMap.width, tileMap.height, normalTileSize, tileMap.tileLayers.size());
 	for (int i = 0; i < tileMap.collisionRects.size(); i++) {
 		auto& rectangleLayer = tileMap.collisionRects.at(i);
 		auto& tileLayer = tileMap.tileLayers.at(i);
 		for (int j = 0; j < rectangleLayer.size(); j++) {
 			SDL_FRect rect = rectangleLayer.at(j);
+			if (j) { tileCollisionMask.addRect(i, j, Hitbox{ rect.x, rect.y, rect.w, rect.h }); }
 			unsigned tilex = rect.x / normalTileSize;
 			unsigned tiley = rect.y / normalTileSize;
 			unsigned tilew = ceilf(rect.w / normalTileSize);
@@ -66,10 +80,46 @@ void Tile::MapScene::init() {
 	entity player = ecs.getComponent<Player>().getEntity(0);
 	if (sceneInfo.spawnPosition.x >= 0 && sceneInfo.spawnPosition.y >= 0) {
 		ecs.getComponent<Position2>().get(player) = sceneInfo.spawnPosition;
+		EntityMap::markMoved(&entityMap, player, ecs.getComponent<MapEntity>().get(player).layer);
 	}
 	if (sceneInfo.spawnDirection != Direction::DirectionNone) {
 		ecs.getComponent<Actor>().get(player).direction = sceneInfo.spawnDirection;
 	}
+
+	/* Start the camera on the player, since it is drawn before the first tick */
+	tileMapCamera.process();
+	tileMapCamera.savePosition();
+}
+
+/**
+ * @details
+ * Positions are saved first, so the frames rendered until the next tick
+ * can be drawn between where things were and where they are now.
+ */
+void Tile::MapScene::tick() {
+	double delta = game->getTickLength();
+	tileMapRenderer.savePositions();
+	tileMapCamera.savePosition();
+
+	{ GRY_ProfileScope("Input"); tileMapInput.process(); }
+	{ GRY_ProfileScope("Scripting"); mapScripting.process(delta); }
+	{ GRY_ProfileScope("Movement"); tileMapMovement.process(delta); }
+	/* Structural ECS changes recorded by the systems above are applied here, outside of any iteration */
+	{
+		GRY_ProfileScope("ECS commands");
+		/* Freed entities have to leave the layers and stop being commanded before anything looks them up */
+		if (ecs.applyCommands()) {
+			EntityMap::removeFreed(&entityMap);
+			mapScripting.cancelFreed();
+		}
+	}
+	{ GRY_ProfileScope("QuadTrees"); tileMapQuadTrees.process(); }
+	{ GRY_ProfileScope("Sprite animator"); tileSpriteAnimator.process(delta); }
+	{ GRY_ProfileScope("Camera"); tileMapCamera.process(); }
+	{ GRY_ProfileScope("Tileset animations"); tileMap.tileset.processAnimations(delta); }
+
+	tileMapMovement.postProcess();
+	EntityMap::updateLayers(&entityMap);
 }
 
 void Tile::MapScene::process() {
@@ -86,25 +136,21 @@ void Tile::MapScene::process() {
 			break;
 	}
 
-	tileMapInput.process();
-	mapScripting.process(game->getDelta());
-	tileMapSpeak.process();
-	tileMapMovement.process(game->getDelta());
-	tileMapQuadTrees.process();
-	tileSpriteAnimator.process(game->getDelta());
-	tileMapCamera.process();
-	tileMap.tileset.processAnimations(game->getDelta());
-	tileMapRenderer.process();
-	
-	tileMapMovement.postProcess();
+	{ GRY_ProfileScope("Interact"); tileMapInput.processInteract(); }
+	{ GRY_ProfileScope("Speak"); tileMapSpeak.process(); }
+	/* The renderer draws each entity layer in order, so re-seat everything that moved this frame first */
+	{ GRY_ProfileScope("Layer sort"); EntityMap::sortMoved(&entityMap); }
+	/* Nothing sees the map when headless, but the text box and menus still have to run */
+	if (!game->getVideo().isHeadless()) {
+		tileMapCamera.updateRenderOffset();
+		{ GRY_ProfileScope("Renderer"); tileMapRenderer.process(); }
+	}
 	
-	textBoxScene.process();
-	menuScene.process();
-
-	EntityMap::updateLayers(&entityMap);
+	{ GRY_ProfileScope("Textbox"); textBoxScene.process(); }
+	{ GRY_ProfileScope("Menu"); menuScene.process(); }
 
 	#ifndef NDEBUG
-	if (game->debugMenuIsOn()) { tileMapImGui(ecs); }
+	if (game->debugMenuIsOn()) { tileMapImGui(ecs, tileMapQuadTrees, tileMapRenderer); }
 	#endif
 }
 
@@ -133,6 +179,13 @@ bool Tile::MapScene::load() {
 	sounds.setPath(sceneDoc["soundsPath"].GetString());
 	/* Read the normal tile size */
 	normalTileSize = sceneDoc["normalTileSize"].GetUint();
+	/* Read which broadphase to use for entity collisions, if specified */
+	if (sceneDoc.HasMember("broadphase")) {
+		const char* broadphase = sceneDoc["broadphase"].GetString();
+		if (!strcmp(broadphase, "grid")) { broadphaseType = Broadphase::SpatialGridType; }
+		else if (!strcmp(broadphase, "quadtree")) { broadphaseType = Broadphase::QuadTreeType; }
+		else { GRY_Log("[Tile::MapScene] Unknown broadphase \"%s\", using the quadtree.\n", broadphase); }
+	}
 
 	return false;
 }
@@ -147,37 +200,13 @@ void Tile::MapScene::deactivateControls() {
 	game->setControlScheme(controls);
 }
 
-std::vector<SDL_FRect> Tile::MapScene::queryTileCollisions(const SDL_FRect rect, std::size_t layer) const {
-	auto collides = [rect](const SDL_FRect other) {
-		return
-			rect.x + rect.w > other.x &&
-			rect.x < other.x + other.w &&
-			rect.y + rect.h > other.y &&
-			rect.y < other.y + other.h;
-	};
-	std::vector<SDL_FRect> returnVec;
-	int tileIndex = (int)(rect.y / normalTileSize) * tileMap.width + (int)(rect.x / normalTileSize);
-	int width = (int)ceilf(rect.w / normalTileSize);
-	int height = (int)ceilf(rect.h / normalTileSize);
-
-	const TileLayer& tileLayer = tileMap.tileLayers.at(layer);
-	for (int i = 0; i <= height; i++) {
-		for (int j = 0; j <= width; j++) {
-			int index = tileIndex + (i * tileMap.width) + j;
-			if (index < 0 || index > tileLayer.size()) { continue; }
-			CollisionId collision = tileLayer.at(index).collision;
-			if (!collision) { continue; }
-			SDL_FRect collisionRect = tileMap.collisionRects.at(layer).at(collision);
-			if (collides(collisionRect)) {
-				returnVec.push_back(collisionRect);
-			}
-		}
-	}
-	return returnVec;
-}
-
+/**
+ * @details
+ * Commands run from inside a tick, for example when an actor walks into
+ * something, so they advance by the tick length rather than the frame time.
+ */
 bool Tile::MapScene::executeCommand(MapCommand &command) {
-	return mapScripting.executeCommand(command, game->getDelta());
+	return mapScripting.executeCommand(command, game->getTickLength());
 }
 
 void Tile::MapScene::switchMap(const char *mapScenePath, MapSceneInfo sceneInfo) {
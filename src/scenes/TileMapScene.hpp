@@ -7,6 +7,7 @@
 #pragma once
 #include "../tile/TileMapMovement.hpp"
 #include "../tile/TileMapQuadTrees.hpp"
+#include "../tile/TileCollisionMask.hpp"
 #include "../tile/TileSpriteAnimator.hpp"
 #include "../tile/TileMapRenderer.hpp"
 #include "../tile/TileMapCamera.hpp"
@@ -20,6 +21,7 @@
 #include "../tile/TileMapScriptResource.hpp"
 #include "TileMapMenuScene.hpp"
 #include "SoundResource.hpp"
+#include "GRY_Atlas.hpp"
 
 class GRY_PixelGame;
 
@@ -52,6 +54,12 @@ namespace Tile {
 		 */
 		TileMap tileMap;
 
+		/**
+		 * @brief Which tiles of the TileMap have collision, built in init.
+		 *
+		 */
+		CollisionMask tileCollisionMask;
+
 		/**
 		 * @brief TileEntityMap that will be loaded.
 		 *
@@ -76,6 +84,8 @@ namespace Tile {
 		 */
 		SoundResource sounds;
 
+		GRY_Atlas atlas;
+
 		/**
 		 * @brief Renderer for the tile map.
 		 *
@@ -95,7 +105,7 @@ namespace Tile {
 		MapMovement tileMapMovement;
 
 		/**
-		 * @brief Stores quadtrees for the collision hitboxes of entities for each layer.
+		 * @brief Stores a Broadphase for the collision hitboxes of entities for each layer.
 		 * 
 		 */
 		MapQuadTrees tileMapQuadTrees;
@@ -141,6 +151,15 @@ namespace Tile {
 		 */
 		uint16_t normalTileSize = 0;
 
+		/**
+		 * @brief Kind of Broadphase used for the entity hitboxes.
+		 *
+		 * @details
+		 * Read from the optional `"broadphase"` key of the scene's JSON,
+		 * which can be `"quadtree"` (the default) or `"grid"`.
+		 */
+		Broadphase::Type broadphaseType = Broadphase::QuadTreeType;
+
 		/**
 		 * @copybrief Scene::setControls
 		 *
@@ -161,6 +180,11 @@ namespace Tile {
 		 */
 		void init() final;
 
+		/**
+		 * @copydoc Scene::tick
+		 */
+		void tick() final;
+
 		/**
 		 * @copydoc Scene::process
 		 */
@@ -259,22 +283,44 @@ namespace Tile {
 			tileMapRenderer.setOffset(x,y);
 		}
 
-		const std::vector<QuadTree>& getQuadTrees() { return tileMapQuadTrees.getQuadTrees(); }
+		/**
+		 * @copydoc MapQuadTrees::getBroadphases
+		 */
+		const std::vector<std::unique_ptr<Broadphase>>& getBroadphases() { return tileMapQuadTrees.getBroadphases(); }
 
-		const std::vector<QuadTree>& getSoftQuadTrees() { return tileMapQuadTrees.getSoftQuadTrees(); }
+		/**
+		 * @copydoc MapQuadTrees::getSoftBroadphases
+		 */
+		const std::vector<std::unique_ptr<Broadphase>>& getSoftBroadphases() { return tileMapQuadTrees.getSoftBroadphases(); }
 
-		void updateQuadTree(Hitbox oldBox, Hitbox newBox, ECS::entity e, unsigned layer) {
-			tileMapQuadTrees.updateQuadTree(oldBox, newBox, e, layer);
+		/**
+		 * @brief Get the kind of Broadphase that the scene's JSON asked for.
+		 *
+		 * @return The type of Broadphase.
+		 */
+		Broadphase::Type getBroadphaseType() const { return broadphaseType; }
+
+		/**
+		 * @copydoc MapQuadTrees::updateQuadTree
+		 */
+		void updateQuadTree(Hitbox box, ECS::entity e, unsigned layer) {
+			tileMapQuadTrees.updateQuadTree(box, e, layer);
 		}
 		
 		/**
-		 * @brief Get a vector of collision rectangles that collide with `rect`.
+		 * @brief Find the collision rectangles that collide with `box`.
 		 * 
-		 * @param rect SDL_FRect to test collision against
+		 * @details
+		 * The rectangles are appended to `out`, so a caller can reuse the
+		 * same vector every frame without allocating.
+		 * 
+		 * @param box Hitbox to test collision against
 		 * @param layer Which collision layer to test within
-		 * @return Vector of rectangles colliding with `rect`
+		 * @param out Vector that the rectangles colliding with `box` are appended to
 		 */
-		std::vector<SDL_FRect> queryTileCollisions(const SDL_FRect rect, std::size_t layer) const;
+		void queryTileCollisions(const Hitbox box, std::size_t layer, std::vector<Hitbox>& out) const {
+			tileCollisionMask.query(box, layer, out);
+		}
 
 		bool executeCommand(MapCommand& command);
 
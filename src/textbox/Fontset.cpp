@@ -9,7 +9,7 @@
 #include "GRY_Game.hpp"
 
 Fontset::~Fontset() {
-	SDL_DestroyTexture(texture);
+	if (ownsTexture) { SDL_DestroyTexture(texture); }
 	texture = nullptr;
 }
 
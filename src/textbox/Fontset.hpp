@@ -27,6 +27,12 @@ struct Fontset : public FileResource {
      */
 	SDL_Texture* texture = nullptr;
 
+    /**
+     * @brief Whether `texture` is destroyed with the font. `false` once it is packed into a GRY_Atlas.
+     * 
+     */
+    bool ownsTexture = true;
+
     /**
      * @brief Rectangles that define the space of each character in the texture.
      * 
@@ -72,6 +78,7 @@ struct Fontset : public FileResource {
         using std::swap;
         swap(static_cast<FileResource&>(lhs), static_cast<FileResource&>(rhs));
         swap(lhs.texture, rhs.texture);
+        swap(lhs.ownsTexture, rhs.ownsTexture);
         swap(lhs.sourceRects, rhs.sourceRects);
         swap(lhs.emWidth, rhs.emWidth);
 		swap(lhs.charHeight, rhs.charHeight);
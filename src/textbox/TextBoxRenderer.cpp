@@ -1,5 +1,4 @@
 #include "TextBoxRenderer.hpp"
-#include "SDL_RectOps.hpp"
 #include "SDL3/SDL_render.h"
 #include "../scenes/TextBoxScene.hpp"
 #include "GRY_PixelGame.hpp"
@@ -8,17 +7,15 @@
 static const float LINE_SPACING = 2.f;
 
 TextBoxRenderer::TextBoxRenderer(TextBoxScene *scene) : scene(scene),
-	renderer(scene->getGame()->getVideo().getRenderer()),
-	pixelScaling(&scene->getPixelGame()->getPixelScalingRef()) {
+	renderer(scene->getGame()->getVideo().getRenderer()) {
 }
 
 void TextBoxRenderer::beginRender() {
+	const GRY_Texture& boxTexture = scene->getBoxTexture();
 	SDL_FRect dstRect = scene->getBoxTextureArea();
-	dstRect *= *pixelScaling;
-	SDL_RenderTexture(renderer, scene->getBoxTexture(), NULL, &dstRect);
+	SDL_RenderTexture(renderer, boxTexture.texture, &boxTexture.area, &dstRect);
 
 	SDL_Rect rect = scene->getTextArea();
-	rect *= (int)*pixelScaling;
 	SDL_SetRenderViewport(renderer, &rect);
 
 	cursor.x = 0;
@@ -59,12 +56,11 @@ bool TextBoxRenderer::renderLine(const char* line, float scrollAmt, int index) {
 			continue;
 		}
 
+		/* Lines scroll by fractions of a pixel, so snap them to whole pixels */
 		SDL_FRect dstRect{
-			cursor.x, cursor.y,
+			cursor.x, floorf(cursor.y),
 			srcRect->w, srcRect->h
 		};
-		dstRect *= *pixelScaling;
-		dstRect.y = floorf(dstRect.y);
 
 		cursor.x += srcRect->w;
 		SDL_RenderTexture(renderer, font.texture, srcRect, &dstRect);
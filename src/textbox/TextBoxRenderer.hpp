@@ -27,12 +27,6 @@ private:
 	 */
 	SDL_Renderer* renderer;
 
-	/**
-	 * @brief Scaling factor for the box texture.
-	 * 
-	 */
-	const float* pixelScaling;
-
 	struct {
 		float x = 0;
 		float y = 0;
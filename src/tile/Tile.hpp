@@ -67,10 +67,13 @@ namespace Tile {
 		TileId currentFrame;
 
 		/**
-		 * @brief Length of time until the next frame, in seconds.
+		 * @brief When the next frame starts, in seconds.
 		 * 
+		 * @details
+		 * Set to the time until the next frame when adding the animation to a
+		 * Tileset. Once scheduled, it is the time on the tileset's animation clock.
 		 */
-		double timer;
+		double nextFrameTime;
 
 		/**
 		 * @brief Index of the tile to animate.
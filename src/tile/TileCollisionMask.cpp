@@ -0,0 +1,91 @@
+/**
+ * @file TileCollisionMask.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @copyright Copyright (c) 2025
+ */
+#include "TileCollisionMask.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+void Tile::CollisionMask::reset(uint32_t width, uint32_t height, float tileSize, std::size_t layerCount) {
+	this->width = width;
+	this->height = height;
+	this->tileSize = tileSize;
+	wordsPerRow = (width + 63) / 64;
+	layers.assign(layerCount, Layer{});
+	for (Layer& layer : layers) {
+		layer.bits.assign((std::size_t)wordsPerRow * height, 0);
+		layer.collisions.assign((std::size_t)width * height, 0);
+	}
+}
+
+void Tile::CollisionMask::addRect(std::size_t layer, CollisionId collision, Hitbox rect) {
+	Layer& l = layers.at(layer);
+	if (collision >= l.rects.size()) { l.rects.resize(collision + 1); }
+	l.rects[collision] = rect;
+
+	int tilex = (int)(rect.x / tileSize);
+	int tiley = (int)(rect.y / tileSize);
+	int tilew = (int)ceilf(rect.w / tileSize);
+	int tileh = (int)ceilf(rect.h / tileSize);
+	for (int y = std::max(tiley, 0); y < std::min(tiley + tileh, (int)height); y++) {
+		for (int x = std::max(tilex, 0); x < std::min(tilex + tilew, (int)width); x++) {
+			l.bits[y * wordsPerRow + x / 64] |= (uint64_t)1 << (x % 64);
+			l.collisions[y * width + x] = collision;
+		}
+	}
+}
+
+/**
+ * @details
+ * Only the rows and columns of the map that `box` covers are looked at.
+ * The bits of those tiles are checked first, so a box away from every
+ * rectangle costs a few word reads.
+ */
+void Tile::CollisionMask::query(Hitbox box, std::size_t layer, std::vector<Hitbox>& out) const {
+	const Layer& l = layers.at(layer);
+	if (!width || !height) { return; }
+	/* Truncating instead of flooring only differs below 0, which is clamped anyway */
+	int x0 = std::clamp((int)(box.x / tileSize), 0, (int)width - 1);
+	int y0 = std::clamp((int)(box.y / tileSize), 0, (int)height - 1);
+	int x1 = std::clamp((int)((box.x + box.w) / tileSize), 0, (int)width - 1);
+	int y1 = std::clamp((int)((box.y + box.h) / tileSize), 0, (int)height - 1);
+
+	const unsigned firstWord = (unsigned)x0 / 64;
+	const unsigned lastWord = (unsigned)x1 / 64;
+	const uint64_t firstMask = ~(uint64_t)0 << ((unsigned)x0 % 64);
+	const uint64_t lastMask = ~(uint64_t)0 >> (63 - (unsigned)x1 % 64);
+	auto rowWord = [&](int row, unsigned i) {
+		uint64_t word = l.bits[(std::size_t)row * wordsPerRow + i];
+		if (i == firstWord) { word &= firstMask; }
+		if (i == lastWord) { word &= lastMask; }
+		return word;
+	};
+
+	/* Boxes usually cover only a few tiles of one word per row, and most of those tiles have no collision */
+	uint64_t any = 0;
+	for (int row = y0; row <= y1; row++) {
+		for (unsigned i = firstWord; i <= lastWord; i++) { any |= rowWord(row, i); }
+	}
+	if (!any) { return; }
+
+	/* A rectangle spans every tile it belongs to, so the same one is usually found several times in a row */
+	CollisionId last = 0;
+	for (int row = y0; row <= y1; row++) {
+		const CollisionId* collisions = &l.collisions[(std::size_t)row * width];
+		for (unsigned i = firstWord; i <= lastWord; i++) {
+			uint64_t word = rowWord(row, i);
+			while (word) {
+				CollisionId collision = collisions[i * 64 + std::countr_zero(word)];
+				word &= word - 1;
+				if (collision == last) { continue; }
+				last = collision;
+				const Hitbox& rect = l.rects[collision];
+				if (box.x + box.w > rect.x && box.x < rect.x + rect.w && box.y + box.h > rect.y && box.y < rect.y + rect.h) {
+					out.push_back(rect);
+				}
+			}
+		}
+	}
+}
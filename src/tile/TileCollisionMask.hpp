@@ -0,0 +1,105 @@
+/**
+ * @file TileCollisionMask.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief @copybrief Tile::CollisionMask
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include "Tile.hpp"
+#include "Components.hpp"
+
+namespace Tile {
+	/**
+	 * @brief Finds the collision rectangles of a tile map that collide with a box.
+	 *
+	 * @details
+	 * Each layer keeps one bit per tile that is set if the tile belongs to a
+	 * collision rectangle, so looking at tiles without collision only takes
+	 * a few bit tests. Only the rectangles of the set tiles are tested against the box.
+	 *
+	 * Built once, when the map is initialized.
+	 */
+	class CollisionMask {
+	public:
+		/**
+		 * @brief Clear the mask and size it for a map.
+		 *
+		 * @param width Width of the map, in tiles.
+		 * @param height Height of the map, in tiles.
+		 * @param tileSize Width and height of a tile, in pixels.
+		 * @param layerCount Number of layers of the map.
+		 */
+		void reset(uint32_t width, uint32_t height, float tileSize, std::size_t layerCount);
+
+		/**
+		 * @brief Add a collision rectangle, and mark the tiles it belongs to.
+		 *
+		 * @details
+		 * The tiles are the ones that Tile::MapScene::init gives the rectangle:
+		 * starting at the tile that holds its top-left corner, and as many tiles
+		 * wide and tall as it takes to fit its width and height.
+		 * Tiles outside of the map are ignored.
+		 *
+		 * @param layer Layer of the rectangle.
+		 * @param collision Id of the rectangle, which must not be 0.
+		 * @param rect The rectangle, in pixels.
+		 */
+		void addRect(std::size_t layer, CollisionId collision, Hitbox rect);
+
+		/**
+		 * @brief Find the collision rectangles that collide with `box`.
+		 *
+		 * @details
+		 * Rectangles are appended to `out` in the order of the tiles they were found on,
+		 * row by row. A rectangle is not appended twice in a row.
+		 *
+		 * @param box Box to test collision against.
+		 * @param layer Which layer to test within.
+		 * @param out Vector that the rectangles colliding with `box` are appended to.
+		 */
+		void query(Hitbox box, std::size_t layer, std::vector<Hitbox>& out) const;
+
+		/**
+		 * @brief Check if a tile belongs to a collision rectangle.
+		 *
+		 * @param layer Layer of the tile.
+		 * @param x Column of the tile.
+		 * @param y Row of the tile.
+		 * @return `true` if it does, `false` otherwise.
+		 */
+		bool isSolid(std::size_t layer, uint32_t x, uint32_t y) const {
+			return layers.at(layer).bits[y * wordsPerRow + x / 64] >> (x % 64) & 1;
+		}
+
+	private:
+		/**
+		 * @brief Mask and rectangles of one layer.
+		 *
+		 */
+		struct Layer {
+			/**
+			 * @brief One bit per tile, row by row, with each row starting on a new word.
+			 *
+			 */
+			std::vector<uint64_t> bits;
+
+			/**
+			 * @brief Collision id of each tile, row by row.
+			 *
+			 */
+			std::vector<CollisionId> collisions;
+
+			/**
+			 * @brief Rectangles of the layer, by collision id.
+			 *
+			 */
+			std::vector<Hitbox> rects;
+		};
+
+		std::vector<Layer> layers;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t wordsPerRow = 0;
+		float tileSize = 0;
+	};
+};
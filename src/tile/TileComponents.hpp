@@ -100,7 +100,7 @@ namespace Tile {
 	};
 
 	struct Player {
-		entity speakingTo = ECS::NONE;
+		ECS::handle speakingTo = ECS::NONE_HANDLE;
 	};
 
 	struct NPC {};
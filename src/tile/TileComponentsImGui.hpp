@@ -74,11 +74,11 @@ void componentImGui(Tile::ActorSpriteAnims& anims) {
 
 template<>
 void componentImGui(Tile::Player& player) {
-	if (player.speakingTo == ECS::NONE) {
+	if (player.speakingTo == ECS::NONE_HANDLE) {
 		ImGui::Text("speakingTo: None");
 	}
 	else {
-		ImGui::Text("speakingTo: %d", player.speakingTo);
+		ImGui::Text("speakingTo: %d (generation %d)", player.speakingTo.index, player.speakingTo.generation);
 	}
 }
 
@@ -0,0 +1,75 @@
+/**
+ * @file TileEntityLayerSort.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief Keeps entity layers ordered by position, y first and then x.
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include "Components.hpp"
+#include <vector>
+#include <algorithm>
+
+namespace Tile {
+	/**
+	 * @brief Check if `p1` comes before `p2` in an entity layer.
+	 * 
+	 * @param p1 First position.
+	 * @param p2 Second position.
+	 * @return `true` if `p1` is above `p2`, or level with it and to its left.
+	 */
+	inline bool positionLessThan(Position2 p1, Position2 p2) {
+		if (p1[1] == p2[1]) { return p1[0] < p2[0]; }
+		else { return p1[1] < p2[1]; }
+	}
+
+	/**
+	 * @brief Fully sort a layer of entities by position.
+	 * 
+	 * @tparam PositionSet ComponentSet of Position2.
+	 * @tparam entity Identifier type of the ECS.
+	 * @param positions Positions of the entities.
+	 * @param layer Entities to sort.
+	 */
+	template<class PositionSet, typename entity>
+	void sortEntityLayer(const PositionSet& positions, std::vector<entity>& layer) {
+		std::stable_sort(layer.begin(), layer.end(), [&](entity lhs, entity rhs) {
+			return positionLessThan(positions.get(lhs), positions.get(rhs));
+		});
+	}
+
+	/**
+	 * @brief Re-seat moved entities in a layer that was sorted before they moved.
+	 * 
+	 * @details
+	 * The moved entities are taken out of the layer, sorted among themselves,
+	 * and merged back in. Entities without a position are dropped.
+	 * `moved` is cleared, and the flags of its entities are reset.
+	 * 
+	 * @tparam PositionSet ComponentSet of Position2.
+	 * @tparam entity Identifier type of the ECS.
+	 * @param positions Positions of the entities.
+	 * @param layer Sorted layer that contains the moved entities.
+	 * @param moved Entities of the layer that moved, without repeats.
+	 * @param movedFlags Whether each entity is in `moved`, indexed by entity.
+	 * @param buffer Scratch space for the merge.
+	 */
+	template<class PositionSet, typename entity>
+	void mergeMovedEntities(const PositionSet& positions, std::vector<entity>& layer, std::vector<entity>& moved, std::vector<bool>& movedFlags, std::vector<entity>& buffer) {
+		if (moved.empty()) { return; }
+		auto lessThan = [&](entity lhs, entity rhs) {
+			return positionLessThan(positions.get(lhs), positions.get(rhs));
+		};
+
+		/* Take the moved entities out, the rest of the layer stays sorted */
+		std::erase_if(layer, [&](entity e) { return movedFlags[e] || !positions.contains(e); });
+		for (entity e : moved) { movedFlags[e] = false; }
+		std::erase_if(moved, [&](entity e) { return !positions.contains(e); });
+		std::sort(moved.begin(), moved.end(), lessThan);
+
+		/* Merge them back in */
+		buffer.resize(layer.size() + moved.size());
+		std::merge(layer.begin(), layer.end(), moved.begin(), moved.end(), buffer.begin(), lessThan);
+		std::swap(layer, buffer);
+		moved.clear();
+	}
+};
@@ -7,12 +7,13 @@
 #include "GRY_JSON.hpp"
 #include "TileComponents.hpp"
 #include "TileRegisterMapCommandFuncs.hpp"
+#include "TileEntityLayerSort.hpp"
 
 using TileId = Tile::TileId;
 using TilesetId = Tile::TilesetId;
 using entity = ECS::entity;
 
-static entity registerEntity(Tile::EntityMap& eMap, const GRY_JSON::Value& entityData, float normalTileSize, uint8_t layer);
+static entity registerEntity(Tile::EntityMap& eMap, const GRY_JSON::Value& entityData, float normalTileSize);
 
 static void registerPosition(Tile::EntityMap& eMap, entity e, const GRY_JSON::Value& pos, float normalTileSize);
 static void registerHitbox(Tile::EntityMap& eMap, entity e, const GRY_JSON::Value& hitbox);
@@ -24,12 +25,17 @@ static void registerNPC(Tile::EntityMap& eMap, entity e);
 static void registerMapInteraction(Tile::EntityMap& eMap, entity e, float normalTileSize, const GRY_JSON::Value& interactionData);
 static void registerMapCommands(Tile::EntityMap& eMap, entity e, float normalTileSize, const GRY_JSON::Value& commandData);
 static void registerCollisionInteraction(Tile::EntityMap& eMap, entity e, float normalTileSize, const GRY_JSON::Value& collisionInteractionData);
-static void sortEntityLayer(ComponentSet<Position2>& positions, std::vector<entity>& layer);
 
 Tile::EntityMap::~EntityMap() {
 	for (auto filePath : paths) { delete[] filePath; }
 }
 
+/**
+ * @details
+ * The capacity of the ECS is set to the map's "maxEntities" value if it has
+ * one. Otherwise it leaves as much room again as the map's entities take,
+ * and at least DEFAULT_SPARE_ENTITIES, so entities can still be spawned.
+ */
 bool Tile::EntityMap::load(GRY_Game *game) {
 	if (!entityLayers.empty()) { return true; }
 	GRY_JSON::Document doc;
@@ -58,18 +64,36 @@ bool Tile::EntityMap::load(GRY_Game *game) {
 		}
 	}
 
+	/* Size the ECS from the map data, leaving room for any extra entities the map asks for */
+	std::size_t entityCount = 0;
+	for (auto& layerData : doc["layers"].GetArray()) { entityCount += layerData.GetArray().Size(); }
+	if (doc.HasMember("maxEntities")) {
+		GRY_Assert(doc["maxEntities"].GetUint() >= entityCount,
+			"[Tile::EntityMap] maxEntities (%u) is less than the number of entities in the map (%zu).\n",
+			doc["maxEntities"].GetUint(), entityCount
+		);
+		entityCount = std::max(entityCount, (std::size_t)doc["maxEntities"].GetUint());
+	}
+	else {
+		entityCount = std::min(entityCount + std::max(entityCount, DEFAULT_SPARE_ENTITIES), (std::size_t)ECS::MAX_ENTITIES);
+	}
+	ecs->setCapacity(entityCount);
+
 	/* Load entity layer data */
 	for (int i = 0; i < doc["layers"].GetArray().Size(); i++) {
 		auto& layerData = doc["layers"].GetArray()[i];
 		EntityLayer entityLayer;
 		/* Load entity data */
 		for (auto& entityData : layerData.GetArray()) {
-			entity e = registerEntity(*this, entityData, normalTileSize, i);
+			entity e = registerEntity(*this, entityData, normalTileSize);
 			entityLayer.push_back(e);
 		}
+		this->ecs->getComponent<MapEntity>().addRange(entityLayer.begin(), entityLayer.end(), MapEntity{ (uint8_t)i });
 		sortEntityLayer(this->ecs->getComponent<Position2>(), entityLayer);
 		entityLayers.push_back(entityLayer);
 	}
+	movedEntities.resize(entityLayers.size());
+	movedFlags.assign(ecs->getCapacity(), false);
 	updateLayers(this);
 
 	/* Return false normally, but if there were no layers we can return true. */
@@ -80,6 +104,39 @@ void Tile::EntityMap::sortLayer(EntityMap *entityMap, unsigned layer) {
 	sortEntityLayer(entityMap->ecs->getComponent<Position2>(), entityMap->entityLayers.at(layer));
 }
 
+void Tile::EntityMap::markMoved(EntityMap* entityMap, entity e, unsigned layer) {
+	if (entityMap->movedFlags.size() <= e) { entityMap->movedFlags.resize((std::size_t)e + 1, false); }
+	if (entityMap->movedFlags[e]) { return; }
+	entityMap->movedFlags[e] = true;
+	entityMap->movedEntities.at(layer).push_back(e);
+}
+
+void Tile::EntityMap::sortMoved(EntityMap* entityMap) {
+	for (int layer = 0; layer < entityMap->movedEntities.size(); layer++) {
+		mergeMovedEntities(
+			entityMap->ecs->getComponent<Position2>(),
+			entityMap->entityLayers.at(layer),
+			entityMap->movedEntities[layer],
+			entityMap->movedFlags,
+			entityMap->mergeBuffer
+		);
+	}
+}
+
+void Tile::EntityMap::removeFreed(EntityMap* entityMap) {
+	const ComponentSet<MapEntity>& mapEntities = entityMap->ecs->getComponentReadOnly<MapEntity>();
+	auto freed = [&mapEntities](entity e) { return !mapEntities.contains(e); };
+	for (EntityLayer& layer : entityMap->entityLayers) {
+		layer.erase(std::remove_if(layer.begin(), layer.end(), freed), layer.end());
+	}
+	for (EntityLayer& moved : entityMap->movedEntities) {
+		for (entity e : moved) {
+			if (freed(e)) { entityMap->movedFlags[e] = false; }
+		}
+		moved.erase(std::remove_if(moved.begin(), moved.end(), freed), moved.end());
+	}
+}
+
 void Tile::EntityMap::updateLayers(EntityMap* entityMap) {
 	ComponentSet<MapEntity>& mapEntities = entityMap->ecs->getComponent<MapEntity>();
 	for (int layer = 0; layer < entityMap->entityLayers.size(); layer++) {
@@ -89,7 +146,7 @@ void Tile::EntityMap::updateLayers(EntityMap* entityMap) {
 	}
 }
 
-entity registerEntity(Tile::EntityMap& eMap, const GRY_JSON::Value& entityData, float normalTileSize, uint8_t layer) {
+entity registerEntity(Tile::EntityMap& eMap, const GRY_JSON::Value& entityData, float normalTileSize) {
 	entity e = eMap.ecs->createEntity();
 
 	GRY_Assert(entityData.HasMember("position"),
@@ -106,9 +163,6 @@ entity registerEntity(Tile::EntityMap& eMap, const GRY_JSON::Value& entityData,
 	if (entityData.HasMember("commands")) { registerMapCommands(eMap, e, normalTileSize, entityData["commands"]); }
 	if (entityData.HasMember("collisionInteraction")) { registerCollisionInteraction(eMap, e, normalTileSize, entityData["collisionInteraction"]); }
 
-	Tile::MapEntity mapEntity{ layer };
-	eMap.ecs->getComponent<Tile::MapEntity>().add(e, mapEntity);
-
 	return e;
 }
 
@@ -267,18 +321,3 @@ void registerActorSpriteAnimations(Tile::EntityMap& eMap, entity e, const GRY_JS
 
 	eMap.ecs->getComponent<Tile::ActorSpriteAnims>().add(e, anims);
 }
-
-void sortEntityLayer(ComponentSet<Position2>& positions, std::vector<entity>& layer) {
-	auto lessThan = [&](Position2 p1, Position2 p2) {
-		if (p1[1] == p2[1]) { return p1[0] < p2[0]; }
-		else { return p1[1] < p2[1]; }
-	};
-
-	for (int i = 1; i < layer.size(); i++) {
-		int j = i;
-		while (j > 0 && lessThan(positions.get(layer[i]), positions.get(layer[i-1]))) {
-			std::swap(layer[j], layer[j-1]);
-			j--;
-		}
-	}
-}
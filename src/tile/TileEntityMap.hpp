@@ -13,8 +13,23 @@ namespace Tile {
 	/**
 	 * @brief Represents the entities of a tile map.
 	 * 
+	 * @details
+	 * The JSON file has these members:
+	 * - "normalTileSize": Size of a tile in pixels, that entity positions are given in.
+	 * - "tilesets": Paths of the tilesets the entities' sprites come from.
+	 * - "paths": Paths of the map scenes that map commands can switch to, by index.
+	 * - "layers": An array of entities for each layer.
+	 * - "maxEntities": Optional. Number of entities the map can hold at once, including
+	 * ones spawned after loading. If it is missing, the map's own entities get as much
+	 * room again, and at least DEFAULT_SPARE_ENTITIES.
 	 */
 	struct EntityMap : public FileResource {
+		/**
+		 * @brief Least room left for spawned entities, when the map does not give "maxEntities".
+		 * 
+		 */
+		static constexpr std::size_t DEFAULT_SPARE_ENTITIES = 256;
+
 		std::vector<EntityLayer> entityLayers;
 
 		std::vector<Tileset> tilesets;
@@ -23,6 +38,25 @@ namespace Tile {
 
 		MapECS* ecs;
 
+		/**
+		 * @brief Entities that have moved since their layer was last sorted, for each layer.
+		 * 
+		 * @sa markMoved, sortMoved
+		 */
+		std::vector<EntityLayer> movedEntities;
+
+		/**
+		 * @brief Whether each entity is in `movedEntities`, indexed by entity.
+		 * 
+		 */
+		std::vector<bool> movedFlags;
+
+		/**
+		 * @brief Scratch space used while merging moved entities back into a layer.
+		 * 
+		 */
+		EntityLayer mergeBuffer;
+
 		EntityMap(MapECS& ecs) : ecs(&ecs) {}
 
 		EntityMap(const char* path, MapECS& ecs) : FileResource(path), ecs(&ecs) {}
@@ -38,13 +72,57 @@ namespace Tile {
 			swap(lhs.ecs, rhs.ecs);
 			swap(lhs.entityLayers, rhs.entityLayers);
 			swap(lhs.tilesets, rhs.tilesets);
+			swap(lhs.movedEntities, rhs.movedEntities);
+			swap(lhs.movedFlags, rhs.movedFlags);
+			swap(lhs.mergeBuffer, rhs.mergeBuffer);
 		}
 
 		EntityMap(EntityMap&& other) noexcept { swap(*this, other); }
 
 		bool load(GRY_Game* game) final override;
 
+		/**
+		 * @brief Fully sort a layer by position, y first and then x.
+		 * 
+		 * @param entityMap The EntityMap.
+		 * @param layer Index of the layer.
+		 */
 		static void sortLayer(EntityMap* entityMap, unsigned layer);
+
+		/**
+		 * @brief Record that an entity's position changed, so it is re-seated at the next sortMoved.
+		 * 
+		 * @param entityMap The EntityMap.
+		 * @param e Entity that moved.
+		 * @param layer Index of the layer the entity is on.
+		 */
+		static void markMoved(EntityMap* entityMap, entity e, unsigned layer);
+
+		/**
+		 * @brief Re-seat the entities recorded with markMoved, keeping every layer sorted by position.
+		 * 
+		 * @details
+		 * The moved entities are taken out of their layer, sorted among themselves,
+		 * and merged back in, so the cost is linear in the layer size plus
+		 * `k log k` for `k` moved entities. Entities without a position,
+		 * like ones that were freed, are dropped from the layer.
+		 * 
+		 * @param entityMap The EntityMap.
+		 */
+		static void sortMoved(EntityMap* entityMap);
+
+		/**
+		 * @brief Drop freed entities from every layer and from the moved entities.
+		 * 
+		 * @details
+		 * Freed entities have no MapEntity component, so any id without one is
+		 * dropped. The layers stay sorted. Call it right after entities are freed,
+		 * before anything looks up the components of the entities in a layer.
+		 * 
+		 * @param entityMap The EntityMap.
+		 */
+		static void removeFreed(EntityMap* entityMap);
+
 		static void updateLayers(EntityMap* entityMap);
 	};
 };
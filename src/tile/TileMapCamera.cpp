@@ -10,8 +10,7 @@
 Tile::MapCamera::MapCamera(MapScene *scene) : scene(scene),
 	hitboxes(&scene->getECSReadOnly().getComponentReadOnly<Hitbox>()),
 	positions(&scene->getECSReadOnly().getComponentReadOnly<Position2>()),
-	players(&scene->getECSReadOnly().getComponentReadOnly<Player>()),
-	pixelScaling(&scene->getPixelGame()->getPixelScalingRef()) {
+	players(&scene->getECSReadOnly().getComponentReadOnly<Player>()) {
 }
 
 void Tile::MapCamera::process() {
@@ -24,10 +23,13 @@ void Tile::MapCamera::process() {
 			playerHitbox.y + (playerHitbox.h * 0.5f) - .01f
 		};
 	}
+}
 
+void Tile::MapCamera::updateRenderOffset() {
+	Position2 renderCenter = previousCenter + (center - previousCenter) * scene->getGame()->getInterpolation();
 	scene->setRenderOffset(
-		(scene->getPixelGame()->getScreenWidthPixels() * 0.5f) - center.x,
-		(scene->getPixelGame()->getScreenHeightPixels() * 0.5f) - center.y
+		(scene->getPixelGame()->getScreenWidthPixels() * 0.5f) - renderCenter.x,
+		(scene->getPixelGame()->getScreenHeightPixels() * 0.5f) - renderCenter.y
 	);
 }
 
@@ -24,16 +24,16 @@ namespace Tile {
 		MapScene* scene;
 
 		/**
-		 * @brief Scaling factor for the rendering offset.
+		 * @brief The center coordinate of the screen used to calculate rendering offset.
 		 * 
 		 */
-		const float* pixelScaling;
+		Position2 center;
 
 		/**
-		 * @brief The center coordinate of the screen used to calculate rendering offset.
+		 * @brief The center coordinate when the current simulation tick started.
 		 * 
 		 */
-		Position2 center;
+		Position2 previousCenter;
 
 		/**
 		 * @brief Hitboxes of entities.
@@ -65,11 +65,26 @@ namespace Tile {
 		MapCamera(MapScene* scene);
 
 		/**
-		 * @brief Sets the rendering offset based on the player's position.
+		 * @brief Moves the camera to the player's position, if the camera is locked.
 		 * 
 		 */
 		void process();
 
+		/**
+		 * @brief Remember the camera's position. Should be called before each simulation tick.
+		 * 
+		 */
+		void savePosition() { previousCenter = center; }
+
+		/**
+		 * @brief Sets the rendering offset, between the camera's previous and current position.
+		 * 
+		 * @details
+		 * Uses the game's interpolation, the same as the MapRenderer does for entities,
+		 * so that a followed player stays still on the screen.
+		 */
+		void updateRenderOffset();
+
 		void lockCamera() { cameraLocked = true; }
 
 		void unlockCamera() { cameraLocked = false; }
@@ -0,0 +1,214 @@
+/**
+ * @file TileMapChunks.cpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @copyright Copyright (c) 2025
+ */
+#include "TileMapChunks.hpp"
+#include "GRY_Log.hpp"
+#include "SDL3/SDL_render.h"
+#include <algorithm>
+
+Tile::MapChunks::~MapChunks() {
+	for (auto& layer : layers) {
+		for (Chunk& chunk : layer) { SDL_DestroyTexture(chunk.texture); }
+	}
+}
+
+void Tile::MapChunks::reset() {
+	for (auto& layer : layers) {
+		for (Chunk& chunk : layer) { SDL_DestroyTexture(chunk.texture); }
+	}
+	textureCount = 0;
+
+	chunksX = (tileMap->width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	chunksY = (tileMap->height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	layers.assign(tileMap->tileLayers.size(), std::vector<Chunk>(chunksX * chunksY));
+
+	const Tileset& tileset = tileMap->tileset;
+	animatedIds.assign(tileset.textureIdx.size(), false);
+	for (const Animation& animation : tileset.tileAnimations) { animatedIds.at(animation.tile) = true; }
+}
+
+void Tile::MapChunks::evictTexture() {
+	Chunk* oldest = nullptr;
+	for (auto& layer : layers) {
+		for (Chunk& chunk : layer) {
+			if (!chunk.texture || chunk.lastUsed == frame) { continue; }
+			if (!oldest || chunk.lastUsed < oldest->lastUsed) { oldest = &chunk; }
+		}
+	}
+	if (!oldest) { return; }
+
+	SDL_DestroyTexture(oldest->texture);
+	oldest->texture = nullptr;
+	oldest->dirty = true;
+	textureCount--;
+}
+
+/**
+ * @details
+ * The tiles are drawn without blending. Each tile covers its own square, so
+ * this copies them exactly, where blending onto the cleared texture would
+ * darken any partly transparent pixels when the chunk is drawn.
+ *
+ * If the texture cannot be made, `drawRows` draws the chunk's tiles one by one.
+ */
+void Tile::MapChunks::build(std::size_t layer, uint32_t chunkX, uint32_t chunkY) {
+	Chunk& chunk = getChunk(layer, chunkX, chunkY);
+	const Tileset& tileset = tileMap->tileset;
+	const TileLayer& tiles = tileMap->tileLayers[layer];
+	const uint32_t left = chunkX * CHUNK_SIZE;
+	const uint32_t top = chunkY * CHUNK_SIZE;
+	const uint32_t right = std::min(tileMap->width, left + CHUNK_SIZE);
+	const uint32_t bottom = std::min((uint32_t)tiles.size() / tileMap->width, top + CHUNK_SIZE);
+	chunk.dirty = false;
+
+	/* Find the animated tiles */
+	chunk.animated.clear();
+	for (uint32_t y = top; y < bottom; y++) {
+		for (uint32_t x = left; x < right; x++) {
+			TileId id = tiles[y * tileMap->width + x].id;
+			if (id < animatedIds.size() && animatedIds[id]) { chunk.animated.push_back(AnimatedTile{ x, y, id }); }
+		}
+	}
+
+	/* Make the texture */
+	if (!chunk.texture) {
+		if (textureCount >= MAX_TEXTURES) { evictTexture(); }
+		chunk.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+			(int)(CHUNK_SIZE * tileset.tileWidth), (int)(CHUNK_SIZE * tileset.tileHeight)
+		);
+		if (!chunk.texture) {
+			GRY_Log("[Tile::MapChunks] Could not create chunk texture. Error: %s\n", SDL_GetError());
+			return;
+		}
+		SDL_SetTextureScaleMode(chunk.texture, SDL_SCALEMODE_NEAREST);
+		SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+		textureCount++;
+	}
+
+	/* Save the renderer state that drawing the chunk changes */
+	SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+	Uint8 r, g, b, a;
+	SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+	SDL_BlendMode tilesetBlendMode;
+	SDL_GetTextureBlendMode(tileset.texture, &tilesetBlendMode);
+
+	/* Draw the static tiles */
+	SDL_SetRenderTarget(renderer, chunk.texture);
+	SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0x00);
+	SDL_RenderClear(renderer);
+	SDL_SetTextureBlendMode(tileset.texture, SDL_BLENDMODE_NONE);
+	for (uint32_t y = top; y < bottom; y++) {
+		for (uint32_t x = left; x < right; x++) {
+			TileId id = tiles[y * tileMap->width + x].id;
+			if (!id || (id < animatedIds.size() && animatedIds[id])) { continue; }
+			SDL_FRect dstRect{
+				(x - left) * tileset.tileWidth, (y - top) * tileset.tileHeight,
+				tileset.tileWidth, tileset.tileHeight
+			};
+			SDL_RenderTexture(renderer, tileset.texture, tileset.getSourceRect(id), &dstRect);
+		}
+	}
+
+	SDL_SetTextureBlendMode(tileset.texture, tilesetBlendMode);
+	SDL_SetRenderDrawColor(renderer, r, g, b, a);
+	SDL_SetRenderTarget(renderer, previousTarget);
+}
+
+/**
+ * @details
+ * Render targets lose what was drawn to them when the renderer resets them,
+ * for example when a Direct3D device is lost, so every chunk is drawn again
+ * after a reset.
+ */
+void Tile::MapChunks::prepare(uint32_t startX, uint32_t startY, uint32_t endX, uint32_t endY, unsigned targetResets) {
+	uint32_t mapChunksX = (tileMap->width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	uint32_t mapChunksY = (tileMap->height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	if (layers.size() != tileMap->tileLayers.size() || chunksX != mapChunksX || chunksY != mapChunksY) { reset(); }
+	if (this->targetResets != targetResets) {
+		invalidate();
+		this->targetResets = targetResets;
+	}
+
+	frame++;
+	if (startX >= endX) { return; }
+
+	/* Mark the chunks in view first, so that making their textures does not evict each other's */
+	for (int pass = 0; pass < 2; pass++) {
+		for (std::size_t i = 0; i < layers.size(); i++) {
+			uint32_t layerEndY = std::min(endY, (uint32_t)tileMap->tileLayers[i].size() / tileMap->width);
+			for (uint32_t chunkY = startY / CHUNK_SIZE; chunkY * CHUNK_SIZE < layerEndY; chunkY++) {
+				for (uint32_t chunkX = startX / CHUNK_SIZE; chunkX * CHUNK_SIZE < endX; chunkX++) {
+					Chunk& chunk = getChunk(i, chunkX, chunkY);
+					if (pass == 0) { chunk.lastUsed = frame; }
+					else if (chunk.dirty) { build(i, chunkX, chunkY); }
+				}
+			}
+		}
+	}
+}
+
+void Tile::MapChunks::drawRows(GRY_RenderBatch& batch, std::size_t layer, uint32_t startX, uint32_t endX,
+	uint32_t rowBegin, uint32_t rowEnd, float originX, float originY, float shift) {
+	if (rowBegin >= rowEnd || startX >= endX) { return; }
+	const Tileset& tileset = tileMap->tileset;
+	const TileLayer& tiles = tileMap->tileLayers[layer];
+
+	/* Static tiles */
+	for (uint32_t chunkY = rowBegin / CHUNK_SIZE; chunkY * CHUNK_SIZE < rowEnd; chunkY++) {
+		uint32_t top = std::max(rowBegin, chunkY * CHUNK_SIZE);
+		uint32_t bottom = std::min(rowEnd, (chunkY + 1) * CHUNK_SIZE);
+		float y = originY + (top - rowBegin) * shift;
+
+		for (uint32_t chunkX = startX / CHUNK_SIZE; chunkX * CHUNK_SIZE < endX; chunkX++) {
+			const Chunk& chunk = getChunk(layer, chunkX, chunkY);
+			uint32_t left = chunkX * CHUNK_SIZE;
+			uint32_t right = std::min(tileMap->width, left + CHUNK_SIZE);
+			float x = originX + ((float)left - (float)startX) * shift;
+
+			if (chunk.texture) {
+				SDL_FRect srcRect{
+					0.f, (top - chunkY * CHUNK_SIZE) * tileset.tileHeight,
+					(right - left) * tileset.tileWidth, (bottom - top) * tileset.tileHeight
+				};
+				SDL_FRect dstRect{ x, y, srcRect.w, srcRect.h };
+				batch.add(chunk.texture, srcRect, dstRect);
+				continue;
+			}
+
+			/* No texture, draw the tiles themselves */
+			for (uint32_t tileY = top; tileY < bottom; tileY++) {
+				for (uint32_t tileX = std::max(left, startX); tileX < std::min(right, endX); tileX++) {
+					TileId id = tiles[tileY * tileMap->width + tileX].id;
+					if (!id || (id < animatedIds.size() && animatedIds[id])) { continue; }
+					SDL_FRect dstRect{
+						originX + (tileX - startX) * shift, originY + (tileY - rowBegin) * shift,
+						tileset.tileWidth, tileset.tileHeight
+					};
+					batch.add(tileset.texture, *tileset.getSourceRect(id), dstRect);
+				}
+			}
+		}
+	}
+
+	/* Animated tiles, over the static ones */
+	for (uint32_t chunkY = rowBegin / CHUNK_SIZE; chunkY * CHUNK_SIZE < rowEnd; chunkY++) {
+		for (uint32_t chunkX = startX / CHUNK_SIZE; chunkX * CHUNK_SIZE < endX; chunkX++) {
+			for (const AnimatedTile& tile : getChunk(layer, chunkX, chunkY).animated) {
+				if (tile.y < rowBegin || tile.y >= rowEnd || tile.x < startX || tile.x >= endX) { continue; }
+				SDL_FRect dstRect{
+					originX + (tile.x - startX) * shift, originY + (tile.y - rowBegin) * shift,
+					tileset.tileWidth, tileset.tileHeight
+				};
+				batch.add(tileset.texture, *tileset.getSourceRect(tile.id), dstRect);
+			}
+		}
+	}
+}
+
+void Tile::MapChunks::invalidate() {
+	for (auto& layer : layers) {
+		for (Chunk& chunk : layer) { chunk.dirty = true; }
+	}
+}
@@ -0,0 +1,249 @@
+/**
+ * @file TileMapChunks.hpp
+ * @author Grayedsol (grayedsol@gmail.com)
+ * @brief @copybrief Tile::MapChunks
+ * @copyright Copyright (c) 2025
+ */
+#pragma once
+#include "TileTileMap.hpp"
+#include "GRY_RenderBatch.hpp"
+
+struct SDL_Renderer;
+struct SDL_Texture;
+
+namespace Tile {
+	/**
+	 * @brief Caches the static tiles of a tile map in textures, one per square chunk of tiles.
+	 *
+	 * @details
+	 * Each layer is split into chunks of CHUNK_SIZE by CHUNK_SIZE tiles. The
+	 * first time a chunk is on screen, its tiles are drawn once into a
+	 * texture. After that, drawing any rows of the chunk is one quad.
+	 *
+	 * Animated tiles change which source rect they use, so they are left out
+	 * of the textures and drawn over them every frame. Nothing changes the
+	 * other tiles after the map is loaded, so a chunk is only drawn again
+	 * after the renderer resets its render targets.
+	 *
+	 * Only the most recently used MAX_TEXTURES chunks keep a texture, so large
+	 * maps do not hold every chunk in video memory at once.
+	 */
+	class MapChunks {
+	public:
+		/**
+		 * @brief Width and height of a chunk, in tiles.
+		 *
+		 */
+		static const uint32_t CHUNK_SIZE = 16;
+
+		/**
+		 * @brief Number of chunk textures kept at once, over all layers.
+		 *
+		 */
+		static const std::size_t MAX_TEXTURES = 64;
+
+	private:
+		/**
+		 * @brief An animated tile of a chunk.
+		 *
+		 */
+		struct AnimatedTile {
+			/**
+			 * @brief Column of the tile in the map.
+			 *
+			 */
+			uint32_t x;
+
+			/**
+			 * @brief Row of the tile in the map.
+			 *
+			 */
+			uint32_t y;
+
+			/**
+			 * @brief Id of the tile.
+			 *
+			 */
+			TileId id;
+		};
+
+		/**
+		 * @brief A square of tiles of one layer.
+		 *
+		 */
+		struct Chunk {
+			/**
+			 * @brief Texture holding the static tiles of the chunk, or `nullptr` if it has none yet.
+			 *
+			 */
+			SDL_Texture* texture = nullptr;
+
+			/**
+			 * @brief Whether the texture and `animated` have to be made again before drawing.
+			 *
+			 */
+			bool dirty = true;
+
+			/**
+			 * @brief Last frame the chunk was drawn, to find the least recently used texture.
+			 *
+			 */
+			uint64_t lastUsed = 0;
+
+			/**
+			 * @brief Animated tiles of the chunk, row by row.
+			 *
+			 */
+			std::vector<AnimatedTile> animated;
+		};
+
+		/**
+		 * @brief Pointer to the renderer.
+		 *
+		 */
+		SDL_Renderer* renderer;
+
+		/**
+		 * @brief Pointer to the TileMap.
+		 *
+		 */
+		const TileMap* tileMap;
+
+		/**
+		 * @brief Chunks of each layer, row by row.
+		 *
+		 */
+		std::vector<std::vector<Chunk>> layers;
+
+		/**
+		 * @brief Whether each TileId of the tileset is animated.
+		 *
+		 */
+		std::vector<bool> animatedIds;
+
+		/**
+		 * @brief Width of the map, in chunks.
+		 *
+		 */
+		uint32_t chunksX = 0;
+
+		/**
+		 * @brief Height of the map, in chunks.
+		 *
+		 */
+		uint32_t chunksY = 0;
+
+		/**
+		 * @brief Number of chunks that have a texture.
+		 *
+		 */
+		std::size_t textureCount = 0;
+
+		/**
+		 * @brief Number of times `prepare` was called.
+		 *
+		 */
+		uint64_t frame = 0;
+
+		/**
+		 * @brief Number of render target resets when the textures were last drawn.
+		 *
+		 */
+		unsigned targetResets = 0;
+
+		/**
+		 * @brief Destroy every texture and make the chunks for the map's current size.
+		 *
+		 */
+		void reset();
+
+		/**
+		 * @brief Get a chunk.
+		 *
+		 * @param layer Index of the layer.
+		 * @param chunkX Column of the chunk.
+		 * @param chunkY Row of the chunk.
+		 * @return Reference to the chunk.
+		 */
+		Chunk& getChunk(std::size_t layer, uint32_t chunkX, uint32_t chunkY) {
+			return layers[layer][chunkY * chunksX + chunkX];
+		}
+
+		/**
+		 * @brief Destroy the texture of the least recently used chunk that is not on screen.
+		 *
+		 */
+		void evictTexture();
+
+		/**
+		 * @brief Draw the static tiles of a chunk into its texture, and find its animated tiles.
+		 *
+		 * @param layer Index of the layer.
+		 * @param chunkX Column of the chunk.
+		 * @param chunkY Row of the chunk.
+		 */
+		void build(std::size_t layer, uint32_t chunkX, uint32_t chunkY);
+
+	public:
+		/**
+		 * @brief Constructor.
+		 *
+		 * @param renderer Renderer to make and draw the textures with.
+		 * @param tileMap TileMap to cache. Does not need to be loaded yet.
+		 */
+		MapChunks(SDL_Renderer* renderer, const TileMap* tileMap) : renderer(renderer), tileMap(tileMap) {}
+
+		/**
+		 * @brief Destructor.
+		 *
+		 */
+		~MapChunks();
+
+		MapChunks(const MapChunks&) = delete;
+		MapChunks& operator=(const MapChunks&) = delete;
+
+		/**
+		 * @brief Make sure the chunks in view have up to date textures.
+		 *
+		 * @details
+		 * Drawing a chunk changes the render target, so this has to be called
+		 * before anything is added to a batch that has not been flushed.
+		 *
+		 * @param startX First column in view.
+		 * @param startY First row in view.
+		 * @param endX Column after the last one in view.
+		 * @param endY Row after the last one in view.
+		 * @param targetResets Number of times the renderer lost its render targets so far.
+		 */
+		void prepare(uint32_t startX, uint32_t startY, uint32_t endX, uint32_t endY, unsigned targetResets);
+
+		/**
+		 * @brief Draw rows of a layer: the parts of the chunk textures covering them, then the animated tiles in them.
+		 *
+		 * @param batch Batch to draw with.
+		 * @param layer Index of the layer.
+		 * @param startX First column in view.
+		 * @param endX Column after the last one in view.
+		 * @param rowBegin First row to draw.
+		 * @param rowEnd Row after the last one to draw.
+		 * @param originX Screen x of column `startX`.
+		 * @param originY Screen y of row `rowBegin`.
+		 * @param shift Distance between two columns or rows on the screen.
+		 */
+		void drawRows(GRY_RenderBatch& batch, std::size_t layer, uint32_t startX, uint32_t endX,
+			uint32_t rowBegin, uint32_t rowEnd, float originX, float originY, float shift);
+
+		/**
+		 * @brief Redraw every chunk the next time it is on screen.
+		 *
+		 */
+		void invalidate();
+
+		/**
+		 * @brief Get the number of chunks that have a texture.
+		 *
+		 * @return The number of cached chunks.
+		 */
+		std::size_t getTextureCount() const { return textureCount; }
+	};
+};
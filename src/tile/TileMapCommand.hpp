@@ -56,7 +56,7 @@ namespace Tile {
 
 	struct TMC_None {
 		MapCommandType type = MAP_CMD_NONE;
-		ECS::entity e;
+		ECS::handle e;
 	};
 
 	/**
@@ -65,7 +65,7 @@ namespace Tile {
 	 */
 	struct TMC_ActorMovePos {
 		MapCommandType type = MAP_CMD_ACTOR_MOVE_POS;
-		ECS::entity e;
+		ECS::handle e;
 		Position2 targetPos;
 		Velocity2 targetVel = Velocity2{ 0, 0 };
 	};
@@ -78,7 +78,7 @@ namespace Tile {
 	 */
 	struct TMC_ActorSetDirection {
 		MapCommandType type = MAP_CMD_ACTOR_SET_DIRECTION;
-		ECS::entity e;
+		ECS::handle e;
 		Direction direction;
 	};
 
@@ -88,7 +88,7 @@ namespace Tile {
 	 */
 	struct TMC_ActorWait {
 		MapCommandType type = MAP_CMD_ACTOR_WAIT;
-		ECS::entity e;
+		ECS::handle e;
 		double time;
 	};
 
@@ -100,7 +100,7 @@ namespace Tile {
 	 */
 	struct TMC_ActorChangeDialogue {
 		MapCommandType type = MAP_CMD_ACTOR_CHANGE_DIALOGUE;
-		ECS::entity e;
+		ECS::handle e;
 		unsigned dialogueId;
 	};
 
@@ -115,7 +115,7 @@ namespace Tile {
 	 */
 	struct TMC_ActorSpeak {
 		MapCommandType type = MAP_CMD_ACTOR_SPEAK;
-		ECS::entity e;
+		ECS::handle e;
 		unsigned dialogueId;
 		Direction direction = Direction::DirectionNone;
 	};
@@ -126,7 +126,7 @@ namespace Tile {
 	 */
 	struct TMC_ActorWaitForSpeak {
 		MapCommandType type = MAP_CMD_ACTOR_WAIT_FOR_SPEAK;
-		ECS::entity e;
+		ECS::handle e;
 	};
 
 	/**
@@ -137,7 +137,7 @@ namespace Tile {
 	 */
 	struct TMC_PlayerTeleport {
 		MapCommandType type = MAP_CMD_PLAYER_TELEPORT;
-		ECS::entity e;
+		ECS::handle e;
 		Position2 position;
 	};
 	
@@ -149,7 +149,7 @@ namespace Tile {
 	 */
 	struct TMC_SwitchMap {
 		MapCommandType type = MAP_CMD_SWITCH_MAP;
-		ECS::entity e;
+		ECS::handle e;
 		Position2 spawnPosition = Position2{ -1, -1 };
 		Direction spawnDirection = Direction::DirectionNone;
 		unsigned mapScenePathIndex;
@@ -163,20 +163,20 @@ namespace Tile {
 	 */
 	struct TMC_ActivateScript {
 		MapCommandType type = MAP_CMD_ACTIVATE_SCRIPT;
-		ECS::entity e = ECS::NONE;
+		ECS::handle e = ECS::NONE_HANDLE;
 		size_t scriptIndex;
 	};
 
 	struct TMC_MoveCamera {
 		MapCommandType type = MAP_CMD_MOVE_CAMERA;
-		ECS::entity e = ECS::NONE;
+		ECS::handle e = ECS::NONE_HANDLE;
 		Position2 position;
 		float speed = 16.f;
 	};
 
 	struct TMC_MoveCameraToPlayer {
 		MapCommandType type = MAP_CMD_MOVE_CAMERA_TO_PLAYER;
-		ECS::entity e = ECS::NONE;
+		ECS::handle e = ECS::NONE_HANDLE;
 		float speed = 16.f;
 	};
 
@@ -188,7 +188,7 @@ namespace Tile {
 	 */
 	struct TMC_EnablePlayerControls {
 		MapCommandType type = MAP_CMD_ENABLE_PLAYER_CONTROLS;
-		ECS::entity e = ECS::NONE;
+		ECS::handle e = ECS::NONE_HANDLE;
 	};
 
 	/**
@@ -199,7 +199,7 @@ namespace Tile {
 	 */
 	struct TMC_DisablePlayerControls{
 		MapCommandType type = MAP_CMD_DISABLE_PLAYER_CONTROLS;
-		ECS::entity e = ECS::NONE;
+		ECS::handle e = ECS::NONE_HANDLE;
 	};
 
 	/**
@@ -10,10 +10,15 @@
 
 namespace Tile {
 	/**
-	 * @copybrief GRY_ECS
+	 * @brief GRY_ECS with the TileMap components, for any entity type.
 	 * 
+	 * @tparam entity Identifier type of the ECS.
+	 * @tparam MAX_ENTITIES Maximum number of entities of the ECS.
 	 */
-	using MapECS = GRY_ECS<
+	template<typename entity, entity MAX_ENTITIES>
+	using BasicMapECS = GRY_ECS<
+		entity,
+		MAX_ENTITIES,
 		Position2,
 		Velocity2,
 		Hitbox,
@@ -29,4 +34,22 @@ namespace Tile {
 		MapCommand,
 		MapCommandList
 	>;
+
+	/**
+	 * @copybrief GRY_ECS
+	 * 
+	 * @details
+	 * Uses the default entity type, so systems can refer to its
+	 * component sets as `ComponentSet<T>`.
+	 * The capacity is chosen from the map data, see EntityMap::load.
+	 */
+	using MapECS = BasicMapECS<ECS::entity, ECS::MAX_ENTITIES>;
+
+	/**
+	 * @brief Owned group of the components that Tile::MapMovement updates every frame.
+	 * 
+	 * @details
+	 * Actors with a hitbox are kept packed at the front of these sets.
+	 */
+	using MovingActorGroup = ECSGroup<ECS::entity, ECS::MAX_ENTITIES, Position2, Velocity2, Actor, Hitbox>;
 };
\ No newline at end of file
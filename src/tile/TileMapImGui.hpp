@@ -9,6 +9,8 @@
 #include "ComponentsImGui.hpp"
 #include "TileComponentsImGui.hpp"
 #include "TileMapECS.hpp"
+#include "TileMapQuadTrees.hpp"
+#include "TileMapRenderer.hpp"
 
 static const char* TileMapECSComponentStrings[std::tuple_size_v<Tile::MapECS::TupleType>] = {
 	"Position2",
@@ -30,10 +32,40 @@ static const char* TileMapECSComponentStrings[std::tuple_size_v<Tile::MapECS::Tu
 template<>
 void imguiECS(Tile::MapECS& ecs) {
 	ImGui::Begin("TileMapECS");
+	imguiECSMemory(ecs.totalMemoryUsage());
 	imguiRecurseComponents(ecs.components, TileMapECSComponentStrings);
 	ImGui::End();
 }
 
-inline void tileMapImGui(Tile::MapECS& ecs) {
+/**
+ * @brief Display how much of the quadtrees was rebuilt or touched over the last frame.
+ * 
+ * @param stats Stats from Tile::MapQuadTrees::getStats.
+ */
+inline void imguiQuadTrees(const Tile::MapQuadTrees::Stats& stats) {
+	ImGui::Begin("QuadTrees");
+	ImGui::Text("Nodes: %zu", stats.nodes);
+	ImGui::Text("Rebuilt: %zu", stats.rebuilt);
+	ImGui::Text("Touched: %zu (%zu relocated)", stats.touched, stats.relocated);
+	ImGui::End();
+}
+
+/**
+ * @brief Display the draw calls and vertices the map took to draw over the last frame, and how many chunks are cached.
+ * 
+ * @param stats Stats from Tile::MapRenderer::getBatchStats.
+ * @param cachedChunks Number from Tile::MapRenderer::getCachedChunks.
+ */
+inline void imguiMapRenderer(const GRY_RenderBatch::Stats& stats, std::size_t cachedChunks) {
+	ImGui::Begin("MapRenderer");
+	ImGui::Text("Draw calls: %zu", stats.drawCalls);
+	ImGui::Text("Vertices: %zu", stats.vertices);
+	ImGui::Text("Cached chunks: %zu", cachedChunks);
+	ImGui::End();
+}
+
+inline void tileMapImGui(Tile::MapECS& ecs, const Tile::MapQuadTrees& quadTrees, const Tile::MapRenderer& renderer) {
 	imguiECS(ecs);
+	imguiQuadTrees(quadTrees.getStats());
+	imguiMapRenderer(renderer.getBatchStats(), renderer.getCachedChunks());
 }
\ No newline at end of file
@@ -76,7 +76,9 @@ void Tile::MapInput::process() {
 	if (direction) {
 		actors->get(player).direction = static_cast<Direction>(direction);
 	}
+}
 
+void Tile::MapInput::processInteract() {
 	if (scene->readSingleInput() == GCmd::MapInteract) {
 		interact();
 	}
@@ -92,8 +94,12 @@ bool Tile::MapInput::interact() {
 	*(Position2*)&searchBox += direction;
 
 	/* Query for collisions */
+	std::vector<ECS::handle> handles;
+	scene->getBroadphases().at(mapEntities->get(player).layer)->query(searchBox, player, handles);
 	std::vector<ECS::entity> collisions;
-	scene->getQuadTrees().at(mapEntities->get(player).layer).query(searchBox, player, collisions);
+	for (auto handle : handles) {
+		if (scene->getECSReadOnly().isAlive(handle)) { collisions.push_back(handle.index); }
+	}
 	if (collisions.empty()) { return false; }
 
 	/* Find the closest collision */
@@ -55,9 +55,20 @@ namespace Tile {
 		MapInput(MapScene* scene);
 
 		/**
-		 * @brief Scan and process inputs.
+		 * @brief Set the player's movement from the buttons being held.
 		 * 
+		 * @details
+		 * Only reads held buttons, so it can run once per simulation tick.
 		 */
 		void process();
+
+		/**
+		 * @brief Interact with what is in front of the player, if interact was pressed this frame.
+		 * 
+		 * @details
+		 * Should run once per frame rather than per tick, so that
+		 * a single press is neither missed nor repeated.
+		 */
+		void processInteract();
 	};
 };
\ No newline at end of file
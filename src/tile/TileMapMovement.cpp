@@ -6,9 +6,9 @@
 #include "TileMapMovement.hpp"
 #include "../scenes/TileMapScene.hpp"
 #include "QuadTree.hpp"
+#include "SweptAABB.hpp"
 
 static const float INV_SQRT_TWO = 0.7071f;
-static const unsigned MAX_COLLISION_RESOLUTION_ATTEMPTS = 6;
 
 static Velocity2 dirVecs[Tile::Direction::DirectionSize] = {
 	Velocity2{0,0},
@@ -38,79 +38,70 @@ static Tile::Direction vecToDir(Velocity2 vec) {
 	return vecDirs[(int)((vec[0]+1)*3+vec[1]+1)];
 }
 
-void Tile::MapMovement::glide(double delta, Velocity2 prevVelocity, ECS::entity e) {
+void Tile::MapMovement::glide(double delta, Velocity2 prevVelocity, const Actor& actor, Position2& position, Velocity2& velocity) {
 	for (int i = 0; i < 2; i++) {
 		/* Proceed only if the actor was moving in this coordinate last frame but not this one */
-		if (!prevVelocity[i] || velocities->get(e)[i]) { continue; }
+		if (!prevVelocity[i] || velocity[i]) { continue; }
 		/* Calculate this coordinate's remainder after flooring */
-		float rmndr = fabsf(positions->get(e)[i] - floorf(positions->get(e)[i]));
+		float rmndr = fabsf(position[i] - floorf(position[i]));
 		/* If it's zero, it's not mid-pixel, so we don't need to glide */
 		if (!rmndr) { continue; }
 		/* Try an incremental move, and floor it */
-		rmndr = floorf(rmndr + prevVelocity[i] * (actors->get(e).speed * (1 + actors->get(e).sprinting) * delta));
+		rmndr = floorf(rmndr + prevVelocity[i] * (actor.speed * (1 + actor.sprinting) * delta));
 		/* If it did not floor to 0, it escaped the range [0, 1), so it crossed over a pixel */
 		if (rmndr) {
 			/* Snap to the pixel it crossed, using either floor or ceil */
-			positions->get(e)[i] = prevVelocity[i] < 0 ? floorf(positions->get(e)[i]) : ceilf(positions->get(e)[i]);
+			position[i] = prevVelocity[i] < 0 ? floorf(position[i]) : ceilf(position[i]);
 		}
 		else {
 			/* If it did floor to 0, it's still mid-pixel, so glide it */
-			velocities->get(e)[i] = prevVelocity[i];
+			velocity[i] = prevVelocity[i];
 		}		
 	}
 }
 
-static Velocity2 AABBMTV(const Hitbox& lhs, const Hitbox& rhs) {
-	Velocity2 returnVec{ 0, 0 };
-
-	float left = rhs.x - (lhs.x + lhs.w);
-	float right = (rhs.x + rhs.w) - lhs.x;
-	float bottom = rhs.y - (lhs.y + lhs.h);
-	float top = (rhs.y + rhs.h) - lhs.y;
-
-	returnVec.x = fabsf(left) > right ? right : left;
-	returnVec.y = fabsf(bottom) > top ? top : bottom;
-
-	if (fabsf(returnVec.x) >= fabsf(returnVec.y)) { returnVec.x = 0; }
-	else { returnVec.y = 0; }
-
-	return returnVec;
-}
-
-Hitbox Tile::MapMovement::handleEntityCollisions(Hitbox box, ECS::entity e, int layer, unsigned attempts) {
-	std::vector<Hitbox> eCollisions;
-	scene->getQuadTrees().at(layer).query(box, e, eCollisions);
-	if (eCollisions.empty()) { return box; }
-	Velocity2 resolutionVector = AABBMTV(box, eCollisions.back());
-	*((Position2*)&box) += resolutionVector;
-	if (resolutionVector.x < 0) { box.x = floorf(box.x); }
-	if (resolutionVector.x > 0) { box.x = ceilf(box.x); }
-	if (resolutionVector.y < 0) { box.y = floorf(box.y); }
-	if (resolutionVector.y > 0) { box.y = ceilf(box.y); }
-
-	if (attempts >= MAX_COLLISION_RESOLUTION_ATTEMPTS) { return box; }
-	return handleEntityCollisions(box, e, layer, attempts + 1);
+/**
+ * @details
+ * Everything the box could hit on its way is found with one query of the
+ * entities and one of the tiles, over the box's swept bounds. The box is
+ * then swept against all of it at once.
+ * 
+ * If the box starts inside something, it is pushed out first. That moves
+ * its swept bounds, so the obstacles are found again from where it ended
+ * up. Boxes rarely start inside something, so this seldom costs a second
+ * query.
+ */
+Hitbox Tile::MapMovement::handleCollisions(Hitbox box, Velocity2 motion, ECS::entity e, int layer) {
+	findObstacles(sweptBounds(box, motion), e, layer);
+	Hitbox pushed = depenetrate(box, obstacles);
+	if (pushed.x != box.x || pushed.y != box.y) {
+		box = pushed;
+		findObstacles(sweptBounds(box, motion), e, layer);
+	}
+	return sweepAndSlide(box, motion, obstacles);
 }
 
-Hitbox Tile::MapMovement::handleTileCollisions(Hitbox box, int layer) {
-	SDL_FRect* rect = reinterpret_cast<SDL_FRect*>(&box);
-	std::vector<SDL_FRect> collisions = scene->queryTileCollisions(*rect, layer);
-	if (collisions.empty()) { return box; }
-	SDL_FRect f = collisions.back();
-	*((Position2*)&box) += AABBMTV(box, *(Hitbox*)&f);
-	return handleTileCollisions(box, layer);
+void Tile::MapMovement::findObstacles(Hitbox bounds, ECS::entity e, int layer) {
+	obstacles.clear();
+	scene->getBroadphases().at(layer)->query(bounds, e, obstacles);
+	scene->queryTileCollisions(bounds, layer, obstacles);
 }
 
 void Tile::MapMovement::handleSoftEntityCollisions(Hitbox box, ECS::entity e, int layer) {
-	std::vector<entity> eCollisions;
-	scene->getSoftQuadTrees().at(layer).query(box, e, eCollisions);
-	for (auto e : eCollisions) {
+	softCollisions.clear();
+	scene->getSoftBroadphases().at(layer)->query(box, e, softCollisions);
+	for (auto handle : softCollisions) {
+		/* Skip entities whose leaf is left over from before they were freed */
+		if (!scene->getECSReadOnly().isAlive(handle)) { continue; }
+		ECS::entity e = handle.index;
 		if (collisionInteractions->contains(e)) {
 			MapCollisionInteraction& interaction = collisionInteractions->get(e);
 			interaction.beingPressed = true;
 			if (!interaction.active) { scene->executeCommand(interaction.command); }
 			if (interaction.mode == MapCollisionInteraction::Mode::Fleeting) {
-				scene->getECS().freeEntity(e);
+				/* Freed at the end of the frame, so it must not trigger again before then */
+				interaction.active = true;
+				scene->getECS().getCommands().free(handle);
 			}
 			else if (interaction.mode == MapCollisionInteraction::Mode::PressurePlate) {
 				interaction.active = true;
@@ -128,7 +119,30 @@ Tile::MapMovement::MapMovement(MapScene *scene) :
 	actors(&scene->getECS().getComponent<Actor>()),
 	sprites(&scene->getECS().getComponent<ActorSprite>()),
 	players(&scene->getECSReadOnly().getComponentReadOnly<Player>()),
-	collisionInteractions(&scene->getECS().getComponent<MapCollisionInteraction>()) {
+	collisionInteractions(&scene->getECS().getComponent<MapCollisionInteraction>()),
+	movingActors(scene->getECS().group<Position2, Velocity2, Actor, Hitbox>()) {
+}
+
+void Tile::MapMovement::moveWithHitbox(double delta, ECS::entity e, const Actor& actor, Position2& position, Velocity2& velocity, Hitbox& hitbox) {
+	unsigned layer = mapEntities->get(e).layer;
+	Hitbox box = hitbox;
+	Position2* pos = reinterpret_cast<Position2*>(&box);
+	*pos = position;
+
+	box = handleCollisions(box, velocity * actor.speed * (1 + actor.sprinting) * delta, e, layer);
+
+	position = *pos;
+	hitbox = box;
+
+	handleSoftEntityCollisions(box, e, layer);
+
+	/**
+	 * We update the quadtree here to prevent jittering that
+	 * would occur if only previous frame collision data was used.
+	 * The box is relocated within the tree if needed, so
+	 * big/teleport movements stay accurate too.
+	 */
+	scene->updateQuadTree(box, e, layer);
 }
 
 /**
@@ -139,45 +153,42 @@ Tile::MapMovement::MapMovement(MapScene *scene) :
  * to a pixel before it stops moving in that direction.
  */
 void Tile::MapMovement::process(double delta) {
-	for (auto e : *actors) {
-		/* Save the previous velocity for when we check for gliding */
-		Velocity2 prevVelocity = velocities->get(e);
-		
-		/* Update the velocity based on direction. If it's not moving, use the 0 vector */
-		velocities->get(e) = dirVecs[actors->get(e).movingDirection ? actors->get(e).direction : 0];
-		
-		/* Try gliding */
-		glide(delta, prevVelocity, e);
+	/* Actors with a hitbox are packed at the front of the actor set, in the same order as their other components */
+	movingActors.refresh();
+	const std::size_t grouped = movingActors.size();
+	for (std::size_t i = 0; i < grouped; i++) {
+		const Actor& actor = movingActors.get<Actor>(i);
+		Velocity2& velocity = movingActors.get<Velocity2>(i);
 
-		unsigned layer = mapEntities->get(e).layer;
-		if (hitboxes->contains(e)) {
-			Hitbox box = hitboxes->get(e);
-			Hitbox oldBox = box;
-			Position2* pos = reinterpret_cast<Position2*>(&box);
-			*pos = positions->get(e);
-			*pos += velocities->get(e) * actors->get(e).speed * (1 + actors->get(e).sprinting) * delta;
-
-			box = handleEntityCollisions(box, e, layer);
-			box = handleTileCollisions(box, layer);
-
-			positions->get(e) = *pos;
-			hitboxes->get(e) = box;
+		/* Save the previous velocity for when we check for gliding */
+		Velocity2 prevVelocity = velocity;
+		Position2 prevPosition = movingActors.get<Position2>(i);
 
-			handleSoftEntityCollisions(box, e, layer);
+		/* Update the velocity based on direction. If it's not moving, use the 0 vector */
+		velocity = dirVecs[actor.movingDirection ? actor.direction : 0];
 
-			/**
-			 * We update the quadtree here to prevent jittering that
-			 * would occur if only previous frame collision data was used.
-			 * However, this may produce collision inaccuracies that
-			 * last for one frame, especially for big/teleport movements.
-			 */
-			scene->updateQuadTree(oldBox, box, e, layer);
+		/* Try gliding */
+		glide(delta, prevVelocity, actor, movingActors.get<Position2>(i), velocity);
 
-			EntityMap::sortLayer(&scene->getTileEntityMap(), layer);
+		ECS::entity e = movingActors.getEntity(i);
+		moveWithHitbox(delta, e, actor, movingActors.get<Position2>(i), velocity, movingActors.get<Hitbox>(i));
+		if (!(movingActors.get<Position2>(i) == prevPosition)) {
+			EntityMap::markMoved(&scene->getTileEntityMap(), e, mapEntities->get(e).layer);
 		}
-		else {
-			positions->get(e) += velocities->get(e) * actors->get(e).speed * (1 + actors->get(e).sprinting) * delta;
-			EntityMap::sortLayer(&scene->getTileEntityMap(), layer);
+	}
+	/* The rest of the actors do not have a hitbox */
+	for (std::size_t i = grouped; i < actors->size(); i++) {
+		ECS::entity e = actors->getEntity(i);
+		const Actor& actor = actors->get(e);
+		Velocity2& velocity = velocities->get(e);
+		Velocity2 prevVelocity = velocity;
+		Position2 prevPosition = positions->get(e);
+		velocity = dirVecs[actor.movingDirection ? actor.direction : 0];
+		glide(delta, prevVelocity, actor, positions->get(e), velocity);
+
+		positions->get(e) += velocity * actor.speed * (1 + actor.sprinting) * delta;
+		if (!(positions->get(e) == prevPosition)) {
+			EntityMap::markMoved(&scene->getTileEntityMap(), e, mapEntities->get(e).layer);
 		}
 	}
 	for (auto& interaction : collisionInteractions->value) {
@@ -64,34 +64,74 @@ namespace Tile {
 
 		ComponentSet<MapCollisionInteraction>* collisionInteractions;
 
+		/**
+		 * @brief Actors with a hitbox, packed together.
+		 * 
+		 */
+		MovingActorGroup movingActors;
+
+		/**
+		 * @brief Move an actor that has a hitbox, resolving its collisions.
+		 * 
+		 * @param delta Delta time for game processing, in seconds.
+		 * @param e The entity to move.
+		 * @param actor Actor data of the entity.
+		 * @param position Position of the entity.
+		 * @param velocity Velocity of the entity.
+		 * @param hitbox Hitbox of the entity.
+		 */
+		void moveWithHitbox(double delta, ECS::entity e, const Actor& actor, Position2& position, Velocity2& velocity, Hitbox& hitbox);
+
 		/**
 		 * @brief Attempt to glide an entity so that it aligns to the nearest pixel.
 		 * 
 		 * @param delta Delta time for game processing, in seconds.
 		 * @param prevVelocity The movement vector of the entity from the previous frame.
-		 * @param e The entity to attempt the glide for.
+		 * @param actor Actor data of the entity.
+		 * @param position Position of the entity.
+		 * @param velocity Velocity of the entity.
 		 */
-		void glide(double delta, Velocity2 prevVelocity, ECS::entity e);
+		void glide(double delta, Velocity2 prevVelocity, const Actor& actor, Position2& position, Velocity2& velocity);
 
 		/**
-		 * @brief Recursively resolve collisions for an entity against other entities.
+		 * @brief Hitboxes of the entities and tiles that the actor being moved could hit.
 		 * 
-		 * @param box The new hitbox of the entity
-		 * @param e The id of the entity to check
+		 * @details
+		 * Kept between frames, like the other scratch buffer below,
+		 * so that moving an actor does not allocate once it is big enough.
+		 */
+		std::vector<Hitbox> obstacles;
+
+		/**
+		 * @brief Handles of the soft entities colliding with the actor being moved.
+		 * 
+		 */
+		std::vector<ECS::handle> softCollisions;
+
+		/**
+		 * @brief Fill `obstacles` with the hitboxes of the entities and tiles that collide with `bounds`.
+		 * 
+		 * @param bounds Area to look in
+		 * @param e The id of the entity being moved, which is left out
 		 * @param layer Layer that the entity is on
-		 * @param attempts Number of attempts at recursively resolving the collison
-		 * @return The resulting hitbox that has no conflicting collisions
 		 */
-		Hitbox handleEntityCollisions(Hitbox box, ECS::entity e, int layer, unsigned attempts = 0);
+		void findObstacles(Hitbox bounds, ECS::entity e, int layer);
 
 		/**
-		 * @brief Recursively resolve collisions for an entity against tiles.
+		 * @brief Move an entity's hitbox, stopping it against the entities and tiles in its way.
+		 * 
+		 * @details
+		 * The hitbox is swept over the whole motion, so it cannot pass through
+		 * anything however far it moves in one frame. A hitbox that starts
+		 * inside something is pushed out of it first. See sweepAndSlide.
 		 * 
-		 * @param box The new hitbox of the entity
+		 * @param box The hitbox of the entity, before it moves
+		 * @param motion How far the entity moves this frame
+		 * @param e The id of the entity to move
 		 * @param layer Layer that the entity is on
-		 * @return The resulting Hitbox that has no conflicting collisions
+		 * @return The moved hitbox
 		 */
-		Hitbox handleTileCollisions(Hitbox box, int layer);
+		Hitbox handleCollisions(Hitbox box, Velocity2 motion, ECS::entity e, int layer);
 
 		void handleSoftEntityCollisions(Hitbox box, ECS::entity e, int layer);
 	public:
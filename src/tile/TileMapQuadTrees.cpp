@@ -5,27 +5,59 @@
  */
 #include "TileMapQuadTrees.hpp"
 #include "../scenes/TileMapScene.hpp"
+#include <algorithm>
 
 Tile::MapQuadTrees::MapQuadTrees(MapScene *scene) :
 	scene(scene),
 	hitboxes(&scene->getECSReadOnly().getComponentReadOnly<Hitbox>()),
-	collides(&scene->getECSReadOnly().getComponentReadOnly<Collides>()) {
+	collides(&scene->getECSReadOnly().getComponentReadOnly<Collides>()),
+	mapEntities(&scene->getECSReadOnly().getComponentReadOnly<MapEntity>()) {
 }
 
 void Tile::MapQuadTrees::process() {
+	std::size_t currentVersions[3] = { hitboxes->getVersion(), collides->getVersion(), mapEntities->getVersion() };
+	if (dirty || !std::equal(currentVersions, currentVersions + 3, versions)) {
+		std::copy(currentVersions, currentVersions + 3, versions);
+		dirty = false;
+		rebuild();
+	}
+
+	current.nodes = 0;
+	for (int layer = 0; layer < broadphases.size(); layer++) {
+		/* Relocated hitboxes leave the tree uncompacted, which makes the next frame's queries slower */
+		for (Broadphase* tree : { broadphases.at(layer).get(), softBroadphases.at(layer).get() }) {
+			if (!tree->isCompacted()) { tree->compact(); }
+			current.nodes += tree->nodeCount();
+		}
+	}
+	last = current;
+	current = Stats{};
+}
+
+void Tile::MapQuadTrees::updateQuadTree(Hitbox box, ECS::entity e, unsigned layer) {
+	Broadphase& tree = collides->contains(e) ? *broadphases.at(layer) : *softBroadphases.at(layer);
+	if (!tree.contains(e)) { return; }
+	current.touched++;
+	if (tree.update(box, e)) { current.relocated++; }
+}
+
+void Tile::MapQuadTrees::rebuild() {
 	for (int layer = 0; layer < scene->getTileEntityMap().entityLayers.size(); layer++) {
-		quadtrees.at(layer).reset();
-		softQuadtrees.at(layer).reset();
+		broadphases.at(layer)->reset();
+		softBroadphases.at(layer)->reset();
 		for (auto e : scene->getTileEntityMap().entityLayers.at(layer)) {
 			if (hitboxes->contains(e)) {
 				if (collides->contains(e)) {
-					quadtrees.at(layer).insert(hitboxes->get(e), e);
+					broadphases.at(layer)->insert(hitboxes->get(e), scene->getECSReadOnly().getHandle(e));
 				}
 				else {
-					softQuadtrees.at(layer).insert(hitboxes->get(e), e);
+					softBroadphases.at(layer)->insert(hitboxes->get(e), scene->getECSReadOnly().getHandle(e));
 				}
+				current.rebuilt++;
 			}
 		}
+		broadphases.at(layer)->compact();
+		softBroadphases.at(layer)->compact();
 	}
 }
 
@@ -34,8 +66,17 @@ void Tile::MapQuadTrees::init() {
 		(float)(scene->getTileMap().width * scene->getNormalTileSize()),
 		(float)(scene->getTileMap().height * scene->getNormalTileSize())
 	};
+	/* Cells of two tiles fit most actors in one to four cells */
+	float cellSize = 2.0f * scene->getNormalTileSize();
 	for (int layer = 0; layer < scene->getTileEntityMap().entityLayers.size(); layer++) {
-		quadtrees.push_back(QuadTree(mapSize));
-		softQuadtrees.push_back(QuadTree(mapSize));
+		if (scene->getBroadphaseType() == Broadphase::SpatialGridType) {
+			broadphases.push_back(std::make_unique<SpatialGrid>(mapSize, cellSize));
+			softBroadphases.push_back(std::make_unique<SpatialGrid>(mapSize, cellSize));
+		}
+		else {
+			broadphases.push_back(std::make_unique<QuadTree>(mapSize));
+			softBroadphases.push_back(std::make_unique<QuadTree>(mapSize));
+		}
 	}
+	dirty = true;
 }
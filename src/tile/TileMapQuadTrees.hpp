@@ -5,7 +5,9 @@
  * @copyright Copyright (c) 2025
  */
 #pragma once
+#include <memory>
 #include "QuadTree.hpp"
+#include "SpatialGrid.hpp"
 #include "Components.hpp"
 #include "TileComponents.hpp"
 #include "ECS.hpp"
@@ -13,16 +15,88 @@
 namespace Tile {
 	class MapScene;
 
+	/**
+	 * @brief Keeps a Broadphase of the hitboxes on each entity layer, one for colliding and one for soft hitboxes.
+	 * 
+	 * @details
+	 * The kind of Broadphase is chosen by the scene, see MapScene::getBroadphaseType.
+	 * The structures are only rebuilt when hitboxes are added or removed.
+	 * Moving hitboxes are kept up to date through updateQuadTree, so
+	 * entities that stand still are never touched.
+	 */
 	class MapQuadTrees {
+	public:
+		/**
+		 * @brief Work done on the trees over one frame.
+		 * 
+		 */
+		struct Stats {
+			/**
+			 * @brief Number of hitboxes inserted by rebuilding the trees.
+			 * 
+			 */
+			std::size_t rebuilt = 0;
+
+			/**
+			 * @brief Number of hitboxes updated through updateQuadTree.
+			 * 
+			 */
+			std::size_t touched = 0;
+
+			/**
+			 * @brief Number of the touched hitboxes that had to be relocated to another node.
+			 * 
+			 */
+			std::size_t relocated = 0;
+
+			/**
+			 * @brief Number of nodes in use across all of the trees, at the end of the frame.
+			 * 
+			 */
+			std::size_t nodes = 0;
+		};
+
 	private:
-		std::vector<QuadTree> quadtrees;
-		std::vector<QuadTree> softQuadtrees;
+		std::vector<std::unique_ptr<Broadphase>> broadphases;
+		std::vector<std::unique_ptr<Broadphase>> softBroadphases;
 		MapScene* scene;
 		const ComponentSet<Hitbox>* hitboxes;
 		const ComponentSet<Collides>* collides;
+		const ComponentSet<MapEntity>* mapEntities;
+
+		/**
+		 * @brief Versions of the Hitbox, Collides, and MapEntity sets when the trees were last rebuilt.
+		 * 
+		 * @sa SparseSet::getVersion
+		 */
+		std::size_t versions[3] = { 0, 0, 0 };
+
+		/**
+		 * @brief Whether the trees must be rebuilt at the next `process`, regardless of the versions.
+		 * 
+		 */
+		bool dirty = true;
+
+		/**
+		 * @brief Stats of the frame in progress.
+		 * 
+		 */
+		Stats current;
+
+		/**
+		 * @brief Stats of the last finished frame.
+		 * 
+		 */
+		Stats last;
+
+		void rebuild();
 	public:
 		MapQuadTrees(MapScene* scene);
 
+		/**
+		 * @brief Rebuild the trees if hitboxes were added or removed since the last call.
+		 * 
+		 */
 		void process();
 
 		/**
@@ -31,12 +105,34 @@ namespace Tile {
 		 */
 		void init();
 
-		const std::vector<QuadTree>& getQuadTrees() { return quadtrees; }
+		/**
+		 * @brief Get the Broadphase of the colliding hitboxes, for each layer.
+		 * 
+		 * @return `const` reference to the vector of Broadphases.
+		 */
+		const std::vector<std::unique_ptr<Broadphase>>& getBroadphases() { return broadphases; }
+
+		/**
+		 * @brief Get the Broadphase of the soft hitboxes, for each layer.
+		 * 
+		 * @return `const` reference to the vector of Broadphases.
+		 */
+		const std::vector<std::unique_ptr<Broadphase>>& getSoftBroadphases() { return softBroadphases; }
 
-		const std::vector<QuadTree>& getSoftQuadTrees() { return softQuadtrees; }
+		/**
+		 * @brief Get the work done on the trees over the last frame.
+		 * 
+		 * @return `const` reference to the stats.
+		 */
+		const Stats& getStats() const { return last; }
 
-		void updateQuadTree(Hitbox oldBox, Hitbox newBox, ECS::entity e, unsigned layer) {
-			quadtrees.at(layer).update(oldBox, newBox, e);
-		}
+		/**
+		 * @brief Move the hitbox of an entity within the quadtree of its layer.
+		 * 
+		 * @param box The entity's new hitbox.
+		 * @param e The entity.
+		 * @param layer The entity's layer.
+		 */
+		void updateQuadTree(Hitbox box, ECS::entity e, unsigned layer);
 	};
 };
\ No newline at end of file
@@ -6,52 +6,62 @@
 #include "TileMapRenderer.hpp"
 #include "../scenes/TileMapScene.hpp"
 #include "GRY_PixelGame.hpp"
-#include "SDL_RectOps.hpp"
 #include "SDL3/SDL_render.h"
 
 Tile::MapRenderer::MapRenderer(const MapScene *scene) :
 	scene(scene),
-	renderer(scene->getGame()->getVideo().getRenderer()),
+	batch(scene->getGame()->getVideo().getRenderer()),
+	chunks(scene->getGame()->getVideo().getRenderer(), &scene->getTileMap()),
 	tileMap(&scene->getTileMap()),
 	entityMap(&scene->getTileEntityMap()),
-	pixelScaling(&scene->getPixelGame()->getPixelScalingRef()),
 	positions(&scene->getECSReadOnly().getComponentReadOnly<Position2>()),
 	sprites(&scene->getECSReadOnly().getComponentReadOnly<ActorSprite>()),
 	hitboxes(&scene->getECSReadOnly().getComponentReadOnly<Hitbox>()) {
 }
 
-void Tile::MapRenderer::renderTile(const Tileset &tileset, const TileId textureIndex, const SDL_FRect *dstRect) {
-	SDL_RenderTexture(renderer, tileset.texture, tileset.getSourceRect(textureIndex), dstRect);
-}
-
 void Tile::MapRenderer::renderSprite(ECS::entity e) {
 	const Tileset& tileset = entityMap->tilesets[sprites->get(e).tileset];
+	Position2 position = getRenderPosition(e);
+	/* Snap to whole game pixels, so sprites do not shimmer against the tiles */
 	SDL_FRect dstRect {
-		floorf((positions->get(e)[0] + sprites->get(e).offsetX + offsetX) * *pixelScaling),
-		floorf((positions->get(e)[1] + sprites->get(e).offsetY + offsetY) * *pixelScaling),
-		tileset.tileWidth * *pixelScaling,
-		tileset.tileHeight * *pixelScaling
+		floorf(position[0] + sprites->get(e).offsetX + offsetX),
+		floorf(position[1] + sprites->get(e).offsetY + offsetY),
+		tileset.tileWidth,
+		tileset.tileHeight
 	};
-	SDL_RenderTexture(renderer, tileset.texture, tileset.getSourceRect(sprites->get(e).index), &dstRect);
+	batch.add(tileset.texture, *tileset.getSourceRect(sprites->get(e).index), dstRect);
+}
 
-	#ifndef NDEBUG
-	if (!scene->getMapCamera().cameraIsLocked() || scene->getECSReadOnly().getComponentReadOnly<Player>().getEntity(0) != e) { return; }
-	SDL_FRect referenceRect {
-		floorf(sprites->get(e).offsetX + (scene->getPixelGame()->getScreenWidthPixels() * 0.5f) - (hitboxes->get(e).w * 0.5f)) * *pixelScaling,
-		floorf(sprites->get(e).offsetY + (scene->getPixelGame()->getScreenHeightPixels() * 0.5f) - (hitboxes->get(e).h * 0.5f)) * *pixelScaling,
-		0, 0
-	};
-	if (dstRect.x != referenceRect.x || dstRect.y != referenceRect.y) {
-		GRY_Log("Floating point error when rendering player!\n");
-	}
-	#endif
+Position2 Tile::MapRenderer::getRenderPosition(ECS::entity e) const {
+	std::size_t i = positions->indexOf(e);
+	if (i >= previousEntities.size() || previousEntities[i] != e) { return positions->get(e); }
+	const Position2& previous = previousPositions[i];
+	return previous + (positions->get(e) - previous) * interpolation;
+}
+
+/**
+ * @details
+ * Entities keep their place in the dense arrays unless one is added or
+ * removed, so copying them is enough to find the previous positions later.
+ */
+void Tile::MapRenderer::savePositions() {
+	previousEntities.assign(positions->dense.begin(), positions->dense.end());
+	previousPositions.assign(positions->value.begin(), positions->value.end());
 }
 
 /**
  * @details
  * For efficiency, this renderer assumes the map uses only one tileset.
+ * 
+ * Tiles and sprites are drawn row by row, so each row's sprites still cover
+ * the rows above them and are covered by the rows below. The rows between
+ * two rows with sprites are drawn together from the cached chunks, so a
+ * layer without sprites in view is only a few chunk quads and its animated
+ * tiles.
  */
 void Tile::MapRenderer::process() {
+	interpolation = scene->getGame()->getInterpolation();
+
 	GRY_VecTD<uint32_t, 2, void> tileViewport{
 		scene->getPixelGame()->getScreenWidthPixels() / scene->getNormalTileSize() + 1,
 		scene->getPixelGame()->getScreenHeightPixels() / scene->getNormalTileSize() + 2
@@ -59,7 +69,7 @@ void Tile::MapRenderer::process() {
 	/* Tileset that will be used */
 	const Tileset& tileset = tileMap->tileset;
 	/* Distance to shift x or y when moving columns/rows in the rendering loop */
-	const float shift = scene->getNormalTileSize() * *pixelScaling;
+	const float shift = scene->getNormalTileSize();
 
 	GRY_Assert(tileMap->tileLayers.size() == entityMap->entityLayers.size(), 
 		"[TileMapRenderer] Tile map and Entity map need to have the same number of layers.\n"
@@ -69,16 +79,15 @@ void Tile::MapRenderer::process() {
 	uint32_t startY = std::max(0.f, -offsetY / (float)scene->getNormalTileSize());
 	uint32_t endX = std::min(tileMap->width, (uint32_t)(-offsetX / (float)scene->getNormalTileSize()) + tileViewport.x);
 	uint32_t endY = (uint32_t)(-offsetY / (float)scene->getNormalTileSize()) + tileViewport.y;
-	/* Destination rectangle, defines position and size of rendered tile */
-	SDL_FRect dstRect {
-		floorf((offsetX + (startX * scene->getNormalTileSize())) * *pixelScaling),
-		floorf((offsetY + (startY * scene->getNormalTileSize())) * *pixelScaling),
-		tileset.tileWidth * *pixelScaling, tileset.tileHeight * *pixelScaling
-	};
+	/* Screen position of the first tile in view */
+	const float originX = floorf(offsetX + (startX * scene->getNormalTileSize()));
+	const float originY = floorf(offsetY + (startY * scene->getNormalTileSize()));
+
+	/* Draw any chunks that changed, before anything is batched */
+	chunks.prepare(startX, startY, endX, endY, scene->getGame()->getRenderTargetResets());
+
 	for (int i = 0; i < tileMap->tileLayers.size(); i++) {
-		const TileLayer& layer = tileMap->tileLayers[i];
 		const EntityLayer& entityLayer = entityMap->entityLayers[i];
-		uint32_t numRows = (uint32_t)layer.size() / tileMap->width;
 
 		unsigned entityIndex = 0;
 		uint32_t entityRow = 0;
@@ -92,16 +101,17 @@ void Tile::MapRenderer::process() {
 
 		endY = std::min((uint32_t)tileMap->tileLayers[i].size() / tileMap->width,
 						(uint32_t)(-offsetY / (float)scene->getNormalTileSize()) + tileViewport.y);
+		/* First row of tiles not drawn yet */
+		uint32_t rowBegin = startY;
 		/* Render by row */
 		for (uint32_t y = startY; y < endY; y++) {
-			/* Render row of tiles */
-			for (uint32_t x = startX; x < endX; x++) {
-				Tile tile = layer[y * tileMap->width + x];
-				/* Render when id is nonzero (if it's 0 it has no texture) */
-				if (tile.id) { renderTile(tileset, tile.id, &dstRect); }
-				/* Increment dstRect x */
-				dstRect.x += shift;
-			}
+			if (entityRow != y || entityIndex >= entityLayer.size()) { continue; }
+
+			/* Render the rows of tiles up to and including this one */
+			chunks.drawRows(batch, i, startX, endX, rowBegin, y + 1,
+				originX, originY + (rowBegin - startY) * shift, shift
+			);
+			rowBegin = y + 1;
 
 			/* Render any entities in the row */
 			while (entityRow == y && entityIndex < entityLayer.size()) {
@@ -116,12 +126,13 @@ void Tile::MapRenderer::process() {
 					entityRow = (uint32_t)((box.y + box.h) / tileset.tileHeight);
 				}
 			}
-
-			/* Reset dstRect x and increment dstRect y */
-			dstRect.x = floorf((offsetX + (startX * scene->getNormalTileSize())) * *pixelScaling);
-			dstRect.y += shift;
 		}
-		/* Reset dstRect y */
-		dstRect.y = floorf((offsetY + (startY * scene->getNormalTileSize())) * *pixelScaling);
+		/* Render the rows after the last row with entities */
+		chunks.drawRows(batch, i, startX, endX, rowBegin, endY,
+			originX, originY + (rowBegin - startY) * shift, shift
+		);
 	}
+
+	/* The rest of the scene draws on top of the map */
+	batch.endFrame();
 }
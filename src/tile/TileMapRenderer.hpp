@@ -7,6 +7,8 @@
 #pragma once
 #include "TileTileMap.hpp"
 #include "TileEntityMap.hpp"
+#include "GRY_RenderBatch.hpp"
+#include "TileMapChunks.hpp"
 
 struct SDL_Renderer;
 
@@ -18,6 +20,9 @@ namespace Tile {
 	 * 
 	 * @details
 	 * For efficiency, this renderer assumes the map uses only one tileset.
+	 * Static tiles are drawn from the textures of a MapChunks cache, and
+	 * everything goes through a GRY_RenderBatch, so the tiles between two
+	 * rows of sprites are one quad per chunk.
 	 */
 	class MapRenderer {
 	private:
@@ -28,28 +33,28 @@ namespace Tile {
 		const MapScene* scene;
 
 		/**
-		 * @brief Pointer to the renderer.
+		 * @brief Batches the tiles and sprites into as few draw calls as the drawing order allows.
 		 * 
 		 */
-		SDL_Renderer* renderer;
+		GRY_RenderBatch batch;
 
 		/**
-		 * @brief Pointer to the Map.
+		 * @brief Static tiles of the map, cached in textures.
 		 * 
 		 */
-		const TileMap* tileMap;
+		MapChunks chunks;
 
 		/**
-		 * @brief Pointer to the EntityMap.
+		 * @brief Pointer to the Map.
 		 * 
 		 */
-		const EntityMap* entityMap;
+		const TileMap* tileMap;
 
 		/**
-		 * @brief Scaling factor for textures.
+		 * @brief Pointer to the EntityMap.
 		 * 
 		 */
-		const float* pixelScaling;
+		const EntityMap* entityMap;
 
 		/**
 		 * @brief Positions of entities, in game pixels.
@@ -69,6 +74,21 @@ namespace Tile {
 		 */
 		const ComponentSet<Hitbox>* hitboxes;
 
+		/**
+		 * @brief Entities of `positions` when the current simulation tick started, in the same order.
+		 * 
+		 */
+		std::vector<ECS::entity> previousEntities;
+		/**
+		 * @brief Positions of `previousEntities` when the current simulation tick started.
+		 * 
+		 */
+		std::vector<Position2> previousPositions;
+		/**
+		 * @brief How far between the previous and current positions entities are drawn, from 0 to 1.
+		 * 
+		 */
+		float interpolation = 1.f;
 		/**
 		 * @brief X component of rendering offset.
 		 * 
@@ -81,21 +101,22 @@ namespace Tile {
 		 */
 		float offsetY = 0.f;
 
-		/**
-		 * @brief Render a tile on the screen.
-		 * 
-		 * @param tileset Tileset to use.
-		 * @param textureIndex Index of which tile in the Tileset to use.
-		 * @param dstRect Rendering position and size information.
-		 */
-		void renderTile(const Tileset& tileset, const TileId textureIndex, const SDL_FRect* dstRect);
-
 		/**
 		 * @brief Render an entity's sprite on the screen.
 		 * 
 		 * @param e Id of the entity to render
 		 */
 		void renderSprite(ECS::entity e);
+		/**
+		 * @brief Get where to draw an entity, between its previous and current position.
+		 * 
+		 * @details
+		 * Entities that did not exist when the tick started are drawn at their current position.
+		 * 
+		 * @param e Id of the entity.
+		 * @return The interpolated position.
+		 */
+		Position2 getRenderPosition(ECS::entity e) const;
 	public:
 		/**
 		 * @brief Constructor.
@@ -104,9 +125,17 @@ namespace Tile {
 		 */
 		MapRenderer(const MapScene* scene);
 
+		/**
+		 * @brief Remember the positions of entities. Should be called before each simulation tick.
+		 * 
+		 */
+		void savePositions();
 		/**
 		 * @brief Render the TileMap and EntityMap.
 		 * 
+		 * @details
+		 * Entities are drawn between the positions saved by `savePositions`
+		 * and their current ones, using the game's interpolation.
 		 */
 		void process();
 
@@ -120,5 +149,19 @@ namespace Tile {
 			offsetX = x;
 			offsetY = y;
 		}
+
+		/**
+		 * @brief Get the draw calls and vertices of the last frame.
+		 * 
+		 * @return `const` reference to the stats.
+		 */
+		const GRY_RenderBatch::Stats& getBatchStats() const { return batch.getStats(); }
+
+		/**
+		 * @brief Get the number of map chunks with a cached texture.
+		 * 
+		 * @return The number of cached chunks.
+		 */
+		std::size_t getCachedChunks() const { return chunks.getTextureCount(); }
 	};
 };
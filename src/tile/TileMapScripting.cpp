@@ -53,10 +53,24 @@ void Tile::MapScripting::process(double delta) {
 	}
 }
 
+void Tile::MapScripting::cancelFreed() {
+	/* Which entity owns a command doesn't matter here, so the values are walked in order */
+	for (MapCommand& command : ecs->getComponent<MapCommand>().value) {
+		if (command.data.e != ECS::NONE_HANDLE && !ecs->isAlive(command.data.e)) {
+			command = MapCommand{ .data { MAP_CMD_NONE } };
+		}
+	}
+}
+
+/**
+ * @details
+ * The handles of these commands are not checked here, since cancelFreed
+ * has already cancelled the commands whose entity was freed.
+ */
 void Tile::MapScripting::processEntities(double delta) {
 	for (auto e : ecs->getComponent<MapCommand>()) {
 		MapCommand& command = ecs->getComponent<MapCommand>().get(e);
-		if (executeCommand(command, delta)) {
+		if (dispatchCommand(command, delta)) {
 			command = MapCommand{ .data { MAP_CMD_NONE } };
 		}
 	}
@@ -69,7 +83,11 @@ void Tile::MapScripting::processGameplay(double delta) {
 		"[Tile::MapScripting] An entity had a MapCommandList component, but no MapCommand component.\n");
 
 		if (ecs->getComponent<MapCommand>().get(e).data.type == MAP_CMD_NONE) {
-			ecs->getComponent<MapCommand>().get(e) = commandList.commands[commandList.index];
+			const MapCommand& next = commandList.commands[commandList.index];
+			/* Skip commands whose entity was freed, the same way executeCommand would */
+			if (next.data.e == ECS::NONE_HANDLE || ecs->isAlive(next.data.e)) {
+				ecs->getComponent<MapCommand>().get(e) = next;
+			}
 			if (++commandList.index >= commandList.commands.size()) {
 				commandList.index = 0;
 			}
@@ -96,7 +114,21 @@ void Tile::MapScripting::processCutscene(double delta) {
 	}
 }
 
+/**
+ * @details
+ * A command whose entity has been freed since the command was made
+ * is treated as complete, so it never touches the entity that reused the id.
+ */
 bool Tile::MapScripting::executeCommand(MapCommand& command, double delta) {
+	if (command.data.type != MAP_CMD_NONE &&
+		command.data.e != ECS::NONE_HANDLE &&
+		!ecs->isAlive(command.data.e)) {
+		return true;
+	}
+	return dispatchCommand(command, delta);
+}
+
+bool Tile::MapScripting::dispatchCommand(MapCommand& command, double delta) {
 	switch (command.data.type) {
 		case MAP_CMD_NONE:
 			return false;
@@ -138,9 +170,8 @@ bool Tile::MapScripting::processActorMovePos(TMC_ActorMovePos& args) {
 	/* If being spoken to, don't move */
 	if (args.e == ecs->getComponent<Player>().value[0].speakingTo) { return false; }
 
-	Position2& pos = ecs->getComponent<Position2>().get(args.e);
-	Hitbox oldBox = ecs->getComponent<Hitbox>().get(args.e);
-	Hitbox& box = ecs->getComponent<Hitbox>().get(args.e);
+	Position2& pos = ecs->getComponent<Position2>().get(args.e.index);
+	Hitbox& box = ecs->getComponent<Hitbox>().get(args.e.index);
 	/* If the target position has been reached, return true */
 	if (pos == args.targetPos) { return true; }
 	/* If the target velocity is at the default/zero value, calculate and set it */
@@ -166,19 +197,21 @@ bool Tile::MapScripting::processActorMovePos(TMC_ActorMovePos& args) {
 	}
 	box.x = pos.x;
 	box.y = pos.y;
-	scene->updateQuadTree(oldBox, box, args.e, ecs->getComponent<MapEntity>().get(args.e).layer);
+	unsigned layer = ecs->getComponent<MapEntity>().get(args.e.index).layer;
+	scene->updateQuadTree(box, args.e.index, layer);
+	EntityMap::markMoved(&scene->getTileEntityMap(), args.e.index, layer);
 
 	/* Set direction for the movement system to use */
 	Direction direction = vecToDir(vel);
-	ecs->getComponent<Actor>().get(args.e).movingDirection = direction;
-	if (direction) { ecs->getComponent<Actor>().get(args.e).direction = direction; }
+	ecs->getComponent<Actor>().get(args.e.index).movingDirection = direction;
+	if (direction) { ecs->getComponent<Actor>().get(args.e.index).direction = direction; }
 
 	return !direction;
 }
 
 bool Tile::MapScripting::processActorSetDirection(TMC_ActorSetDirection& args) {
 	if (ecs->getComponent<Player>().value[0].speakingTo == args.e) { return false; }
-	ecs->getComponent<Actor>().get(args.e).direction = args.direction;
+	ecs->getComponent<Actor>().get(args.e.index).direction = args.direction;
 	return true;
 }
 
@@ -187,7 +220,7 @@ bool Tile::MapScripting::processActorWait(TMC_ActorWait& args, double delta) {
 }
 
 bool Tile::MapScripting::processActorChangeDialogue(TMC_ActorChangeDialogue &args) {
-	auto& cmd = ecs->getComponent<MapInteraction>().get(args.e).command.actorSpeak;
+	auto& cmd = ecs->getComponent<MapInteraction>().get(args.e.index).command.actorSpeak;
 	GRY_Assert(cmd.type == MAP_CMD_ACTOR_SPEAK,
 		"[Tile::MapScripting] Tried to change the dialogue of an NPC without a PlayerSpeak MapInteraction.\n"
 	);
@@ -198,9 +231,9 @@ bool Tile::MapScripting::processActorChangeDialogue(TMC_ActorChangeDialogue &arg
 bool Tile::MapScripting::processActorSpeak(TMC_ActorSpeak& args) {
 	auto& actors = ecs->getComponent<Actor>();
 	auto& players = ecs->getComponent<Player>();
-	if (actors.contains(args.e)) {
+	if (actors.contains(args.e.index)) {
 		/* If the direction was specified use it, otherwise use the direction opposite the player's */
-		actors.get(args.e).direction = args.direction != Direction::DirectionNone ? 
+		actors.get(args.e.index).direction = args.direction != Direction::DirectionNone ? 
 			args.direction :
 			invDirs[actors.get(players.getEntity(0)).direction];
 	}
@@ -216,6 +249,7 @@ bool Tile::MapScripting::processActorWaitForSpeak(TMC_ActorWaitForSpeak &args) {
 bool Tile::MapScripting::processPlayerTeleport(TMC_PlayerTeleport& args) {
 	entity player = ecs->getComponent<Player>().getEntity(0);
 	ecs->getComponent<Position2>().get(player) = args.position;
+	EntityMap::markMoved(&scene->getTileEntityMap(), player, ecs->getComponent<MapEntity>().get(player).layer);
 	return true;
 }
 
@@ -238,8 +272,8 @@ bool Tile::MapScripting::processActivateScript(TMC_ActivateScript &args, double
 	);
 	mode = CUTSCENE;
 	for (auto& cmd : currentScript.front()) {
-		if (cmd.data.e == ECS::NONE) { continue; }
-		else { ecs->getComponent<MapCommand>().get(cmd.data.e) = MapCommand { .data = { MAP_CMD_NONE } }; }
+		if (cmd.data.e == ECS::NONE_HANDLE || !ecs->isAlive(cmd.data.e)) { continue; }
+		else { ecs->getComponent<MapCommand>().get(cmd.data.e.index) = MapCommand { .data = { MAP_CMD_NONE } }; }
 	}
 	return true;
 }
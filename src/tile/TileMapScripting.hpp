@@ -75,6 +75,16 @@ namespace Tile {
 		 */
 		bool executeCommand(MapCommand& command, double delta);
 
+		/**
+		 * @brief Cancel the MapCommands of entities whose target entity has been freed.
+		 * 
+		 * @details
+		 * Entities are only freed when the ECS applies its commands, so
+		 * calling this right after that, whenever it freed something, lets
+		 * processEntities run MapCommands without checking their handles.
+		 */
+		void cancelFreed();
+
 		bool inCutscene() const { return mode == CUTSCENE; }
 	private:
 		void processEntities(double delta);
@@ -83,6 +93,8 @@ namespace Tile {
 
 		void processCutscene(double delta);
 
+		bool dispatchCommand(MapCommand& command, double delta);
+
 		bool processActorMovePos(TMC_ActorMovePos& args);
 
 		bool processActorSetDirection(TMC_ActorSetDirection& args);
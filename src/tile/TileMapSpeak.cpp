@@ -9,7 +9,7 @@
 
 void Tile::MapSpeak::endSpeak() {
 	index = 0;
-	scene->getECS().getComponent<Player>().value.at(0).speakingTo = ECS::NONE;
+	scene->getECS().getComponent<Player>().value.at(0).speakingTo = ECS::NONE_HANDLE;
 	if (currentDialogue->command.data.type != MAP_CMD_NONE) {
 		MapCommand command = currentDialogue->command;
 		scene->executeCommand(command);
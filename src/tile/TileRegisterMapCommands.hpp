@@ -8,7 +8,7 @@ static Tile::MapCommand registerTMC_None(float normalTileSize, const GRY_JSON::V
 
 static Tile::MapCommand registerTMC_ActorMovePos(float normalTileSize, const GRY_JSON::Value& args, ECS::entity e = ECS::NONE) {
 	Tile::TMC_ActorMovePos actorMovePos;
-	actorMovePos.e = e != ECS::NONE ? e : args["e"].GetUint();
+	actorMovePos.e = ECS::handle(e != ECS::NONE ? e : args["e"].GetUint());
 	actorMovePos.targetPos = Position2 {
 		args["position"].GetArray()[0].GetFloat() * normalTileSize,
 		args["position"].GetArray()[1].GetFloat() * normalTileSize
@@ -18,7 +18,7 @@ static Tile::MapCommand registerTMC_ActorMovePos(float normalTileSize, const GRY
 
 static Tile::MapCommand registerTMC_ActorSetDirection(float normalTileSize, const GRY_JSON::Value& args, ECS::entity e = ECS::NONE) {
 	Tile::TMC_ActorSetDirection actorSetDirection;
-	actorSetDirection.e = e != ECS::NONE ? e : args["e"].GetUint();
+	actorSetDirection.e = ECS::handle(e != ECS::NONE ? e : args["e"].GetUint());
 	actorSetDirection.direction = static_cast<Tile::Direction>(args["direction"].GetInt());
 	GRY_Assert(static_cast<Tile::Direction>(actorSetDirection.direction) > 0 &&
 		static_cast<Tile::Direction>(actorSetDirection.direction) < 9,
@@ -29,7 +29,7 @@ static Tile::MapCommand registerTMC_ActorSetDirection(float normalTileSize, cons
 
 static Tile::MapCommand registerTMC_ActorWait(float normalTileSize, const GRY_JSON::Value& args, ECS::entity e = ECS::NONE) {
 	Tile::TMC_ActorWait actorWait;
-	actorWait.e = e != ECS::NONE ? e : args["e"].GetUint();
+	actorWait.e = ECS::handle(e != ECS::NONE ? e : args["e"].GetUint());
 	actorWait.time = args["time"].GetFloat();
 	GRY_Assert(actorWait.time >= 0.f, "[Tile::EntityMap] WaitActor time cannot be negative.\n");
 	return Tile::MapCommand { .actorWait = actorWait };
@@ -37,14 +37,14 @@ static Tile::MapCommand registerTMC_ActorWait(float normalTileSize, const GRY_JS
 
 static Tile::MapCommand registerTMC_ActorChangeDialogue(float normalTileSize, const GRY_JSON::Value& args, ECS::entity e = ECS::NONE) {
 	Tile::TMC_ActorChangeDialogue actorChangeDialogue;
-	actorChangeDialogue.e = e != ECS::NONE ? e : args["e"].GetUint();
+	actorChangeDialogue.e = ECS::handle(e != ECS::NONE ? e : args["e"].GetUint());
 	actorChangeDialogue.dialogueId = args["dialogueId"].GetUint();
 	return Tile::MapCommand { .actorChangeDialogue = actorChangeDialogue };
 }
 
 static Tile::MapCommand registerTMC_ActorSpeak(float normalTileSize, const GRY_JSON::Value& args, ECS::entity e = ECS::NONE) {
 	Tile::TMC_ActorSpeak actorSpeak;
-	actorSpeak.e = e != ECS::NONE ? e : args["e"].GetUint();
+	actorSpeak.e = ECS::handle(e != ECS::NONE ? e : args["e"].GetUint());
 	actorSpeak.dialogueId = args["dialogueId"].GetUint();
 	if (args.HasMember("direction")) {
 		actorSpeak.direction = static_cast<Tile::Direction>(args["direction"].GetUint());
@@ -58,8 +58,8 @@ static Tile::MapCommand registerTMC_ActorSpeak(float normalTileSize, const GRY_J
 
 static Tile::MapCommand registerTMC_ActorWaitForSpeak(float normalTileSize, const GRY_JSON::Value& args, ECS::entity e = ECS::NONE) {
 	Tile::TMC_ActorWaitForSpeak actorWaitForSpeak;
-	actorWaitForSpeak.e = e != ECS::NONE ? e : args["e"].GetUint();
-	GRY_Assert(actorWaitForSpeak.e != ECS::NONE,
+	actorWaitForSpeak.e = ECS::handle(e != ECS::NONE ? e : args["e"].GetUint());
+	GRY_Assert(actorWaitForSpeak.e != ECS::NONE_HANDLE,
 		"[Tile::EntityMap] ActorWaitForSpeak did not have an entity to wait for.\n"
 	);
 	return Tile::MapCommand { .actorWaitForSpeak = actorWaitForSpeak };
@@ -67,7 +67,7 @@ static Tile::MapCommand registerTMC_ActorWaitForSpeak(float normalTileSize, cons
 
 static Tile::MapCommand registerTMC_PlayerTeleport(float normalTileSize, const GRY_JSON::Value& args, ECS::entity e = ECS::NONE) {
 	Tile::TMC_PlayerTeleport playerTeleport;
-	playerTeleport.e = e != ECS::NONE ? e : args["e"].GetUint();
+	playerTeleport.e = ECS::handle(e != ECS::NONE ? e : args["e"].GetUint());
 	playerTeleport.position = Position2 {
 		args["position"].GetArray()[0].GetFloat() * normalTileSize,
 		args["position"].GetArray()[1].GetFloat() * normalTileSize
@@ -77,7 +77,7 @@ static Tile::MapCommand registerTMC_PlayerTeleport(float normalTileSize, const G
 
 static Tile::MapCommand registerTMC_SwitchMap(float normalTileSize, const GRY_JSON::Value& args, ECS::entity e = ECS::NONE) {
 	Tile::TMC_SwitchMap switchMap;
-	switchMap.e = e != ECS::NONE ? e : args["e"].GetUint();
+	switchMap.e = ECS::handle(e != ECS::NONE ? e : args["e"].GetUint());
 	if (args.HasMember("spawnPosition")) {
 		switchMap.spawnPosition = Position2 {
 			args["spawnPosition"].GetArray()[0].GetFloat() * normalTileSize,
@@ -93,14 +93,14 @@ static Tile::MapCommand registerTMC_SwitchMap(float normalTileSize, const GRY_JS
 
 static Tile::MapCommand registerTMC_ActivateScript(float normalTileSize, const GRY_JSON::Value& args, ECS::entity e = ECS::NONE) {
 	Tile::TMC_ActivateScript activateScript;
-	activateScript.e = ECS::NONE;
+	activateScript.e = ECS::NONE_HANDLE;
 	activateScript.scriptIndex = args["scriptIndex"].GetUint();
 	return Tile::MapCommand { .activateScript = activateScript };
 }
 
 static Tile::MapCommand registerTMC_MoveCamera(float normalTileSize, const GRY_JSON::Value& args, ECS::entity e = ECS::NONE) {
 	Tile::TMC_MoveCamera moveCamera;
-	moveCamera.e = ECS::NONE;
+	moveCamera.e = ECS::NONE_HANDLE;
 	moveCamera.position = Position2 {
 		args["position"].GetArray()[0].GetFloat() * normalTileSize,
 		args["position"].GetArray()[1].GetFloat() * normalTileSize
@@ -113,7 +113,7 @@ static Tile::MapCommand registerTMC_MoveCamera(float normalTileSize, const GRY_J
 
 static Tile::MapCommand registerTMC_MoveCameraToPlayer(float normalTileSize, const GRY_JSON::Value& args, ECS::entity e = ECS::NONE) {
 	Tile::TMC_MoveCameraToPlayer moveCameraToPlayer;
-	moveCameraToPlayer.e = ECS::NONE;
+	moveCameraToPlayer.e = ECS::NONE_HANDLE;
 	if (args.HasMember("speed")) {
 		moveCameraToPlayer.speed = args["speed"].GetFloat();
 	}
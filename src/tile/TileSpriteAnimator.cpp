@@ -6,33 +6,36 @@
 #include "TileSpriteAnimator.hpp"
 #include "../scenes/TileMapScene.hpp"
 
-Tile::SpriteAnimator::SpriteAnimator(MapScene *scene) :
-	sprites(&scene->getECS().getComponent<ActorSprite>()),
-	actors(&scene->getECS().getComponentReadOnly<Actor>()),
-	actorAnimations(&scene->getECS().getComponent<ActorSpriteAnims>()) {
+Tile::SpriteAnimator::SpriteAnimator(MapScene *scene) : scene(scene) {
 }
 
+/**
+ * @details
+ * Iterates a view of the animated actors, so each entity's
+ * components are looked up once per frame.
+ */
 void Tile::SpriteAnimator::process(double delta) {
-	for (auto e : *actorAnimations) {
-		ActorSpriteAnims& animations = actorAnimations->get(e);
-		if (!actors->get(e).movingDirection) {
-			sprites->get(e).index = static_cast<uint8_t>(actors->get(e).direction);
-			animations.timer = 0;
-			animations.index = 0;
-			continue;
-		}
+	scene->getECS().view<ActorSpriteAnims, Actor, ActorSprite>().each(
+		[delta](ECS::entity, ActorSpriteAnims& animations, const Actor& actor, ActorSprite& sprite) {
+			if (!actor.movingDirection) {
+				sprite.index = static_cast<uint8_t>(actor.direction);
+				animations.timer = 0;
+				animations.index = 0;
+				return;
+			}
 
-		std::vector<TileId> animation = actors->get(e).sprinting ?
-		animations.sprint[actors->get(e).direction] :
-		animations.walk[actors->get(e).direction];
+			const std::vector<TileId>& animation = actor.sprinting ?
+			animations.sprint[actor.direction] :
+			animations.walk[actor.direction];
 
-		sprites->get(e).index = animation[animations.index];
+			sprite.index = animation[animations.index];
 
-		animations.timer -= delta;
-		if (animations.timer > 0.0) { continue; }
+			animations.timer -= delta;
+			if (animations.timer > 0.0) { return; }
 
-		if (++animations.index >= animation.size()) { animations.index = 0; }
-		animations.timer += animations.duration;
-		sprites->get(e).index = animation[animations.index];
-	}
+			if (++animations.index >= animation.size()) { animations.index = 0; }
+			animations.timer += animations.duration;
+			sprite.index = animation[animations.index];
+		}
+	);
 }
\ No newline at end of file
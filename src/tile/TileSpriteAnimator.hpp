@@ -17,22 +17,10 @@ namespace Tile {
 	class SpriteAnimator {
 	private:
 		/**
-		 * @brief Sprites of actors.
+		 * @brief Associated MapScene class.
 		 * 
 		 */
-		ComponentSet<ActorSprite>* sprites;
-
-		/**
-		 * @brief Actor data.
-		 * 
-		 */
-		const ComponentSet<Actor>* actors;
-
-		/**
-		 * @brief Animations of ActorSprites.
-		 * 
-		 */
-		ComponentSet<ActorSpriteAnims>* actorAnimations;
+		MapScene* scene;
 
 	public:
 		/**
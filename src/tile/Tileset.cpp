@@ -7,9 +7,13 @@
 #include "GRY_Game.hpp"
 #include "GRY_Tiled.hpp"
 #include "SDL3/SDL_render.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
 
 Tile::Tileset::~Tileset() {
-	SDL_DestroyTexture(texture);
+	if (ownsTexture) { SDL_DestroyTexture(texture); }
 	texture = nullptr;
 }
 
@@ -87,14 +91,51 @@ bool Tile::Tileset::load(GRY_Game* game) {
     return false;
 }
 
+/**
+ * @details
+ * Each animation waits in `animationQueue` until the clock reaches its next
+ * frame, so a call only touches the animations that change frame.
+ * 
+ * An animation that is several frames behind, after a long delta, moves
+ * through all of them and keeps the time it overshot by, so its frames do
+ * not drift. Whole cycles are skipped at once.
+ */
 void Tile::Tileset::processAnimations(double delta) {
-	for (auto& anim : tileAnimations) {
-		anim.timer -= delta;
-		if (anim.timer > 0.0) { continue; }
-		
-		if (++anim.currentFrame >= anim.frames.size()) { anim.currentFrame = 0; }
-		const Animation::Frame& newFrame = anim.frames[anim.currentFrame];
-		textureIdx[anim.tile] = newFrame.index;
-		anim.timer = newFrame.duration;
+	const auto later = std::greater<std::pair<double, std::size_t>>();
+	changedTiles.clear();
+
+	/* Schedule any new animations */
+	for (std::size_t i = animationQueue.size(); i < tileAnimations.size(); i++) {
+		animationQueue.push_back({ animationClock + tileAnimations[i].nextFrameTime, i });
+		tileAnimations[i].nextFrameTime = animationQueue.back().first;
+		std::push_heap(animationQueue.begin(), animationQueue.end(), later);
+	}
+
+	animationClock += delta;
+	while (!animationQueue.empty() && animationQueue.front().first <= animationClock) {
+		std::pop_heap(animationQueue.begin(), animationQueue.end(), later);
+		Animation& anim = tileAnimations[animationQueue.back().second];
+		TileId previousIndex = textureIdx[anim.tile];
+
+		double cycle = 0.0;
+		for (const Animation::Frame& frame : anim.frames) { cycle += frame.duration; }
+		if (cycle <= 0.0) {
+			/* Frames without a duration change every call */
+			if (++anim.currentFrame >= anim.frames.size()) { anim.currentFrame = 0; }
+			anim.nextFrameTime = std::nextafter(animationClock, std::numeric_limits<double>::infinity());
+		}
+		else {
+			double behind = animationClock - anim.nextFrameTime;
+			if (behind >= cycle) { anim.nextFrameTime += std::floor(behind / cycle) * cycle; }
+			while (anim.nextFrameTime <= animationClock) {
+				if (++anim.currentFrame >= anim.frames.size()) { anim.currentFrame = 0; }
+				anim.nextFrameTime += anim.frames[anim.currentFrame].duration;
+			}
+		}
+
+		textureIdx[anim.tile] = anim.frames[anim.currentFrame].index;
+		if (textureIdx[anim.tile] != previousIndex) { changedTiles.push_back(anim.tile); }
+		animationQueue.back().first = anim.nextFrameTime;
+		std::push_heap(animationQueue.begin(), animationQueue.end(), later);
 	}
 }
@@ -8,6 +8,7 @@
 #include "Tile.hpp"
 #include "FileResource.hpp"
 #include "SDL3/SDL_rect.h"
+#include <utility>
 
 struct SDL_Texture;
 
@@ -27,6 +28,12 @@ namespace Tile {
 		 */
 		SDL_Texture* texture = nullptr;
 
+		/**
+		 * @brief Whether `texture` is destroyed with the tileset. `false` once it is packed into a GRY_Atlas.
+		 * 
+		 */
+		bool ownsTexture = true;
+
 		/**
 		 * @brief Rectangles that define the space of each tile in the texture.
 		 * 
@@ -47,10 +54,29 @@ namespace Tile {
 		 * @brief Container of animations for tiles.
 		 * 
 		 * @details
-		 * The data is used to modify textureIdx.
+		 * The data is used to modify textureIdx. Animations can be added,
+		 * and are scheduled the next time `processAnimations` is called.
 		 */
 		std::vector<Animation> tileAnimations;
 
+		/**
+		 * @brief Time the animations have been running for, in seconds.
+		 * 
+		 */
+		double animationClock = 0.0;
+
+		/**
+		 * @brief Min-heap of the next frame time and index of each animation in `tileAnimations`.
+		 * 
+		 */
+		std::vector<std::pair<double, std::size_t>> animationQueue;
+
+		/**
+		 * @brief Tiles whose source rect changed during the last `processAnimations` call.
+		 * 
+		 */
+		std::vector<TileId> changedTiles;
+
 		/**
 		 * @brief Width of each tile, in pixels.
 		 * 
@@ -90,9 +116,13 @@ namespace Tile {
 			using std::swap;
 			swap(static_cast<FileResource&>(lhs), static_cast<FileResource&>(rhs));
 			swap(lhs.texture, rhs.texture);
+			swap(lhs.ownsTexture, rhs.ownsTexture);
 			swap(lhs.sourceRects, rhs.sourceRects);
 			swap(lhs.textureIdx, rhs.textureIdx);
 			swap(lhs.tileAnimations, rhs.tileAnimations);
+			swap(lhs.animationClock, rhs.animationClock);
+			swap(lhs.animationQueue, rhs.animationQueue);
+			swap(lhs.changedTiles, rhs.changedTiles);
 			swap(lhs.tileWidth, rhs.tileWidth);
 			swap(lhs.tileHeight, rhs.tileHeight);
 		}
@@ -101,8 +131,23 @@ namespace Tile {
 
 		bool load(GRY_Game* game) final override;
 
+		/**
+		 * @brief Advance the animation clock, and change the source rects of the tiles whose animation moved to another frame.
+		 * 
+		 * @param delta Time to advance by, in seconds.
+		 */
 		void processAnimations(double delta);
 
+		/**
+		 * @brief Get the tiles whose source rect changed during the last `processAnimations` call.
+		 * 
+		 * @details
+		 * Anything that caches how tiles look only has to update these.
+		 * 
+		 * @return `const` reference to the ids of the changed tiles.
+		 */
+		const std::vector<TileId>& getChangedTiles() const { return changedTiles; }
+
 		std::size_t size() { return sourceRects.size() - 1; }
 
 		/**